@@ -12,7 +12,7 @@ public final class AddressBook extends
     AddressBookInterface<AddressBook> {
 private static final long serialVersionUID = 0L;
   public AddressBook() {
-    people_ = new java.util.ArrayList<com.example.tutorial.Person>();
+    people_ = java.util.Collections.emptyList();
     owner_ = null;
     afterMessageInit();
   }
@@ -43,9 +43,10 @@ private static final long serialVersionUID = 0L;
     if (extensionRegistry == null) {
       throw new java.lang.NullPointerException();
     }
+    beforeMessageUpdate();
     int mutable_bitField0_ = 0;
-    com.google.protobuf.UnknownFieldSet.Builder unknownFields =
-        com.google.protobuf.UnknownFieldSet.newBuilder();
+    com.google.protobuf.UnknownFieldSet.Builder unknownFields = null;
+    com.example.custom.CustomOwnerClass previousOwner = owner_;
     try {
       clear();
       boolean done = false;
@@ -56,20 +57,28 @@ private static final long serialVersionUID = 0L;
             done = true;
             break;
           case 10: {
-            if (!((mutable_bitField0_ & 0x00000001) != 0)) {
-              people_ = new java.util.ArrayList<com.example.tutorial.Person>();
-              mutable_bitField0_ |= 0x00000001;
-            }
+            ensurePeopleIsMutable();
             people_.add(
                 input.readMessage(com.example.tutorial.Person.parser(), extensionRegistry));
             break;
           }
           case 18: {
+            if (ownerScratch_ == null) {
+              ownerScratch_ = new com.example.tutorial.Person();
+            }
+            int length = input.readRawVarint32();
+            int limit = input.pushLimit(length);
+            ownerScratch_.updateFrom(input, extensionRegistry);
+            input.checkLastTagWas(0);
+            input.popLimit(limit);
             bitField0_ |= 0x00000001;
-            owner_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.fromProto(input.readMessage(com.example.tutorial.Person.parser(), extensionRegistry));
+            owner_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.mergeInto(previousOwner, ownerScratch_);
             break;
           }
           default: {
+            if (unknownFields == null) {
+              unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();
+            }
             if (!parseUnknownField(
                 input, unknownFields, extensionRegistry, tag)) {
               done = true;
@@ -85,38 +94,59 @@ private static final long serialVersionUID = 0L;
       throw new com.google.protobuf.InvalidProtocolBufferException(
           e).setUnfinishedMessage(this);
     } finally {
-      this.unknownFields = unknownFields.build();
+      this.unknownFields = unknownFields == null
+          ? com.google.protobuf.UnknownFieldSet.getDefaultInstance()
+          : unknownFields.build();
       makeExtensionsImmutable();
     }
   }
+  private static final class DescriptorHolder {
+    static final com.google.protobuf.Descriptors.Descriptor
+      descriptor =
+        com.example.tutorial.AddressBookProtos.getDescriptor().getMessageTypes().get(1);
+    static final
+      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+        fieldAccessorTable = new
+          com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
+            descriptor,
+            new java.lang.String[] { "People", "Owner", });
+  }
+
   public static final com.google.protobuf.Descriptors.Descriptor
       getDescriptor() {
-    return com.example.tutorial.AddressBookProtos.internal_static_tutorial_AddressBook_descriptor;
+    return DescriptorHolder.descriptor;
   }
 
   @java.lang.Override
   protected com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
       internalGetFieldAccessorTable() {
-    return com.example.tutorial.AddressBookProtos.internal_static_tutorial_AddressBook_fieldAccessorTable
+    return DescriptorHolder.fieldAccessorTable
         .ensureFieldAccessorsInitialized(
             com.example.tutorial.AddressBook.class);
   }
 
   private int bitField0_;
   private java.util.List<com.example.tutorial.Person> people_;
+  private void ensurePeopleIsMutable() {
+    if (people_ == java.util.Collections.EMPTY_LIST) {
+      people_ = new java.util.ArrayList<com.example.tutorial.Person>();
+    }
+  }
   /**
    * <code>repeated .tutorial.Person people = 1 [json_name = "people"];</code>
    */
   @java.lang.Override
   public java.util.List<com.example.tutorial.Person> getPeopleList() {
-    return people_;
+    return people_ == java.util.Collections.EMPTY_LIST ? people_
+        : java.util.Collections.unmodifiableList(people_);
   }
   /**
    * <code>repeated .tutorial.Person people = 1 [json_name = "people"];</code>
    */
   public java.util.List<? extends com.example.tutorial.PersonInterface> 
       getPeopleInterfaceList() {
-    return people_;
+    return people_ == java.util.Collections.EMPTY_LIST ? people_
+        : java.util.Collections.unmodifiableList(people_);
   }
   /**
    * <code>repeated .tutorial.Person people = 1 [json_name = "people"];</code>
@@ -141,6 +171,8 @@ private static final long serialVersionUID = 0L;
   @java.lang.Override
   public AddressBook setPeople(
       int index, com.example.tutorial.Person value) {
+    beforeMessageUpdate();
+    ensurePeopleIsMutable();
     people_.set(index, value);
     onChanged(PEOPLE_FIELD_NUMBER);
     return this;
@@ -152,6 +184,8 @@ private static final long serialVersionUID = 0L;
    */
   public AddressBook addPeople(
       com.example.tutorial.Person value) {
+    beforeMessageUpdate();
+    ensurePeopleIsMutable();
     people_.add(value);
     onChanged(PEOPLE_FIELD_NUMBER);
     return this;
@@ -163,6 +197,8 @@ private static final long serialVersionUID = 0L;
    */
   public AddressBook addAllPeople(
       java.util.Collection<com.example.tutorial.Person> values) {
+    beforeMessageUpdate();
+    ensurePeopleIsMutable();
     people_.addAll(values);
     onChanged(PEOPLE_FIELD_NUMBER);
     return this;
@@ -172,14 +208,20 @@ private static final long serialVersionUID = 0L;
    * @return 'This' for chaining.
    */
   public AddressBook clearPeople() {
-    people_ = new java.util.ArrayList<com.example.tutorial.Person>(people_);
+    beforeMessageUpdate();
+    if (people_.size() > 1024) {
+      people_ = java.util.Collections.emptyList();
+    } else if (!people_.isEmpty()) {
+      people_.clear();
+    }
     onChanged(PEOPLE_FIELD_NUMBER);
     return this;
   }
 
   private com.example.custom.CustomOwnerClass owner_;
+  private transient com.example.tutorial.Person ownerScratch_;
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @return Whether the owner field is set.
    */
   @java.lang.Override
@@ -187,7 +229,7 @@ private static final long serialVersionUID = 0L;
     return ((bitField0_ & 0x00000001) != 0);
   }
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @return The owner.
    */
   @java.lang.Override
@@ -195,10 +237,11 @@ private static final long serialVersionUID = 0L;
     return owner_;
   }
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @param value The owner to set.
    */
   public AddressBook setOwner(com.example.custom.CustomOwnerClass value) {
+    beforeMessageUpdate();
     bitField0_ |= 0x00000001;
     if(owner_ != value) {
       owner_ = value;
@@ -207,10 +250,11 @@ private static final long serialVersionUID = 0L;
     return this;
   }
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @return 'This' for chaining.
    */
   public AddressBook clearOwner() {
+    beforeMessageUpdate();
     owner_ = null;
     onChanged(OWNER_FIELD_NUMBER);
     return this;
@@ -269,8 +313,8 @@ private static final long serialVersionUID = 0L;
     }
     com.example.tutorial.AddressBook other = (com.example.tutorial.AddressBook) obj;
 
-    if (!java.util.Objects.equals(getPeopleList(),
-        other.getPeopleList())) return false;
+    if (!java.util.Objects.equals(people_,
+        other.people_)) return false;
     if (!java.util.Objects.equals(getOwner(),
         other.getOwner())) return false;
     if (!unknownFields.equals(other.unknownFields)) return false;
@@ -283,10 +327,10 @@ private static final long serialVersionUID = 0L;
       return memoizedHashCode;
     }
     int hash = 41;
-    hash = (19 * hash) + getDescriptor().hashCode();
+    hash = (19 * hash) + "tutorial.AddressBook".hashCode();
     if (getPeopleCount() > 0) {
       hash = (37 * hash) + PEOPLE_FIELD_NUMBER;
-      hash = (53 * hash) + java.util.Objects.hashCode(getPeopleList());
+      hash = (53 * hash) + java.util.Objects.hashCode(people_);
     }
     hash = (37 * hash) + OWNER_FIELD_NUMBER;
     hash = (53 * hash) + java.util.Objects.hashCode(getOwner());
@@ -295,11 +339,176 @@ private static final long serialVersionUID = 0L;
     return hash;
   }
 
+  public static final long PEOPLE_DIFF_BIT = 1L << 0;
+  public static final long OWNER_DIFF_BIT = 1L << 1;
+
+  /**
+   * Returns a mask with the {@code *_DIFF_BIT} of every field that is not
+   * equal in {@code other}.
+   */
+  public long diffMask(com.example.tutorial.AddressBook other) {
+    long mask = 0L;
+    if (!java.util.Objects.equals(people_, other.people_)) {
+      mask |= PEOPLE_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(owner_, other.owner_)) {
+      mask |= OWNER_DIFF_BIT;
+    }
+    return mask;
+  }
+
+  /**
+   * Returns the paths of all fields that are not equal in {@code other}.
+   * Nested messages are compared recursively, e.g. "phones[0].number".
+   */
+  public java.util.List<java.lang.String> diffPaths(com.example.tutorial.AddressBook other) {
+    java.util.List<java.lang.String> paths = new java.util.ArrayList<>();
+    diffPaths(other, "", paths);
+    return paths;
+  }
+
+  public void diffPaths(com.example.tutorial.AddressBook other, java.lang.String prefix,
+      java.util.List<java.lang.String> paths) {
+    long mask = diffMask(other);
+    if (mask == 0L) {
+      return;
+    }
+    if ((mask & PEOPLE_DIFF_BIT) != 0L) {
+      if (people_.size() == other.people_.size()) {
+        for (int i = 0; i < people_.size(); i++) {
+          people_.get(i).diffPaths(other.people_.get(i),
+              prefix + "people[" + i + "].", paths);
+        }
+      } else {
+        paths.add(prefix + "people");
+      }
+    }
+    if ((mask & OWNER_DIFF_BIT) != 0L) {
+      paths.add(prefix + "owner");
+    }
+  }
+
   @java.lang.Override
   public void clear() {
-    people_ = java.util.Collections.emptyList();
+    beforeMessageUpdate();
+    if (people_.size() > 1024) {
+      people_ = java.util.Collections.emptyList();
+    } else if (!people_.isEmpty()) {
+      people_.clear();
+    }
     owner_ = null;
-    bitField0_ = (bitField0_ & ~0x00000002);
+    bitField0_ = (bitField0_ & ~0x00000001);
+  }
+
+  /**
+   * Copies all fields of {@code other} into this message without a
+   * serialization round-trip. Nested messages and repeated fields are
+   * deep-copied, immutable values are shared.
+   */
+  public com.example.tutorial.AddressBook copyFrom(com.example.tutorial.AddressBook other) {
+    if (other == this) {
+      return this;
+    }
+    beforeMessageUpdate();
+    bitField0_ = other.bitField0_;
+    if (people_.size() > 1024) {
+      people_ = java.util.Collections.emptyList();
+    } else if (!people_.isEmpty()) {
+      people_.clear();
+    }
+    if (!other.people_.isEmpty()) {
+      if (people_ == java.util.Collections.EMPTY_LIST) {
+        people_ = new java.util.ArrayList<com.example.tutorial.Person>(other.people_.size());
+      }
+      for (int i = 0; i < other.people_.size(); i++) {
+        people_.add(other.people_.get(i).deepCopy());
+      }
+    }
+    owner_ = other.owner_ == null ? null : de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.copy(other.owner_);
+    this.unknownFields = other.unknownFields;
+    onChanged(0);
+    afterMessageUpdate();
+    return this;
+  }
+
+  public com.example.tutorial.AddressBook deepCopy() {
+    return new com.example.tutorial.AddressBook().copyFrom(this);
+  }
+
+  /**
+   * Returns an immutable snapshot of this message. Nested messages that
+   * did not change since the last freeze() are shared with the previous
+   * snapshot. Changes that bypass the setters, e.g. through lists returned
+   * by getters or inside javatype values, are not tracked.
+   */
+  public com.example.tutorial.AddressBook freeze() {
+    if (isFrozen()) {
+      return this;
+    }
+    com.example.tutorial.AddressBook previous = (com.example.tutorial.AddressBook) frozenSnapshot;
+    java.util.List<com.example.tutorial.Person> frozenPeople =
+        de.leohilbert.proto.Snapshots.freezeList(people_,
+            previous == null ? null : previous.people_,
+            com.example.tutorial.Person::freeze);
+    if (previous != null
+        && frozenPeople == previous.people_) {
+      return previous;
+    }
+    com.example.tutorial.AddressBook snapshot = new com.example.tutorial.AddressBook();
+    snapshot.freezeFrom(this);
+    snapshot.people_ = frozenPeople;
+    snapshot.markFrozen();
+    frozenSnapshot = snapshot;
+    return snapshot;
+  }
+
+  private void freezeFrom(com.example.tutorial.AddressBook other) {
+    bitField0_ = other.bitField0_;
+    owner_ = other.owner_ == null ? null : de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.copy(other.owner_);
+    this.unknownFields = other.unknownFields;
+  }
+
+  @java.lang.Override
+  public java.lang.Object getFieldByNumber(int number) {
+    switch (number) {
+      case 1: return getPeopleList();
+      case 2: return getOwner();
+      default: return super.getFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  @SuppressWarnings("unchecked")
+  public void setFieldByNumber(int number, java.lang.Object value) {
+    switch (number) {
+      case 1:
+        value = de.leohilbert.proto.FieldValues.checkList(value, com.example.tutorial.Person.class,
+            "tutorial.AddressBook.people");
+        break;
+      case 2:
+        de.leohilbert.proto.FieldValues.check(value, com.example.custom.CustomOwnerClass.class, true,
+            "tutorial.AddressBook.owner");
+        break;
+      default:
+        super.setFieldByNumber(number, value);
+        return;
+    }
+    beforeMessageUpdate();
+    switch (number) {
+      case 1:
+        if (people_.size() > 1024) {
+          people_ = java.util.Collections.emptyList();
+        } else if (!people_.isEmpty()) {
+          people_.clear();
+        }
+        ensurePeopleIsMutable();
+        people_.addAll((java.util.Collection<com.example.tutorial.Person>) value);
+        onChanged(PEOPLE_FIELD_NUMBER);
+        break;
+      case 2:
+        setOwner((com.example.custom.CustomOwnerClass) value);
+        break;
+    }
   }
 
   @java.lang.Override
@@ -310,6 +519,88 @@ private static final long serialVersionUID = 0L;
     return sb.append('}').toString();
   }
 
+  /**
+   * Writes this message as proto3 JSON without reflection. Fields are
+   * written by the same presence rules as the binary format.
+   */
+  public void writeJson(java.lang.Appendable out) throws java.io.IOException {
+    out.append('{');
+    boolean first = true;
+    if (!people_.isEmpty()) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "people");
+      out.append('[');
+      for (int i = 0; i < people_.size(); i++) {
+        if (i > 0) {
+          out.append(',');
+        }
+        people_.get(i).writeJson(out);
+      }
+      out.append(']');
+    }
+    if (((bitField0_ & 0x00000001) != 0)) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "owner");
+      de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.toProto(owner_).writeJson(out);
+    }
+    out.append('}');
+  }
+
+  public java.lang.String toJson() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder();
+    try {
+      writeJson(sb);
+    } catch (java.io.IOException e) {
+      throw new java.lang.RuntimeException(
+          "Writing to a StringBuilder threw an IOException (should never happen).", e);
+    }
+    return sb.toString();
+  }
+
+  /**
+   * Reads proto3 JSON into this message. Like updateFrom, all fields not
+   * contained in the JSON are reset to their defaults.
+   */
+  public void updateFromJson(java.io.Reader reader) throws java.io.IOException {
+    updateFromJson(new de.leohilbert.proto.JsonReader(reader));
+  }
+
+  public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {
+    beforeMessageUpdate();
+    clear();
+    in.beginObject();
+    while (in.hasNextMember()) {
+      switch (in.nextName()) {
+        case "people":
+          if (!in.nextNull()) {
+            in.beginArray();
+            if (people_.size() > 1024) {
+              people_ = java.util.Collections.emptyList();
+            } else if (!people_.isEmpty()) {
+              people_.clear();
+            }
+            while (in.hasNextElement()) {
+              com.example.tutorial.Person message = new com.example.tutorial.Person();
+              message.updateFromJson(in);
+              ensurePeopleIsMutable();
+              people_.add(message);
+            }
+          }
+          break;
+        case "owner":
+          if (!in.nextNull()) {
+            com.example.tutorial.Person message = new com.example.tutorial.Person();
+            message.updateFromJson(in);
+            bitField0_ |= 0x00000001;
+            owner_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS.fromProto(message);
+          }
+          break;
+        default:
+          in.skipValue();
+      }
+    }
+    onChanged(0);
+    afterMessageUpdate();
+  }
+
   public static com.example.tutorial.AddressBook parseFrom(
       java.nio.ByteBuffer data)
       throws com.google.protobuf.InvalidProtocolBufferException {
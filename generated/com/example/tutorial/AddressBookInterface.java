@@ -40,17 +40,17 @@ public interface AddressBookInterface<SELF> extends
   public static final int OWNER_FIELD_NUMBER = 2;
 
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @return Whether the owner field is set.
    */
   boolean hasOwner();
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @return The owner.
    */
   com.example.custom.CustomOwnerClass getOwner();
   /**
-   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass"];</code>
+   * <code>.tutorial.Person owner = 2 [json_name = "owner", (.leo.proto.javatype) = "com.example.custom.CustomOwnerClass", (.leo.proto.inplace_converter) = true, (.leo.proto.copy_converter) = true];</code>
    * @param value The owner to set.
    */
   SELF setOwner(com.example.custom.CustomOwnerClass value);
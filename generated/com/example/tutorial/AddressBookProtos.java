@@ -14,21 +14,6 @@ public final class AddressBookProtos {
     registerAllExtensions(
         (com.google.protobuf.ExtensionRegistryLite) registry);
   }
-  static final com.google.protobuf.Descriptors.Descriptor
-    internal_static_tutorial_Person_descriptor;
-  static final 
-    com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
-      internal_static_tutorial_Person_fieldAccessorTable;
-  static final com.google.protobuf.Descriptors.Descriptor
-    internal_static_tutorial_Person_PhoneNumber_descriptor;
-  static final 
-    com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
-      internal_static_tutorial_Person_PhoneNumber_fieldAccessorTable;
-  static final com.google.protobuf.Descriptors.Descriptor
-    internal_static_tutorial_AddressBook_descriptor;
-  static final 
-    com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
-      internal_static_tutorial_AddressBook_fieldAccessorTable;
 
   public static com.google.protobuf.Descriptors.FileDescriptor
       getDescriptor() {
@@ -38,62 +23,72 @@ public final class AddressBookProtos {
       descriptor;
   static {
     java.lang.String[] descriptorData = {
-      "\n\021addressbook.proto\022\010tutorial\032\037google/pr" +
-      "otobuf/timestamp.proto\032\021leo_options.prot" +
-      "o\"\203\004\n\006Person\022\"\n\002id\030\001 \001(\tB\022\222\202\031\016java.util." +
-      "UUIDR\002id\022\022\n\004name\030\002 \001(\tR\004name\022\020\n\003age\030\003 \001(" +
-      "\005R\003age\022\024\n\005email\030\004 \001(\tR\005email\0224\n\006phones\030\005" +
-      " \003(\0132\034.tutorial.Person.PhoneNumberR\006phon" +
-      "es\022\034\n\tfriendIds\030\006 \003(\tR\tfriendIds\0222\n\nfrie" +
-      "ndIds2\030\007 \003(\tB\022\222\202\031\016java.util.UUIDR\nfriend" +
-      "Ids2\022&\n\016favoriteNumber\030\010 \003(\005R\016favoriteNu" +
-      "mber\022=\n\014last_updated\030\t \001(\0132\032.google.prot" +
-      "obuf.TimestampR\013lastUpdated\032v\n\013PhoneNumb" +
-      "er\022\026\n\006number\030\001 \001(\tR\006number\022O\n\004type\030\002 \001(\016" +
-      "2\023.tutorial.PhoneTypeB&\222\202\031\"com.example.c" +
-      "ustom.CustomPhoneTypeR\004type:2\262\202\031.com.exa" +
-      "mple.custom.CustomPersonMarkerInterface\"" +
-      "\216\001\n\013AddressBook\022(\n\006people\030\001 \003(\0132\020.tutori" +
-      "al.PersonR\006people\022O\n\005owner\030\002 \001(\0132\020.tutor" +
-      "ial.PersonB\'\222\202\031#com.example.custom.Custo" +
-      "mOwnerClassR\005owner:\004\240\202\031\000*+\n\tPhoneType\022\n\n" +
-      "\006MOBILE\020\000\022\010\n\004HOME\020\001\022\010\n\004WORK\020\002B/\n\024com.exa" +
-      "mple.tutorialB\021AddressBookProtosP\001\230\202\031\001b\006" +
+      "\n\021addressbook.proto\022\010tutorial\032\036google/pr" +
+      "otobuf/duration.proto\032\037google/protobuf/t" +
+      "imestamp.proto\032\036google/protobuf/wrappers" +
+      ".proto\032\021leo_options.proto\"\244\004\n\006Person\022\"\n\002" +
+      "id\030\001 \001(\tB\022\222\202\031\016java.util.UUIDR\002id\022\022\n\004name" +
+      "\030\002 \001(\tR\004name\022\020\n\003age\030\003 \001(\005R\003age\022\024\n\005email\030" +
+      "\004 \001(\tR\005email\0224\n\006phones\030\005 \003(\0132\034.tutorial." +
+      "Person.PhoneNumberR\006phones\022\"\n\tfriendIds\030" +
+      "\006 \003(\tB\004\210\203\031\001R\tfriendIds\0226\n\nfriendIds2\030\007 \003" +
+      "(\tB\026\222\202\031\016java.util.UUID\210\204\031\001R\nfriendIds2\022&" +
+      "\n\016favoriteNumber\030\010 \003(\005R\016favoriteNumber\022=" +
+      "\n\014last_updated\030\t \001(\0132\032.google.protobuf.T" +
+      "imestampR\013lastUpdated\032\204\001\n\013PhoneNumber\022\026\n" +
+      "\006number\030\001 \001(\tR\006number\022S\n\004type\030\002 \001(\0162\023.tu" +
+      "torial.PhoneTypeB*\222\202\031\"com.example.custom" +
+      ".CustomPhoneType\220\203\031\001R\004type:\010\320\202\031\001\360\202\031\001::\262\202" +
+      "\031.com.example.custom.CustomPersonMarkerI" +
+      "nterface\310\203\031\001\350\203\031\001\"\226\001\n\013AddressBook\022(\n\006peop" +
+      "le\030\001 \003(\0132\020.tutorial.PersonR\006people\022W\n\005ow" +
+      "ner\030\002 \001(\0132\020.tutorial.PersonB/\222\202\031#com.exa" +
+      "mple.custom.CustomOwnerClass\230\203\031\001\200\204\031\001R\005ow" +
+      "ner:\004\240\202\031\000\"\345\001\n\007Session\0224\n\007started\030\001 \001(\0132\032" +
+      ".google.protobuf.TimestampR\007started\0221\n\006l" +
+      "ength\030\002 \001(\0132\031.google.protobuf.DurationR\006" +
+      "length\0225\n\007retries\030\003 \001(\0132\033.google.protobu" +
+      "f.Int32ValueR\007retries\0224\n\006device\030\004 \001(\0132\034." +
+      "google.protobuf.StringValueR\006device:\004\250\203\031" +
+      "\001\"\260\001\n\007Setting\022\020\n\003key\030\001 \001(\tR\003key\022\037\n\nlong_" +
+      "value\030\002 \001(\003H\000R\tlongValue\022#\n\014double_value" +
+      "\030\003 \001(\001H\000R\013doubleValue\022\037\n\nbool_value\030\004 \001(" +
+      "\010H\000R\tboolValue\022#\n\014string_value\030\005 \001(\tH\000R\013" +
+      "stringValueB\007\n\005value*+\n\tPhoneType\022\n\n\006MOB" +
+      "ILE\020\000\022\010\n\004HOME\020\001\022\010\n\004WORK\020\002B3\n\024com.example" +
+      ".tutorialB\021AddressBookProtosP\001\230\202\031\001\330\202\031\001b\006" +
       "proto3"
     };
     descriptor = com.google.protobuf.Descriptors.FileDescriptor
       .internalBuildGeneratedFileFrom(descriptorData,
         new com.google.protobuf.Descriptors.FileDescriptor[] {
+          com.google.protobuf.DurationProto.getDescriptor(),
           com.google.protobuf.TimestampProto.getDescriptor(),
+          com.google.protobuf.WrappersProto.getDescriptor(),
           leo.proto.LeoOptions.getDescriptor(),
         });
-    internal_static_tutorial_Person_descriptor =
-      getDescriptor().getMessageTypes().get(0);
-    internal_static_tutorial_Person_fieldAccessorTable = new
-      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
-        internal_static_tutorial_Person_descriptor,
-        new java.lang.String[] { "Id", "Name", "Age", "Email", "Phones", "FriendIds", "FriendIds2", "FavoriteNumber", "LastUpdated", });
-    internal_static_tutorial_Person_PhoneNumber_descriptor =
-      internal_static_tutorial_Person_descriptor.getNestedTypes().get(0);
-    internal_static_tutorial_Person_PhoneNumber_fieldAccessorTable = new
-      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
-        internal_static_tutorial_Person_PhoneNumber_descriptor,
-        new java.lang.String[] { "Number", "Type", });
-    internal_static_tutorial_AddressBook_descriptor =
-      getDescriptor().getMessageTypes().get(1);
-    internal_static_tutorial_AddressBook_fieldAccessorTable = new
-      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
-        internal_static_tutorial_AddressBook_descriptor,
-        new java.lang.String[] { "People", "Owner", });
     com.google.protobuf.ExtensionRegistry registry =
         com.google.protobuf.ExtensionRegistry.newInstance();
+    registry.add(leo.proto.LeoOptions.builtinCodec);
+    registry.add(leo.proto.LeoOptions.copyConverter);
+    registry.add(leo.proto.LeoOptions.inplaceConverter);
+    registry.add(leo.proto.LeoOptions.intern);
     registry.add(leo.proto.LeoOptions.javatype);
+    registry.add(leo.proto.LeoOptions.lazyDescriptors);
+    registry.add(leo.proto.LeoOptions.msgDiscardUnknownFields);
     registry.add(leo.proto.LeoOptions.msgImplementsInterface);
+    registry.add(leo.proto.LeoOptions.msgOffHeap);
+    registry.add(leo.proto.LeoOptions.msgSeqlock);
+    registry.add(leo.proto.LeoOptions.msgTable);
+    registry.add(leo.proto.LeoOptions.msgUnboxWellKnownTypes);
     registry.add(leo.proto.LeoOptions.msgUseCustomSuperclass);
+    registry.add(leo.proto.LeoOptions.streamConverter);
     registry.add(leo.proto.LeoOptions.useCustomSuperclass);
     com.google.protobuf.Descriptors.FileDescriptor
         .internalUpdateFileDescriptor(descriptor, registry);
+    com.google.protobuf.DurationProto.getDescriptor();
     com.google.protobuf.TimestampProto.getDescriptor();
+    com.google.protobuf.WrappersProto.getDescriptor();
     leo.proto.LeoOptions.getDescriptor();
   }
 
@@ -15,10 +15,10 @@ private static final long serialVersionUID = 0L;
     id_ = null;
     name_ = null;
     email_ = null;
-    phones_ = new java.util.ArrayList<com.example.tutorial.Person.PhoneNumber>();
-    friendIds_ = new com.google.protobuf.LazyStringArrayList();
-    friendIds2_ = new java.util.ArrayList<java.util.UUID>();
-    favoriteNumber_ = newIntList();
+    phones_ = java.util.Collections.emptyList();
+    friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+    friendIds2_ = java.util.Collections.emptyList();
+    favoriteNumber_ = emptyIntList();
     afterMessageInit();
   }
 
@@ -48,9 +48,8 @@ private static final long serialVersionUID = 0L;
     if (extensionRegistry == null) {
       throw new java.lang.NullPointerException();
     }
-    int mutable_bitField0_ = 0;
-    com.google.protobuf.UnknownFieldSet.Builder unknownFields =
-        com.google.protobuf.UnknownFieldSet.newBuilder();
+    beforeMessageUpdate();
+    com.google.protobuf.UnknownFieldSet.Builder unknownFields = null;
     try {
       clear();
       boolean done = false;
@@ -83,45 +82,32 @@ private static final long serialVersionUID = 0L;
             break;
           }
           case 42: {
-            if (!((mutable_bitField0_ & 0x00000001) != 0)) {
-              phones_ = new java.util.ArrayList<com.example.tutorial.Person.PhoneNumber>();
-              mutable_bitField0_ |= 0x00000001;
-            }
+            ensurePhonesIsMutable();
             phones_.add(
                 input.readMessage(com.example.tutorial.Person.PhoneNumber.parser(), extensionRegistry));
             break;
           }
           case 50: {
-            java.lang.String s = input.readStringRequireUtf8();
-            if (!((mutable_bitField0_ & 0x00000002) != 0)) {
-              friendIds_ = new com.google.protobuf.LazyStringArrayList();
-              mutable_bitField0_ |= 0x00000002;
-            }
+            java.lang.String s = friendIdsInterner_.readStringRequireUtf8(input);
+            ensureFriendIdsIsMutable();
             friendIds_.add(s);
             break;
           }
           case 58: {
-            if (!((mutable_bitField0_ & 0x00000004) != 0)) {
-              friendIds2_ = new java.util.ArrayList<java.util.UUID>();
-              mutable_bitField0_ |= 0x00000004;
-            }
-            friendIds2_.add(de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.fromProto(input.readString()));
+            ensureFriendIds2IsMutable();
+            friendIds2_.add(de.leohilbert.proto.UuidCodec.read(input));
             break;
           }
           case 64: {
-            if (!((mutable_bitField0_ & 0x00000008) != 0)) {
-              favoriteNumber_ = newIntList();
-              mutable_bitField0_ |= 0x00000008;
-            }
+            ensureFavoriteNumberIsMutable();
             favoriteNumber_.addInt((input.readInt32()));
             break;
           }
           case 66: {
             int length = input.readRawVarint32();
             int limit = input.pushLimit(length);
-            if (!((mutable_bitField0_ & 0x00000008) != 0) && input.getBytesUntilLimit() > 0) {
-              favoriteNumber_ = newIntList();
-              mutable_bitField0_ |= 0x00000008;
+            if (input.getBytesUntilLimit() > 0) {
+              ensureFavoriteNumberIsMutable();
             }
             while (input.getBytesUntilLimit() > 0) {
               favoriteNumber_.addInt((input.readInt32()));
@@ -134,6 +120,9 @@ private static final long serialVersionUID = 0L;
             break;
           }
           default: {
+            if (unknownFields == null) {
+              unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();
+            }
             if (!parseUnknownField(
                 input, unknownFields, extensionRegistry, tag)) {
               done = true;
@@ -149,19 +138,33 @@ private static final long serialVersionUID = 0L;
       throw new com.google.protobuf.InvalidProtocolBufferException(
           e).setUnfinishedMessage(this);
     } finally {
-      this.unknownFields = unknownFields.build();
+      this.unknownFields = unknownFields == null
+          ? com.google.protobuf.UnknownFieldSet.getDefaultInstance()
+          : unknownFields.build();
       makeExtensionsImmutable();
     }
   }
+  private static final class DescriptorHolder {
+    static final com.google.protobuf.Descriptors.Descriptor
+      descriptor =
+        com.example.tutorial.AddressBookProtos.getDescriptor().getMessageTypes().get(0);
+    static final
+      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+        fieldAccessorTable = new
+          com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
+            descriptor,
+            new java.lang.String[] { "Id", "Name", "Age", "Email", "Phones", "FriendIds", "FriendIds2", "FavoriteNumber", "LastUpdated", });
+  }
+
   public static final com.google.protobuf.Descriptors.Descriptor
       getDescriptor() {
-    return com.example.tutorial.AddressBookProtos.internal_static_tutorial_Person_descriptor;
+    return DescriptorHolder.descriptor;
   }
 
   @java.lang.Override
   protected com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
       internalGetFieldAccessorTable() {
-    return com.example.tutorial.AddressBookProtos.internal_static_tutorial_Person_fieldAccessorTable
+    return DescriptorHolder.fieldAccessorTable
         .ensureFieldAccessorsInitialized(
             com.example.tutorial.Person.class);
   }
@@ -184,12 +187,12 @@ private static final long serialVersionUID = 0L;
     public static final int TYPE_FIELD_NUMBER = 2;
 
     /**
-     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType"];</code>
+     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType", (.leo.proto.stream_converter) = true];</code>
      * @return The type.
      */
     com.example.custom.CustomPhoneType getType();
     /**
-     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType"];</code>
+     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType", (.leo.proto.stream_converter) = true];</code>
      * @param value The type to set.
      */
     SELF setType(com.example.custom.CustomPhoneType value);
@@ -233,8 +236,8 @@ private static final long serialVersionUID = 0L;
       if (extensionRegistry == null) {
         throw new java.lang.NullPointerException();
       }
-      com.google.protobuf.UnknownFieldSet.Builder unknownFields =
-          com.google.protobuf.UnknownFieldSet.newBuilder();
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
       try {
         clear();
         boolean done = false;
@@ -252,12 +255,11 @@ private static final long serialVersionUID = 0L;
             }
             case 16: {
 
-              type_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.fromProto(input.readEnum());
+              type_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.read(input);
               break;
             }
             default: {
-              if (!parseUnknownField(
-                  input, unknownFields, extensionRegistry, tag)) {
+              if (!input.skipField(tag)) {
                 done = true;
               }
               break;
@@ -271,19 +273,34 @@ private static final long serialVersionUID = 0L;
         throw new com.google.protobuf.InvalidProtocolBufferException(
             e).setUnfinishedMessage(this);
       } finally {
-        this.unknownFields = unknownFields.build();
+        this.unknownFields = com.google.protobuf.UnknownFieldSet.getDefaultInstance();
         makeExtensionsImmutable();
+        if (writing) {
+          endWrite();
+        }
       }
     }
+    private static final class DescriptorHolder {
+      static final com.google.protobuf.Descriptors.Descriptor
+        descriptor =
+          com.example.tutorial.Person.DescriptorHolder.descriptor.getNestedTypes().get(0);
+      static final
+        com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+          fieldAccessorTable = new
+            com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
+              descriptor,
+              new java.lang.String[] { "Number", "Type", });
+    }
+
     public static final com.google.protobuf.Descriptors.Descriptor
         getDescriptor() {
-      return com.example.tutorial.AddressBookProtos.internal_static_tutorial_Person_PhoneNumber_descriptor;
+      return DescriptorHolder.descriptor;
     }
 
     @java.lang.Override
     protected com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
         internalGetFieldAccessorTable() {
-      return com.example.tutorial.AddressBookProtos.internal_static_tutorial_Person_PhoneNumber_fieldAccessorTable
+      return DescriptorHolder.fieldAccessorTable
           .ensureFieldAccessorsInitialized(
               com.example.tutorial.Person.PhoneNumber.class);
     }
@@ -303,17 +320,25 @@ private static final long serialVersionUID = 0L;
      */
     public PhoneNumber setNumber(
         java.lang.String value) {
-      
-      if (!java.util.Objects.equals(value, number_)) {
-        number_ = value;
-        onChanged(NUMBER_FIELD_NUMBER);
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        
+        if (!java.util.Objects.equals(value, number_)) {
+          number_ = value;
+          onChanged(NUMBER_FIELD_NUMBER);
+        }
+      } finally {
+        if (writing) {
+          endWrite();
+        }
       }
       return this;
     }
 
     private com.example.custom.CustomPhoneType type_;
     /**
-     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType"];</code>
+     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType", (.leo.proto.stream_converter) = true];</code>
      * @return The type.
      */
     @java.lang.Override
@@ -321,24 +346,40 @@ private static final long serialVersionUID = 0L;
       return type_;
     }
     /**
-     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType"];</code>
+     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType", (.leo.proto.stream_converter) = true];</code>
      * @param value The type to set.
      */
     public PhoneNumber setType(com.example.custom.CustomPhoneType value) {
-      
-      if(type_ != value) {
-        type_ = value;
-        onChanged(TYPE_FIELD_NUMBER);
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        
+        if(type_ != value) {
+          type_ = value;
+          onChanged(TYPE_FIELD_NUMBER);
+        }
+      } finally {
+        if (writing) {
+          endWrite();
+        }
       }
       return this;
     }
     /**
-     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType"];</code>
+     * <code>.tutorial.PhoneType type = 2 [json_name = "type", (.leo.proto.javatype) = "com.example.custom.CustomPhoneType", (.leo.proto.stream_converter) = true];</code>
      * @return 'This' for chaining.
      */
     public PhoneNumber clearType() {
-      type_ = null;
-      onChanged(TYPE_FIELD_NUMBER);
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        type_ = null;
+        onChanged(TYPE_FIELD_NUMBER);
+      } finally {
+        if (writing) {
+          endWrite();
+        }
+      }
       return this;
     }
 
@@ -360,7 +401,7 @@ private static final long serialVersionUID = 0L;
         com.google.protobuf.GeneratedMessageV3.writeString(output, 1, number_);
       }
       if (type_ != null) {
-        output.writeEnum(2, de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.toProto(type_));
+        de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.write(output, 2, type_);
       }
       unknownFields.writeTo(output);
     }
@@ -376,8 +417,7 @@ private static final long serialVersionUID = 0L;
         size += com.google.protobuf.GeneratedMessageV3.computeStringSize(1, number_);
       }
       if (type_ != null) {
-        size += com.google.protobuf.CodedOutputStream
-          .computeEnumSize(2, de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.toProto(type_));
+        size += 1 + de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.size(type_);
       }
       size += unknownFields.getSerializedSize();
       memoizedSize = size;
@@ -408,7 +448,7 @@ private static final long serialVersionUID = 0L;
         return memoizedHashCode;
       }
       int hash = 41;
-      hash = (19 * hash) + getDescriptor().hashCode();
+      hash = (19 * hash) + "tutorial.Person.PhoneNumber".hashCode();
       hash = (37 * hash) + NUMBER_FIELD_NUMBER;
       hash = (53 * hash) + java.util.Objects.hashCode(getNumber());
       hash = (37 * hash) + TYPE_FIELD_NUMBER;
@@ -418,12 +458,219 @@ private static final long serialVersionUID = 0L;
       return hash;
     }
 
+    public static final long NUMBER_DIFF_BIT = 1L << 0;
+    public static final long TYPE_DIFF_BIT = 1L << 1;
+
+    /**
+     * Returns a mask with the {@code *_DIFF_BIT} of every field that is not
+     * equal in {@code other}.
+     */
+    public long diffMask(com.example.tutorial.Person.PhoneNumber other) {
+      long mask = 0L;
+      if (!java.util.Objects.equals(number_, other.number_)) {
+        mask |= NUMBER_DIFF_BIT;
+      }
+      if (!java.util.Objects.equals(type_, other.type_)) {
+        mask |= TYPE_DIFF_BIT;
+      }
+      return mask;
+    }
+
+    /**
+     * Returns the paths of all fields that are not equal in {@code other}.
+     * Nested messages are compared recursively, e.g. "phones[0].number".
+     */
+    public java.util.List<java.lang.String> diffPaths(com.example.tutorial.Person.PhoneNumber other) {
+      java.util.List<java.lang.String> paths = new java.util.ArrayList<>();
+      diffPaths(other, "", paths);
+      return paths;
+    }
+
+    public void diffPaths(com.example.tutorial.Person.PhoneNumber other, java.lang.String prefix,
+        java.util.List<java.lang.String> paths) {
+      long mask = diffMask(other);
+      if (mask == 0L) {
+        return;
+      }
+      if ((mask & NUMBER_DIFF_BIT) != 0L) {
+        paths.add(prefix + "number");
+      }
+      if ((mask & TYPE_DIFF_BIT) != 0L) {
+        paths.add(prefix + "type");
+      }
+    }
+
     @java.lang.Override
     public void clear() {
-      number_ = null;
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        number_ = null;
 
-      type_ = null;
+        type_ = null;
 
+      } finally {
+        if (writing) {
+          endWrite();
+        }
+      }
+    }
+
+    /**
+     * Copies all fields of {@code other} into this message without a
+     * serialization round-trip. Nested messages and repeated fields are
+     * deep-copied, immutable values are shared.
+     */
+    public com.example.tutorial.Person.PhoneNumber copyFrom(com.example.tutorial.Person.PhoneNumber other) {
+      if (other == this) {
+        return this;
+      }
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        number_ = other.number_;
+        type_ = other.type_;
+        this.unknownFields = other.unknownFields;
+        onChanged(0);
+      } finally {
+        if (writing) {
+          endWrite();
+        }
+      }
+      afterMessageUpdate();
+      return this;
+    }
+
+    public com.example.tutorial.Person.PhoneNumber deepCopy() {
+      return new com.example.tutorial.Person.PhoneNumber().copyFrom(this);
+    }
+
+    /**
+     * Returns an immutable snapshot of this message. Nested messages that
+     * did not change since the last freeze() are shared with the previous
+     * snapshot. Changes that bypass the setters, e.g. through lists returned
+     * by getters or inside javatype values, are not tracked.
+     */
+    public com.example.tutorial.Person.PhoneNumber freeze() {
+      if (isFrozen()) {
+        return this;
+      }
+      com.example.tutorial.Person.PhoneNumber previous = (com.example.tutorial.Person.PhoneNumber) frozenSnapshot;
+      if (previous != null) {
+        return previous;
+      }
+      com.example.tutorial.Person.PhoneNumber snapshot = new com.example.tutorial.Person.PhoneNumber();
+      snapshot.freezeFrom(this);
+      snapshot.markFrozen();
+      frozenSnapshot = snapshot;
+      return snapshot;
+    }
+
+    private void freezeFrom(com.example.tutorial.Person.PhoneNumber other) {
+      number_ = other.number_;
+      type_ = other.type_;
+      this.unknownFields = other.unknownFields;
+    }
+
+    private long seqlock;
+    private static final java.lang.invoke.VarHandle SEQLOCK =
+        de.leohilbert.proto.FieldHandles.find(
+            java.lang.invoke.MethodHandles.lookup(), "seqlock", long.class);
+
+    private boolean beginWrite() {
+      long seq = seqlock;
+      if ((seq & 1L) != 0L) {
+        return false;
+      }
+      SEQLOCK.setOpaque(this, seq + 1L);
+      java.lang.invoke.VarHandle.storeStoreFence();
+      return true;
+    }
+
+    private com.example.tutorial.Person.PhoneNumber endWrite() {
+      long seq = seqlock;
+      if ((seq & 1L) != 0L) {
+        SEQLOCK.setRelease(this, seq + 1L);
+      }
+      return this;
+    }
+
+    /**
+     * Runs {@code reader} until it saw this message without a concurrent
+     * write. The reader may run several times, so it should only read.
+     */
+    public void readConsistent(
+        java.util.function.Consumer<? super com.example.tutorial.Person.PhoneNumber> reader) {
+      while (!tryRead(reader)) {
+        java.lang.Thread.onSpinWait();
+      }
+    }
+
+    /**
+     * Runs {@code reader} once. Returns false if this message was written
+     * meanwhile, in which case everything it read has to be discarded.
+     */
+    public boolean tryRead(
+        java.util.function.Consumer<? super com.example.tutorial.Person.PhoneNumber> reader) {
+      long seq = (long) SEQLOCK.getAcquire(this);
+      if ((seq & 1L) != 0L) {
+        return false;
+      }
+      try {
+        reader.accept(this);
+      } catch (java.lang.RuntimeException e) {
+        // torn reads may throw, e.g. while a list is resized
+        java.lang.invoke.VarHandle.loadLoadFence();
+        if ((long) SEQLOCK.getOpaque(this) != seq) {
+          return false;
+        }
+        throw e;
+      }
+      java.lang.invoke.VarHandle.loadLoadFence();
+      return (long) SEQLOCK.getOpaque(this) == seq;
+    }
+
+    @java.lang.Override
+    public java.lang.Object getFieldByNumber(int number) {
+      switch (number) {
+        case 1: return getNumber();
+        case 2: return getType();
+        default: return super.getFieldByNumber(number);
+      }
+    }
+
+    @java.lang.Override
+    @SuppressWarnings("unchecked")
+    public void setFieldByNumber(int number, java.lang.Object value) {
+      switch (number) {
+        case 1:
+          de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+              "tutorial.Person.PhoneNumber.number");
+          break;
+        case 2:
+          de.leohilbert.proto.FieldValues.check(value, com.example.custom.CustomPhoneType.class, true,
+              "tutorial.Person.PhoneNumber.type");
+          break;
+        default:
+          super.setFieldByNumber(number, value);
+          return;
+      }
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        switch (number) {
+          case 1:
+            setNumber((java.lang.String) value);
+            break;
+          case 2:
+            setType((com.example.custom.CustomPhoneType) value);
+            break;
+        }
+      } finally {
+        if (writing) {
+          endWrite();
+        }
+      }
     }
 
     @java.lang.Override
@@ -434,6 +681,76 @@ private static final long serialVersionUID = 0L;
       return sb.append('}').toString();
     }
 
+    /**
+     * Writes this message as proto3 JSON without reflection. Fields are
+     * written by the same presence rules as the binary format.
+     */
+    public void writeJson(java.lang.Appendable out) throws java.io.IOException {
+      out.append('{');
+      boolean first = true;
+      if (number_ != null) {
+        first = de.leohilbert.proto.JsonWriter.name(out, first, "number");
+        de.leohilbert.proto.JsonWriter.writeString(out, number_);
+      }
+      if (type_ != null) {
+        first = de.leohilbert.proto.JsonWriter.name(out, first, "type");
+        de.leohilbert.proto.JsonWriter.writeEnum(out, de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.toProto(type_), com.example.tutorial.PhoneType::forNumber);
+      }
+      out.append('}');
+    }
+
+    public java.lang.String toJson() {
+      java.lang.StringBuilder sb = new java.lang.StringBuilder();
+      try {
+        writeJson(sb);
+      } catch (java.io.IOException e) {
+        throw new java.lang.RuntimeException(
+            "Writing to a StringBuilder threw an IOException (should never happen).", e);
+      }
+      return sb.toString();
+    }
+
+    /**
+     * Reads proto3 JSON into this message. Like updateFrom, all fields not
+     * contained in the JSON are reset to their defaults.
+     */
+    public void updateFromJson(java.io.Reader reader) throws java.io.IOException {
+      updateFromJson(new de.leohilbert.proto.JsonReader(reader));
+    }
+
+    public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {
+      beforeMessageUpdate();
+      boolean writing = beginWrite();
+      try {
+        clear();
+        in.beginObject();
+        while (in.hasNextMember()) {
+          switch (in.nextName()) {
+            case "number":
+              if (!in.nextNull()) {
+
+                number_ = in.readString();
+              }
+              break;
+            case "type":
+              if (!in.nextNull()) {
+
+                type_ = de.leohilbert.protoconverter.ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE.fromProto(in.readEnum(com.example.tutorial.PhoneType::forName));
+              }
+              break;
+            default:
+              in.skipValue();
+          }
+        }
+        onChanged(0);
+        afterMessageUpdate();
+      } finally {
+        if (writing) {
+          endWrite();
+        }
+      }
+    }
+
     public static com.example.tutorial.Person.PhoneNumber parseFrom(
         java.nio.ByteBuffer data)
         throws com.google.protobuf.InvalidProtocolBufferException {
@@ -556,6 +873,7 @@ private static final long serialVersionUID = 0L;
    * @param value The id to set.
    */
   public Person setId(java.util.UUID value) {
+    beforeMessageUpdate();
     
     if(id_ != value) {
       id_ = value;
@@ -568,6 +886,7 @@ private static final long serialVersionUID = 0L;
    * @return 'This' for chaining.
    */
   public Person clearId() {
+    beforeMessageUpdate();
     id_ = null;
     onChanged(ID_FIELD_NUMBER);
     return this;
@@ -588,6 +907,7 @@ private static final long serialVersionUID = 0L;
    */
   public Person setName(
       java.lang.String value) {
+    beforeMessageUpdate();
     
     if (!java.util.Objects.equals(value, name_)) {
       name_ = value;
@@ -610,6 +930,7 @@ private static final long serialVersionUID = 0L;
    * @param value The age to set.
    */
   public Person setAge(int value) {
+    beforeMessageUpdate();
     
     if(age_ != value) {
       age_ = value;
@@ -622,6 +943,7 @@ private static final long serialVersionUID = 0L;
    * @return 'This' for chaining.
    */
   public Person clearAge() {
+    beforeMessageUpdate();
     age_ = 0;
     onChanged(AGE_FIELD_NUMBER);
     return this;
@@ -642,6 +964,7 @@ private static final long serialVersionUID = 0L;
    */
   public Person setEmail(
       java.lang.String value) {
+    beforeMessageUpdate();
     
     if (!java.util.Objects.equals(value, email_)) {
       email_ = value;
@@ -651,19 +974,26 @@ private static final long serialVersionUID = 0L;
   }
 
   private java.util.List<com.example.tutorial.Person.PhoneNumber> phones_;
+  private void ensurePhonesIsMutable() {
+    if (phones_ == java.util.Collections.EMPTY_LIST) {
+      phones_ = new java.util.ArrayList<com.example.tutorial.Person.PhoneNumber>();
+    }
+  }
   /**
    * <code>repeated .tutorial.Person.PhoneNumber phones = 5 [json_name = "phones"];</code>
    */
   @java.lang.Override
   public java.util.List<com.example.tutorial.Person.PhoneNumber> getPhonesList() {
-    return phones_;
+    return phones_ == java.util.Collections.EMPTY_LIST ? phones_
+        : java.util.Collections.unmodifiableList(phones_);
   }
   /**
    * <code>repeated .tutorial.Person.PhoneNumber phones = 5 [json_name = "phones"];</code>
    */
   public java.util.List<? extends com.example.tutorial.Person.PhoneNumberInterface> 
       getPhonesInterfaceList() {
-    return phones_;
+    return phones_ == java.util.Collections.EMPTY_LIST ? phones_
+        : java.util.Collections.unmodifiableList(phones_);
   }
   /**
    * <code>repeated .tutorial.Person.PhoneNumber phones = 5 [json_name = "phones"];</code>
@@ -688,6 +1018,8 @@ private static final long serialVersionUID = 0L;
   @java.lang.Override
   public Person setPhones(
       int index, com.example.tutorial.Person.PhoneNumber value) {
+    beforeMessageUpdate();
+    ensurePhonesIsMutable();
     phones_.set(index, value);
     onChanged(PHONES_FIELD_NUMBER);
     return this;
@@ -699,6 +1031,8 @@ private static final long serialVersionUID = 0L;
    */
   public Person addPhones(
       com.example.tutorial.Person.PhoneNumber value) {
+    beforeMessageUpdate();
+    ensurePhonesIsMutable();
     phones_.add(value);
     onChanged(PHONES_FIELD_NUMBER);
     return this;
@@ -710,6 +1044,8 @@ private static final long serialVersionUID = 0L;
    */
   public Person addAllPhones(
       java.util.Collection<com.example.tutorial.Person.PhoneNumber> values) {
+    beforeMessageUpdate();
+    ensurePhonesIsMutable();
     phones_.addAll(values);
     onChanged(PHONES_FIELD_NUMBER);
     return this;
@@ -719,29 +1055,41 @@ private static final long serialVersionUID = 0L;
    * @return 'This' for chaining.
    */
   public Person clearPhones() {
-    phones_ = new java.util.ArrayList<com.example.tutorial.Person.PhoneNumber>(phones_);
+    beforeMessageUpdate();
+    if (phones_.size() > 1024) {
+      phones_ = java.util.Collections.emptyList();
+    } else if (!phones_.isEmpty()) {
+      phones_.clear();
+    }
     onChanged(PHONES_FIELD_NUMBER);
     return this;
   }
 
   private com.google.protobuf.LazyStringList friendIds_;
+  private static final de.leohilbert.proto.StringInterner friendIdsInterner_ =
+      new de.leohilbert.proto.StringInterner();
+  private void ensureFriendIdsIsMutable() {
+    if (friendIds_ == com.google.protobuf.LazyStringArrayList.EMPTY) {
+      friendIds_ = new com.google.protobuf.LazyStringArrayList();
+    }
+  }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @return A list containing the friendIds.
    */
   public com.google.protobuf.ProtocolStringList
       getFriendIdsList() {
-    return friendIds_;
+    return friendIds_.getUnmodifiableView();
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @return The count of friendIds.
    */
   public int getFriendIdsCount() {
     return friendIds_.size();
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @param index The index of the element to return.
    * @return The friendIds at the given index.
    */
@@ -749,68 +1097,85 @@ private static final long serialVersionUID = 0L;
     return friendIds_.get(index);
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @param index The index to set the value at.
    * @param value The friendIds to set.
    * @return 'This' for chaining.
    */
   public Person setFriendIds(
       int index, java.lang.String value) {
+    beforeMessageUpdate();
+    ensureFriendIdsIsMutable();
     friendIds_.set(index, value);
     onChanged(FRIENDIDS_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @param value The friendIds to add.
    * @return 'This' for chaining.
    */
   public Person addFriendIds(
       java.lang.String value) {
+    beforeMessageUpdate();
+    ensureFriendIdsIsMutable();
     friendIds_.add(value);
     onChanged(FRIENDIDS_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @param values The friendIds to add.
    * @return 'This' for chaining.
    */
   public Person addAllFriendIds(
       java.util.Collection<java.lang.String> values) {
+    beforeMessageUpdate();
+    ensureFriendIdsIsMutable();
     friendIds_.addAll(values);
     onChanged(FRIENDIDS_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @return 'This' for chaining.
    */
   public Person clearFriendIds() {
-    friendIds_ = new com.google.protobuf.LazyStringArrayList();
+    beforeMessageUpdate();
+    if (friendIds_.size() > 1024) {
+      friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+    } else if (!friendIds_.isEmpty()) {
+      friendIds_.clear();
+    }
     onChanged(FRIENDIDS_FIELD_NUMBER);
     return this;
   }
 
   private java.util.List<java.util.UUID> friendIds2_;
+  private void ensureFriendIds2IsMutable() {
+    if (friendIds2_ == java.util.Collections.EMPTY_LIST) {
+      friendIds2_ = new java.util.ArrayList<java.util.UUID>();
+    }
+  }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @return A list containing the friendIds2.
    */
   @java.lang.Override
   public java.util.List<java.util.UUID>
       getFriendIds2List() {
-    return friendIds2_;
+    return friendIds2_ == java.util.Collections.EMPTY_LIST ? friendIds2_
+        : java.util.Collections.unmodifiableList(friendIds2_);
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @return The count of friendIds2.
    */
   public int getFriendIds2Count() {
     return friendIds2_.size();
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @param index The index of the element to return.
    * @return The friendIds2 at the given index.
    */
@@ -818,50 +1183,66 @@ private static final long serialVersionUID = 0L;
     return friendIds2_.get(index);
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @param index The index to set the value at.
    * @param value The friendIds2 to set.
    * @return 'This' for chaining.
    */
   public Person setFriendIds2(
       int index, java.util.UUID value) {
+    beforeMessageUpdate();
+    ensureFriendIds2IsMutable();
     friendIds2_.set(index, value);
     onChanged(FRIENDIDS2_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @param value The friendIds2 to add.
    * @return 'This' for chaining.
    */
   public Person addFriendIds2(
       java.util.UUID value) {
+    beforeMessageUpdate();
+    ensureFriendIds2IsMutable();
     friendIds2_.add(value);
     onChanged(FRIENDIDS2_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @param values The friendIds2 to add.
    * @return 'This' for chaining.
    */
   public Person addAllFriendIds2(
       java.util.Collection<java.util.UUID> values) {
+    beforeMessageUpdate();
+    ensureFriendIds2IsMutable();
     friendIds2_.addAll(values);
     onChanged(FRIENDIDS2_FIELD_NUMBER);
     return this;
   }
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @return 'This' for chaining.
    */
   public Person clearFriendIds2() {
-    friendIds2_ = new java.util.ArrayList<java.util.UUID>();
+    beforeMessageUpdate();
+    if (friendIds2_.size() > 1024) {
+      friendIds2_ = java.util.Collections.emptyList();
+    } else if (!friendIds2_.isEmpty()) {
+      friendIds2_.clear();
+    }
     onChanged(FRIENDIDS2_FIELD_NUMBER);
     return this;
   }
 
   private com.google.protobuf.Internal.IntList favoriteNumber_;
+  private void ensureFavoriteNumberIsMutable() {
+    if (favoriteNumber_ == emptyIntList()) {
+      favoriteNumber_ = newIntList();
+    }
+  }
   /**
    * <code>repeated int32 favoriteNumber = 8 [json_name = "favoriteNumber"];</code>
    * @return A list containing the favoriteNumber.
@@ -869,7 +1250,8 @@ private static final long serialVersionUID = 0L;
   @java.lang.Override
   public java.util.List<java.lang.Integer>
       getFavoriteNumberList() {
-    return favoriteNumber_;
+    return favoriteNumber_ == emptyIntList() ? favoriteNumber_
+        : java.util.Collections.unmodifiableList(favoriteNumber_);
   }
   /**
    * <code>repeated int32 favoriteNumber = 8 [json_name = "favoriteNumber"];</code>
@@ -895,9 +1277,11 @@ private static final long serialVersionUID = 0L;
    */
   public Person setFavoriteNumber(
       int index, int value) {
+    beforeMessageUpdate();
+    ensureFavoriteNumberIsMutable();
     favoriteNumber_.set(index, value);
     favoriteNumberMemoizedSerializedSize = -1;
-  onChanged(FAVORITENUMBER_FIELD_NUMBER);
+    onChanged(FAVORITENUMBER_FIELD_NUMBER);
     return this;
   }
   /**
@@ -907,9 +1291,11 @@ private static final long serialVersionUID = 0L;
    */
   public Person addFavoriteNumber(
       int value) {
+    beforeMessageUpdate();
+    ensureFavoriteNumberIsMutable();
     favoriteNumber_.add(value);
     favoriteNumberMemoizedSerializedSize = -1;
-  onChanged(FAVORITENUMBER_FIELD_NUMBER);
+    onChanged(FAVORITENUMBER_FIELD_NUMBER);
     return this;
   }
   /**
@@ -919,9 +1305,11 @@ private static final long serialVersionUID = 0L;
    */
   public Person addAllFavoriteNumber(
       java.util.Collection<java.lang.Integer> values) {
+    beforeMessageUpdate();
+    ensureFavoriteNumberIsMutable();
     favoriteNumber_.addAll(values);
     favoriteNumberMemoizedSerializedSize = -1;
-  onChanged(FAVORITENUMBER_FIELD_NUMBER);
+    onChanged(FAVORITENUMBER_FIELD_NUMBER);
     return this;
   }
   /**
@@ -929,9 +1317,14 @@ private static final long serialVersionUID = 0L;
    * @return 'This' for chaining.
    */
   public Person clearFavoriteNumber() {
-    favoriteNumber_ = newIntList();
+    beforeMessageUpdate();
+    if (favoriteNumber_.size() > 1024) {
+      favoriteNumber_ = emptyIntList();
+    } else if (!favoriteNumber_.isEmpty()) {
+      favoriteNumber_.clear();
+    }
     favoriteNumberMemoizedSerializedSize = -1;
-  onChanged(FAVORITENUMBER_FIELD_NUMBER);
+    onChanged(FAVORITENUMBER_FIELD_NUMBER);
     return this;
   }
 
@@ -957,6 +1350,7 @@ private static final long serialVersionUID = 0L;
    * @param value The lastUpdated to set.
    */
   public Person setLastUpdated(com.google.protobuf.Timestamp value) {
+    beforeMessageUpdate();
     if (!java.util.Objects.equals(value, lastUpdated_)) {
       lastUpdated_ = value;
       onChanged(LAST_UPDATED_FIELD_NUMBER);
@@ -967,6 +1361,7 @@ private static final long serialVersionUID = 0L;
    * <code>.google.protobuf.Timestamp last_updated = 9 [json_name = "lastUpdated"];</code>
    */
   public Person clearLastUpdated() {
+    beforeMessageUpdate();
     lastUpdated_ = null;
     onChanged(LAST_UPDATED_FIELD_NUMBER);
     return this;
@@ -1006,9 +1401,9 @@ private static final long serialVersionUID = 0L;
       com.google.protobuf.GeneratedMessageV3.writeString(output, 6, friendIds_.getRaw(i));
     }
     for (int i = 0; i < friendIds2_.size(); i++) {
-      output.writeString(7, de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.toProto(friendIds2_.get(i)));
+      de.leohilbert.proto.UuidCodec.write(output, 7, friendIds2_.get(i));
     }
-    if (getFavoriteNumberList().size() > 0) {
+    if (favoriteNumber_.size() > 0) {
       output.writeUInt32NoTag(66);
       output.writeUInt32NoTag(favoriteNumberMemoizedSerializedSize);
     }
@@ -1052,16 +1447,15 @@ private static final long serialVersionUID = 0L;
         dataSize += computeStringSizeNoTag(friendIds_.getRaw(i));
       }
       size += dataSize;
-      size += 1 * getFriendIdsList().size();
+      size += 1 * friendIds_.size();
     }
     {
       int dataSize = 0;
       for (int i = 0; i < friendIds2_.size(); i++) {
-        dataSize += com.google.protobuf.CodedOutputStream
-          .computeStringSizeNoTag(de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.toProto(friendIds2_.get(i)));
+        dataSize += de.leohilbert.proto.UuidCodec.size(friendIds2_.get(i));
       }
       size += dataSize;
-      size += 1 * getFriendIds2List().size();
+      size += 1 * friendIds2_.size();
     }
     {
       int dataSize = 0;
@@ -1070,7 +1464,7 @@ private static final long serialVersionUID = 0L;
           .computeInt32SizeNoTag((favoriteNumber_.getInt(i)));
       }
       size += dataSize;
-      if (!getFavoriteNumberList().isEmpty()) {
+      if (!favoriteNumber_.isEmpty()) {
         size += 1;
         size += com.google.protobuf.CodedOutputStream
             .computeInt32SizeNoTag(dataSize);
@@ -1104,14 +1498,14 @@ private static final long serialVersionUID = 0L;
         != other.getAge()) return false;
     if (!java.util.Objects.equals(getEmail(),
         other.getEmail())) return false;
-    if (!java.util.Objects.equals(getPhonesList(),
-        other.getPhonesList())) return false;
-    if (!java.util.Objects.equals(getFriendIdsList(),
-        other.getFriendIdsList())) return false;
-    if (!java.util.Objects.equals(getFriendIds2List(),
-        other.getFriendIds2List())) return false;
-    if (!java.util.Objects.equals(getFavoriteNumberList(),
-        other.getFavoriteNumberList())) return false;
+    if (!java.util.Objects.equals(phones_,
+        other.phones_)) return false;
+    if (!java.util.Objects.equals(friendIds_,
+        other.friendIds_)) return false;
+    if (!java.util.Objects.equals(friendIds2_,
+        other.friendIds2_)) return false;
+    if (!java.util.Objects.equals(favoriteNumber_,
+        other.favoriteNumber_)) return false;
     if (hasLastUpdated() != other.hasLastUpdated()) return false;
     if (hasLastUpdated()) {
       if (!java.util.Objects.equals(getLastUpdated(),
@@ -1127,7 +1521,7 @@ private static final long serialVersionUID = 0L;
       return memoizedHashCode;
     }
     int hash = 41;
-    hash = (19 * hash) + getDescriptor().hashCode();
+    hash = (19 * hash) + "tutorial.Person".hashCode();
     hash = (37 * hash) + ID_FIELD_NUMBER;
     hash = (53 * hash) + java.util.Objects.hashCode(getId());
     hash = (37 * hash) + NAME_FIELD_NUMBER;
@@ -1138,19 +1532,19 @@ private static final long serialVersionUID = 0L;
     hash = (53 * hash) + java.util.Objects.hashCode(getEmail());
     if (getPhonesCount() > 0) {
       hash = (37 * hash) + PHONES_FIELD_NUMBER;
-      hash = (53 * hash) + java.util.Objects.hashCode(getPhonesList());
+      hash = (53 * hash) + java.util.Objects.hashCode(phones_);
     }
     if (getFriendIdsCount() > 0) {
       hash = (37 * hash) + FRIENDIDS_FIELD_NUMBER;
-      hash = (53 * hash) + java.util.Objects.hashCode(getFriendIdsList());
+      hash = (53 * hash) + java.util.Objects.hashCode(friendIds_);
     }
     if (getFriendIds2Count() > 0) {
       hash = (37 * hash) + FRIENDIDS2_FIELD_NUMBER;
-      hash = (53 * hash) + java.util.Objects.hashCode(getFriendIds2List());
+      hash = (53 * hash) + java.util.Objects.hashCode(friendIds2_);
     }
     if (getFavoriteNumberCount() > 0) {
       hash = (37 * hash) + FAVORITENUMBER_FIELD_NUMBER;
-      hash = (53 * hash) + java.util.Objects.hashCode(getFavoriteNumberList());
+      hash = (53 * hash) + java.util.Objects.hashCode(favoriteNumber_);
     }
     if (hasLastUpdated()) {
       hash = (37 * hash) + LAST_UPDATED_FIELD_NUMBER;
@@ -1161,8 +1555,115 @@ private static final long serialVersionUID = 0L;
     return hash;
   }
 
+  public static final long ID_DIFF_BIT = 1L << 0;
+  public static final long NAME_DIFF_BIT = 1L << 1;
+  public static final long AGE_DIFF_BIT = 1L << 2;
+  public static final long EMAIL_DIFF_BIT = 1L << 3;
+  public static final long PHONES_DIFF_BIT = 1L << 4;
+  public static final long FRIENDIDS_DIFF_BIT = 1L << 5;
+  public static final long FRIENDIDS2_DIFF_BIT = 1L << 6;
+  public static final long FAVORITENUMBER_DIFF_BIT = 1L << 7;
+  public static final long LAST_UPDATED_DIFF_BIT = 1L << 8;
+
+  /**
+   * Returns a mask with the {@code *_DIFF_BIT} of every field that is not
+   * equal in {@code other}.
+   */
+  public long diffMask(com.example.tutorial.Person other) {
+    long mask = 0L;
+    if (!java.util.Objects.equals(id_, other.id_)) {
+      mask |= ID_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(name_, other.name_)) {
+      mask |= NAME_DIFF_BIT;
+    }
+    if (age_ != other.age_) {
+      mask |= AGE_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(email_, other.email_)) {
+      mask |= EMAIL_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(phones_, other.phones_)) {
+      mask |= PHONES_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(friendIds_, other.friendIds_)) {
+      mask |= FRIENDIDS_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(friendIds2_, other.friendIds2_)) {
+      mask |= FRIENDIDS2_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(favoriteNumber_, other.favoriteNumber_)) {
+      mask |= FAVORITENUMBER_DIFF_BIT;
+    }
+    if (hasLastUpdated() != other.hasLastUpdated()) {
+      mask |= LAST_UPDATED_DIFF_BIT;
+    } else if (hasLastUpdated()) {
+      if (!java.util.Objects.equals(lastUpdated_, other.lastUpdated_)) {
+        mask |= LAST_UPDATED_DIFF_BIT;
+      }
+    }
+    return mask;
+  }
+
+  /**
+   * Returns the paths of all fields that are not equal in {@code other}.
+   * Nested messages are compared recursively, e.g. "phones[0].number".
+   */
+  public java.util.List<java.lang.String> diffPaths(com.example.tutorial.Person other) {
+    java.util.List<java.lang.String> paths = new java.util.ArrayList<>();
+    diffPaths(other, "", paths);
+    return paths;
+  }
+
+  public void diffPaths(com.example.tutorial.Person other, java.lang.String prefix,
+      java.util.List<java.lang.String> paths) {
+    long mask = diffMask(other);
+    if (mask == 0L) {
+      return;
+    }
+    if ((mask & ID_DIFF_BIT) != 0L) {
+      paths.add(prefix + "id");
+    }
+    if ((mask & NAME_DIFF_BIT) != 0L) {
+      paths.add(prefix + "name");
+    }
+    if ((mask & AGE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "age");
+    }
+    if ((mask & EMAIL_DIFF_BIT) != 0L) {
+      paths.add(prefix + "email");
+    }
+    if ((mask & PHONES_DIFF_BIT) != 0L) {
+      if (phones_.size() == other.phones_.size()) {
+        for (int i = 0; i < phones_.size(); i++) {
+          phones_.get(i).diffPaths(other.phones_.get(i),
+              prefix + "phones[" + i + "].", paths);
+        }
+      } else {
+        paths.add(prefix + "phones");
+      }
+    }
+    if ((mask & FRIENDIDS_DIFF_BIT) != 0L) {
+      paths.add(prefix + "friendIds");
+    }
+    if ((mask & FRIENDIDS2_DIFF_BIT) != 0L) {
+      paths.add(prefix + "friendIds2");
+    }
+    if ((mask & FAVORITENUMBER_DIFF_BIT) != 0L) {
+      paths.add(prefix + "favoriteNumber");
+    }
+    if ((mask & LAST_UPDATED_DIFF_BIT) != 0L) {
+      if (lastUpdated_ != null && other.lastUpdated_ != null) {
+        lastUpdated_.diffPaths(other.lastUpdated_, prefix + "last_updated.", paths);
+      } else {
+        paths.add(prefix + "last_updated");
+      }
+    }
+  }
+
   @java.lang.Override
   public void clear() {
+    beforeMessageUpdate();
     id_ = null;
 
     name_ = null;
@@ -1171,13 +1672,302 @@ private static final long serialVersionUID = 0L;
 
     email_ = null;
 
-    phones_ = java.util.Collections.emptyList();
-    friendIds_ = new com.google.protobuf.LazyStringArrayList();
-    friendIds2_ = new java.util.ArrayList<java.util.UUID>();
-    favoriteNumber_ = newIntList();
+    if (phones_.size() > 1024) {
+      phones_ = java.util.Collections.emptyList();
+    } else if (!phones_.isEmpty()) {
+      phones_.clear();
+    }
+    if (friendIds_.size() > 1024) {
+      friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+    } else if (!friendIds_.isEmpty()) {
+      friendIds_.clear();
+    }
+    if (friendIds2_.size() > 1024) {
+      friendIds2_ = java.util.Collections.emptyList();
+    } else if (!friendIds2_.isEmpty()) {
+      friendIds2_.clear();
+    }
+    if (favoriteNumber_.size() > 1024) {
+      favoriteNumber_ = emptyIntList();
+    } else if (!favoriteNumber_.isEmpty()) {
+      favoriteNumber_.clear();
+    }
     lastUpdated_ = null;
   }
 
+  /**
+   * Copies all fields of {@code other} into this message without a
+   * serialization round-trip. Nested messages and repeated fields are
+   * deep-copied, immutable values are shared.
+   */
+  public com.example.tutorial.Person copyFrom(com.example.tutorial.Person other) {
+    if (other == this) {
+      return this;
+    }
+    beforeMessageUpdate();
+    id_ = other.id_;
+    name_ = other.name_;
+    age_ = other.age_;
+    email_ = other.email_;
+    if (phones_.size() > 1024) {
+      phones_ = java.util.Collections.emptyList();
+    } else if (!phones_.isEmpty()) {
+      phones_.clear();
+    }
+    if (!other.phones_.isEmpty()) {
+      if (phones_ == java.util.Collections.EMPTY_LIST) {
+        phones_ = new java.util.ArrayList<com.example.tutorial.Person.PhoneNumber>(other.phones_.size());
+      }
+      for (int i = 0; i < other.phones_.size(); i++) {
+        phones_.add(other.phones_.get(i).deepCopy());
+      }
+    }
+    if (friendIds_.size() > 1024) {
+      friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+    } else if (!friendIds_.isEmpty()) {
+      friendIds_.clear();
+    }
+    if (!other.friendIds_.isEmpty()) {
+      ensureFriendIdsIsMutable();
+      friendIds_.addAll(other.friendIds_);
+    }
+    if (friendIds2_.size() > 1024) {
+      friendIds2_ = java.util.Collections.emptyList();
+    } else if (!friendIds2_.isEmpty()) {
+      friendIds2_.clear();
+    }
+    if (!other.friendIds2_.isEmpty()) {
+      ensureFriendIds2IsMutable();
+      friendIds2_.addAll(other.friendIds2_);
+    }
+    if (favoriteNumber_.size() > 1024) {
+      favoriteNumber_ = emptyIntList();
+    } else if (!favoriteNumber_.isEmpty()) {
+      favoriteNumber_.clear();
+    }
+    if (!other.favoriteNumber_.isEmpty()) {
+      ensureFavoriteNumberIsMutable();
+      favoriteNumber_.addAll(other.favoriteNumber_);
+    }
+    lastUpdated_ = other.lastUpdated_ == null ? null : other.lastUpdated_.deepCopy();
+    this.unknownFields = other.unknownFields;
+    onChanged(0);
+    afterMessageUpdate();
+    return this;
+  }
+
+  public com.example.tutorial.Person deepCopy() {
+    return new com.example.tutorial.Person().copyFrom(this);
+  }
+
+  /**
+   * Returns an immutable snapshot of this message. Nested messages that
+   * did not change since the last freeze() are shared with the previous
+   * snapshot. Changes that bypass the setters, e.g. through lists returned
+   * by getters or inside javatype values, are not tracked.
+   */
+  public com.example.tutorial.Person freeze() {
+    if (isFrozen()) {
+      return this;
+    }
+    com.example.tutorial.Person previous = (com.example.tutorial.Person) frozenSnapshot;
+    java.util.List<com.example.tutorial.Person.PhoneNumber> frozenPhones =
+        de.leohilbert.proto.Snapshots.freezeList(phones_,
+            previous == null ? null : previous.phones_,
+            com.example.tutorial.Person.PhoneNumber::freeze);
+    com.google.protobuf.Timestamp frozenLastUpdated =
+        lastUpdated_ == null ? null : lastUpdated_.freeze();
+    if (previous != null
+        && frozenPhones == previous.phones_
+        && frozenLastUpdated == previous.lastUpdated_) {
+      return previous;
+    }
+    com.example.tutorial.Person snapshot = new com.example.tutorial.Person();
+    snapshot.freezeFrom(this);
+    snapshot.phones_ = frozenPhones;
+    snapshot.lastUpdated_ = frozenLastUpdated;
+    snapshot.markFrozen();
+    frozenSnapshot = snapshot;
+    return snapshot;
+  }
+
+  private void freezeFrom(com.example.tutorial.Person other) {
+    id_ = other.id_;
+    name_ = other.name_;
+    age_ = other.age_;
+    email_ = other.email_;
+    if (friendIds_.size() > 1024) {
+      friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+    } else if (!friendIds_.isEmpty()) {
+      friendIds_.clear();
+    }
+    if (!other.friendIds_.isEmpty()) {
+      ensureFriendIdsIsMutable();
+      friendIds_.addAll(other.friendIds_);
+    }
+    friendIds_ = friendIds_.getUnmodifiableView();
+    if (friendIds2_.size() > 1024) {
+      friendIds2_ = java.util.Collections.emptyList();
+    } else if (!friendIds2_.isEmpty()) {
+      friendIds2_.clear();
+    }
+    if (!other.friendIds2_.isEmpty()) {
+      ensureFriendIds2IsMutable();
+      friendIds2_.addAll(other.friendIds2_);
+    }
+    friendIds2_ = java.util.Collections.unmodifiableList(friendIds2_);
+    if (favoriteNumber_.size() > 1024) {
+      favoriteNumber_ = emptyIntList();
+    } else if (!favoriteNumber_.isEmpty()) {
+      favoriteNumber_.clear();
+    }
+    if (!other.favoriteNumber_.isEmpty()) {
+      ensureFavoriteNumberIsMutable();
+      favoriteNumber_.addAll(other.favoriteNumber_);
+    }
+    favoriteNumber_.makeImmutable();
+    this.unknownFields = other.unknownFields;
+  }
+
+  @java.lang.Override
+  public java.lang.Object getFieldByNumber(int number) {
+    switch (number) {
+      case 1: return getId();
+      case 2: return getName();
+      case 3: return getAge();
+      case 4: return getEmail();
+      case 5: return getPhonesList();
+      case 6: return getFriendIdsList();
+      case 7: return getFriendIds2List();
+      case 8: return getFavoriteNumberList();
+      case 9: return getLastUpdated();
+      default: return super.getFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  @SuppressWarnings("unchecked")
+  public void setFieldByNumber(int number, java.lang.Object value) {
+    switch (number) {
+      case 1:
+        de.leohilbert.proto.FieldValues.check(value, java.util.UUID.class, true,
+            "tutorial.Person.id");
+        break;
+      case 2:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+            "tutorial.Person.name");
+        break;
+      case 3:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.Integer.class, false,
+            "tutorial.Person.age");
+        break;
+      case 4:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+            "tutorial.Person.email");
+        break;
+      case 5:
+        value = de.leohilbert.proto.FieldValues.checkList(value, com.example.tutorial.Person.PhoneNumber.class,
+            "tutorial.Person.phones");
+        break;
+      case 6:
+        value = de.leohilbert.proto.FieldValues.checkList(value, java.lang.String.class,
+            "tutorial.Person.friendIds");
+        break;
+      case 7:
+        value = de.leohilbert.proto.FieldValues.checkList(value, java.util.UUID.class,
+            "tutorial.Person.friendIds2");
+        break;
+      case 8:
+        value = de.leohilbert.proto.FieldValues.checkList(value, java.lang.Integer.class,
+            "tutorial.Person.favoriteNumber");
+        break;
+      case 9:
+        de.leohilbert.proto.FieldValues.check(value, com.google.protobuf.Timestamp.class, true,
+            "tutorial.Person.last_updated");
+        break;
+      default:
+        super.setFieldByNumber(number, value);
+        return;
+    }
+    beforeMessageUpdate();
+    switch (number) {
+      case 1:
+        setId((java.util.UUID) value);
+        break;
+      case 2:
+        setName((java.lang.String) value);
+        break;
+      case 3:
+        setAge((java.lang.Integer) value);
+        break;
+      case 4:
+        setEmail((java.lang.String) value);
+        break;
+      case 5:
+        if (phones_.size() > 1024) {
+          phones_ = java.util.Collections.emptyList();
+        } else if (!phones_.isEmpty()) {
+          phones_.clear();
+        }
+        ensurePhonesIsMutable();
+        phones_.addAll((java.util.Collection<com.example.tutorial.Person.PhoneNumber>) value);
+        onChanged(PHONES_FIELD_NUMBER);
+        break;
+      case 6:
+        if (friendIds_.size() > 1024) {
+          friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+        } else if (!friendIds_.isEmpty()) {
+          friendIds_.clear();
+        }
+        ensureFriendIdsIsMutable();
+        friendIds_.addAll((java.util.Collection<java.lang.String>) value);
+        onChanged(FRIENDIDS_FIELD_NUMBER);
+        break;
+      case 7:
+        if (friendIds2_.size() > 1024) {
+          friendIds2_ = java.util.Collections.emptyList();
+        } else if (!friendIds2_.isEmpty()) {
+          friendIds2_.clear();
+        }
+        ensureFriendIds2IsMutable();
+        friendIds2_.addAll((java.util.Collection<java.util.UUID>) value);
+        onChanged(FRIENDIDS2_FIELD_NUMBER);
+        break;
+      case 8:
+        if (favoriteNumber_.size() > 1024) {
+          favoriteNumber_ = emptyIntList();
+        } else if (!favoriteNumber_.isEmpty()) {
+          favoriteNumber_.clear();
+        }
+        ensureFavoriteNumberIsMutable();
+        favoriteNumber_.addAll((java.util.Collection<java.lang.Integer>) value);
+        onChanged(FAVORITENUMBER_FIELD_NUMBER);
+        break;
+      case 9:
+        setLastUpdated((com.google.protobuf.Timestamp) value);
+        break;
+    }
+  }
+
+  @java.lang.Override
+  public int getIntFieldByNumber(int number) {
+    switch (number) {
+      case 3: return getAge();
+      default: return super.getIntFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  public void setIntFieldByNumber(int number, int value) {
+    switch (number) {
+      case 3:
+        setAge(value);
+        break;
+      default:
+        super.setIntFieldByNumber(number, value);
+    }
+  }
+
   @java.lang.Override
   public java.lang.String toString() {
     java.lang.StringBuilder sb = new java.lang.StringBuilder("Person: {\n");
@@ -1193,6 +1983,204 @@ private static final long serialVersionUID = 0L;
     return sb.append('}').toString();
   }
 
+  /**
+   * Writes this message as proto3 JSON without reflection. Fields are
+   * written by the same presence rules as the binary format.
+   */
+  public void writeJson(java.lang.Appendable out) throws java.io.IOException {
+    out.append('{');
+    boolean first = true;
+    if (id_ != null) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "id");
+      de.leohilbert.proto.JsonWriter.writeString(out, de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.toProto(id_));
+    }
+    if (name_ != null) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "name");
+      de.leohilbert.proto.JsonWriter.writeString(out, name_);
+    }
+    if (age_ != 0) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "age");
+      de.leohilbert.proto.JsonWriter.writeInt(out, (age_));
+    }
+    if (email_ != null) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "email");
+      de.leohilbert.proto.JsonWriter.writeString(out, email_);
+    }
+    if (!phones_.isEmpty()) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "phones");
+      out.append('[');
+      for (int i = 0; i < phones_.size(); i++) {
+        if (i > 0) {
+          out.append(',');
+        }
+        phones_.get(i).writeJson(out);
+      }
+      out.append(']');
+    }
+    if (!friendIds_.isEmpty()) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "friendIds");
+      out.append('[');
+      for (int i = 0; i < friendIds_.size(); i++) {
+        if (i > 0) {
+          out.append(',');
+        }
+        de.leohilbert.proto.JsonWriter.writeString(out, friendIds_.get(i));
+      }
+      out.append(']');
+    }
+    if (!friendIds2_.isEmpty()) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "friendIds2");
+      out.append('[');
+      for (int i = 0; i < friendIds2_.size(); i++) {
+        if (i > 0) {
+          out.append(',');
+        }
+        de.leohilbert.proto.JsonWriter.writeString(out, de.leohilbert.proto.UuidCodec.toProto(friendIds2_.get(i)));
+      }
+      out.append(']');
+    }
+    if (!favoriteNumber_.isEmpty()) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "favoriteNumber");
+      out.append('[');
+      for (int i = 0; i < favoriteNumber_.size(); i++) {
+        if (i > 0) {
+          out.append(',');
+        }
+        de.leohilbert.proto.JsonWriter.writeInt(out, (favoriteNumber_.getInt(i)));
+      }
+      out.append(']');
+    }
+    if (lastUpdated_ != null) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "lastUpdated");
+      getLastUpdated().writeJson(out);
+    }
+    out.append('}');
+  }
+
+  public java.lang.String toJson() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder();
+    try {
+      writeJson(sb);
+    } catch (java.io.IOException e) {
+      throw new java.lang.RuntimeException(
+          "Writing to a StringBuilder threw an IOException (should never happen).", e);
+    }
+    return sb.toString();
+  }
+
+  /**
+   * Reads proto3 JSON into this message. Like updateFrom, all fields not
+   * contained in the JSON are reset to their defaults.
+   */
+  public void updateFromJson(java.io.Reader reader) throws java.io.IOException {
+    updateFromJson(new de.leohilbert.proto.JsonReader(reader));
+  }
+
+  public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {
+    beforeMessageUpdate();
+    clear();
+    in.beginObject();
+    while (in.hasNextMember()) {
+      switch (in.nextName()) {
+        case "id":
+          if (!in.nextNull()) {
+
+            id_ = de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.fromProto(in.readString());
+          }
+          break;
+        case "name":
+          if (!in.nextNull()) {
+
+            name_ = in.readString();
+          }
+          break;
+        case "age":
+          if (!in.nextNull()) {
+
+            age_ = (in.readInt());
+          }
+          break;
+        case "email":
+          if (!in.nextNull()) {
+
+            email_ = in.readString();
+          }
+          break;
+        case "phones":
+          if (!in.nextNull()) {
+            in.beginArray();
+            if (phones_.size() > 1024) {
+              phones_ = java.util.Collections.emptyList();
+            } else if (!phones_.isEmpty()) {
+              phones_.clear();
+            }
+            while (in.hasNextElement()) {
+              com.example.tutorial.Person.PhoneNumber message = new com.example.tutorial.Person.PhoneNumber();
+              message.updateFromJson(in);
+              ensurePhonesIsMutable();
+              phones_.add(message);
+            }
+          }
+          break;
+        case "friendIds":
+          if (!in.nextNull()) {
+            in.beginArray();
+            if (friendIds_.size() > 1024) {
+              friendIds_ = com.google.protobuf.LazyStringArrayList.EMPTY;
+            } else if (!friendIds_.isEmpty()) {
+              friendIds_.clear();
+            }
+            while (in.hasNextElement()) {
+              ensureFriendIdsIsMutable();
+              friendIds_.add(in.readString());
+            }
+          }
+          break;
+        case "friendIds2":
+          if (!in.nextNull()) {
+            in.beginArray();
+            if (friendIds2_.size() > 1024) {
+              friendIds2_ = java.util.Collections.emptyList();
+            } else if (!friendIds2_.isEmpty()) {
+              friendIds2_.clear();
+            }
+            while (in.hasNextElement()) {
+              ensureFriendIds2IsMutable();
+              friendIds2_.add(de.leohilbert.proto.UuidCodec.fromProto(in.readString()));
+            }
+          }
+          break;
+        case "favoriteNumber":
+          if (!in.nextNull()) {
+            in.beginArray();
+            if (favoriteNumber_.size() > 1024) {
+              favoriteNumber_ = emptyIntList();
+            } else if (!favoriteNumber_.isEmpty()) {
+              favoriteNumber_.clear();
+            }
+            while (in.hasNextElement()) {
+              ensureFavoriteNumberIsMutable();
+              favoriteNumber_.addInt((in.readInt()));
+            }
+          }
+          break;
+        case "lastUpdated":
+        case "last_updated":
+          if (!in.nextNull()) {
+            com.google.protobuf.Timestamp message = new com.google.protobuf.Timestamp();
+            message.updateFromJson(in);
+
+            lastUpdated_ = message;
+          }
+          break;
+        default:
+          in.skipValue();
+      }
+    }
+    onChanged(0);
+    afterMessageUpdate();
+  }
+
   public static com.example.tutorial.Person parseFrom(
       java.nio.ByteBuffer data)
       throws com.google.protobuf.InvalidProtocolBufferException {
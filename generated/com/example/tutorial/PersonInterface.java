@@ -89,70 +89,70 @@ com.example.custom.CustomPersonMarkerInterface,
   public static final int FRIENDIDS_FIELD_NUMBER = 6;
 
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @return A list containing the friendIds.
    */
   java.util.List<java.lang.String>
       getFriendIdsList();
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @return The count of friendIds.
    */
   int getFriendIdsCount();
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    * @param index The index of the element to return.
    * @return The friendIds at the given index.
    */
   java.lang.String getFriendIds(int index);
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    */
   public SELF setFriendIds(int index, java.lang.String value);
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    */
   public SELF addFriendIds(java.lang.String value);
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    */
   public SELF addAllFriendIds(java.util.Collection<java.lang.String> values);
   /**
-   * <code>repeated string friendIds = 6 [json_name = "friendIds"];</code>
+   * <code>repeated string friendIds = 6 [json_name = "friendIds", (.leo.proto.intern) = true];</code>
    */
   public SELF clearFriendIds();
   public static final int FRIENDIDS2_FIELD_NUMBER = 7;
 
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @return A list containing the friendIds2.
    */
   java.util.List<java.util.UUID> getFriendIds2List();
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @return The count of friendIds2.
    */
   int getFriendIds2Count();
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    * @param index The index of the element to return.
    * @return The friendIds2 at the given index.
    */
   java.util.UUID getFriendIds2(int index);
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    */
   public SELF setFriendIds2(int index, java.util.UUID value);
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    */
   public SELF addFriendIds2(java.util.UUID value);
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    */
   public SELF addAllFriendIds2(java.util.Collection<java.util.UUID> values);
   /**
-   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID"];</code>
+   * <code>repeated string friendIds2 = 7 [json_name = "friendIds2", (.leo.proto.javatype) = "java.util.UUID", (.leo.proto.builtin_codec) = true];</code>
    */
   public SELF clearFriendIds2();
   public static final int FAVORITENUMBER_FIELD_NUMBER = 8;
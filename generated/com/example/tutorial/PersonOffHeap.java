@@ -0,0 +1,226 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+/**
+ * A {@link com.example.tutorial.Person} stored in a
+ * {@link de.leohilbert.proto.OffHeapArena}. Instances are handles that
+ * are moved between records, a record itself is only an offset into
+ * the arena. Message, repeated, oneof and javatype fields are not
+ * stored.
+ */
+public final class PersonOffHeap {
+  /**
+   * The number of bytes a record takes in the arena.
+   */
+  public static final int SIZE = 24;
+
+  private final de.leohilbert.proto.OffHeapArena arena_;
+  private int offset_;
+
+  public PersonOffHeap(de.leohilbert.proto.OffHeapArena arena) {
+    arena_ = arena;
+  }
+
+  /**
+   * Allocates a record with every field at its default and moves this
+   * handle onto it.
+   */
+  public PersonOffHeap allocate() {
+    offset_ = arena_.allocate(SIZE);
+    return this;
+  }
+
+  /**
+   * Moves this handle onto the record at {@code offset}, as returned by
+   * {@link #getOffset()}.
+   */
+  public PersonOffHeap moveTo(int offset) {
+    offset_ = offset;
+    return this;
+  }
+
+  public int getOffset() {
+    return offset_;
+  }
+
+  public de.leohilbert.proto.OffHeapArena getArena() {
+    return arena_;
+  }
+
+  public java.lang.String getName() {
+    return arena_.getInt(offset_ + 4) != 0
+        ? arena_.readString(arena_.getInt(offset_), arena_.getInt(offset_ + 4))
+        : "";
+  }
+
+  public PersonOffHeap setName(java.lang.String value) {
+    if (value == null) {
+      return clearName();
+    }
+    byte[] bytes = value.getBytes(java.nio.charset.StandardCharsets.UTF_8);
+    arena_.putInt(offset_, arena_.storeBlob(arena_.getInt(offset_), bytes));
+    arena_.putInt(offset_ + 4, bytes.length);
+    return this;
+  }
+
+  /**
+   * Its blob is kept for the next value.
+   */
+  public PersonOffHeap clearName() {
+    arena_.putInt(offset_ + 4, 0);
+    return this;
+  }
+
+  public int getAge() {
+    return arena_.getInt(offset_ + 16);
+  }
+
+  public PersonOffHeap setAge(int value) {
+    arena_.putInt(offset_ + 16, value);
+    return this;
+  }
+
+  public PersonOffHeap clearAge() {
+    arena_.putInt(offset_ + 16, 0);
+    return this;
+  }
+
+  public java.lang.String getEmail() {
+    return arena_.getInt(offset_ + 12) != 0
+        ? arena_.readString(arena_.getInt(offset_ + 8), arena_.getInt(offset_ + 12))
+        : "";
+  }
+
+  public PersonOffHeap setEmail(java.lang.String value) {
+    if (value == null) {
+      return clearEmail();
+    }
+    byte[] bytes = value.getBytes(java.nio.charset.StandardCharsets.UTF_8);
+    arena_.putInt(offset_ + 8, arena_.storeBlob(arena_.getInt(offset_ + 8), bytes));
+    arena_.putInt(offset_ + 12, bytes.length);
+    return this;
+  }
+
+  /**
+   * Its blob is kept for the next value.
+   */
+  public PersonOffHeap clearEmail() {
+    arena_.putInt(offset_ + 12, 0);
+    return this;
+  }
+
+  /**
+   * Resets every field to its default, the blobs of strings and bytes
+   * are kept for the next values.
+   */
+  public PersonOffHeap clear() {
+    arena_.putInt(offset_ + 4, 0);
+    arena_.putInt(offset_ + 16, 0);
+    arena_.putInt(offset_ + 12, 0);
+    return this;
+  }
+
+  /**
+   * Replaces the stored fields with the ones of {@code message}.
+   */
+  public void copyFrom(com.example.tutorial.Person message) {
+    clear();
+    setName(message.getName());
+    setAge(message.getAge());
+    setEmail(message.getEmail());
+  }
+
+  /**
+   * Reads a {@link com.example.tutorial.Person} in the wire format, like its updateFrom
+   * all fields that are not in the input are reset to their defaults.
+   * Fields that are not stored and unknown fields are skipped.
+   */
+  public void updateFrom(com.google.protobuf.CodedInputStream input)
+      throws java.io.IOException {
+    clear();
+    while (true) {
+      int tag = input.readTag();
+      switch (tag) {
+        case 0:
+          return;
+        case 18: {
+          setName(input.readStringRequireUtf8());
+          break;
+        }
+        case 24: {
+          setAge(input.readInt32());
+          break;
+        }
+        case 34: {
+          setEmail(input.readStringRequireUtf8());
+          break;
+        }
+        default:
+          if (!input.skipField(tag)) {
+            return;
+          }
+          break;
+      }
+    }
+  }
+
+  public void writeTo(com.google.protobuf.CodedOutputStream output)
+      throws java.io.IOException {
+    if (arena_.getInt(offset_ + 4) != 0) {
+      int length = arena_.getInt(offset_ + 4);
+      output.writeTag(2,
+          com.google.protobuf.WireFormat.WIRETYPE_LENGTH_DELIMITED);
+      output.writeUInt32NoTag(length);
+      arena_.writeBlob(output, arena_.getInt(offset_), length);
+    }
+    if (arena_.getInt(offset_ + 16) != 0) {
+      output.writeInt32(3, arena_.getInt(offset_ + 16));
+    }
+    if (arena_.getInt(offset_ + 12) != 0) {
+      int length = arena_.getInt(offset_ + 12);
+      output.writeTag(4,
+          com.google.protobuf.WireFormat.WIRETYPE_LENGTH_DELIMITED);
+      output.writeUInt32NoTag(length);
+      arena_.writeBlob(output, arena_.getInt(offset_ + 8), length);
+    }
+  }
+
+  public int getSerializedSize() {
+    int size = 0;
+    if (arena_.getInt(offset_ + 4) != 0) {
+      int length = arena_.getInt(offset_ + 4);
+      size += com.google.protobuf.CodedOutputStream.computeTagSize(2)
+          + com.google.protobuf.CodedOutputStream.computeUInt32SizeNoTag(length)
+          + length;
+    }
+    if (arena_.getInt(offset_ + 16) != 0) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeInt32Size(3, arena_.getInt(offset_ + 16));
+    }
+    if (arena_.getInt(offset_ + 12) != 0) {
+      int length = arena_.getInt(offset_ + 12);
+      size += com.google.protobuf.CodedOutputStream.computeTagSize(4)
+          + com.google.protobuf.CodedOutputStream.computeUInt32SizeNoTag(length)
+          + length;
+    }
+    return size;
+  }
+
+  public byte[] toByteArray() {
+    try {
+      byte[] result = new byte[getSerializedSize()];
+      com.google.protobuf.CodedOutputStream output =
+          com.google.protobuf.CodedOutputStream.newInstance(result);
+      writeTo(output);
+      output.checkNoSpaceLeft();
+      return result;
+    } catch (java.io.IOException e) {
+      throw new java.lang.RuntimeException(
+          "Serializing to a byte array threw an IOException (should "
+              + "never happen).", e);
+    }
+  }
+}
+
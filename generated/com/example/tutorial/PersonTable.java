@@ -0,0 +1,243 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+/**
+ * Columnar storage for {@link com.example.tutorial.Person} rows, each field is
+ * kept in an array of its own. Messages, repeated fields, oneofs and
+ * javatype fields have no column and are skipped by {@link #append}
+ * and {@link #appendFrom}.
+ */
+public final class PersonTable {
+  private int size_;
+  private int capacity_;
+  private java.lang.String[] name_;
+  private int[] age_;
+  private java.lang.String[] email_;
+
+  public PersonTable() {
+    this(16);
+  }
+
+  public PersonTable(int capacity) {
+    name_ = new java.lang.String[capacity];
+    age_ = new int[capacity];
+    email_ = new java.lang.String[capacity];
+    capacity_ = capacity;
+  }
+
+  /**
+   * The number of rows.
+   */
+  public int size() {
+    return size_;
+  }
+
+  /**
+   * Removes all rows, the arrays are kept for the next ones.
+   */
+  public void clear() {
+    java.util.Arrays.fill(name_, 0, size_, null);
+    java.util.Arrays.fill(email_, 0, size_, null);
+    size_ = 0;
+  }
+
+  /**
+   * The name column, valid up to {@link #size()}. The
+   * table replaces it with a larger array when it grows.
+   */
+  public java.lang.String[] nameColumn() {
+    return name_;
+  }
+
+  /**
+   * The age column, valid up to {@link #size()}. The
+   * table replaces it with a larger array when it grows.
+   */
+  public int[] ageColumn() {
+    return age_;
+  }
+
+  /**
+   * The email column, valid up to {@link #size()}. The
+   * table replaces it with a larger array when it grows.
+   */
+  public java.lang.String[] emailColumn() {
+    return email_;
+  }
+
+  /**
+   * Appends a row with every field at its default.
+   * @return the index of the new row
+   */
+  public int addRow() {
+    if (size_ == capacity_) {
+      grow();
+    }
+    int row = size_++;
+    name_[row] = "";
+    age_[row] = 0;
+    email_[row] = "";
+    return row;
+  }
+
+  private void grow() {
+    int capacity = java.lang.Math.max(16, capacity_ * 2);
+    name_ = java.util.Arrays.copyOf(name_, capacity);
+    age_ = java.util.Arrays.copyOf(age_, capacity);
+    email_ = java.util.Arrays.copyOf(email_, capacity);
+    capacity_ = capacity;
+  }
+
+  /**
+   * Appends a row holding the column fields of {@code message}.
+   * @return the index of the new row
+   */
+  public int append(com.example.tutorial.Person message) {
+    int row = addRow();
+    name_[row] = java.util.Objects.requireNonNullElse(message.getName(), "");
+    age_[row] = message.getAge();
+    email_[row] = java.util.Objects.requireNonNullElse(message.getEmail(), "");
+    return row;
+  }
+
+  /**
+   * Parses a message from {@code input}, up to its end or current limit,
+   * into a new row. Fields without a column and unknown fields are
+   * skipped.
+   * @return the index of the new row
+   */
+  public int appendFrom(com.google.protobuf.CodedInputStream input)
+      throws java.io.IOException {
+    int row = addRow();
+    while (true) {
+      int tag = input.readTag();
+      switch (tag) {
+        case 0:
+          return row;
+        case 18: {
+          name_[row] = input.readStringRequireUtf8();
+          break;
+        }
+        case 24: {
+          age_[row] = input.readInt32();
+          break;
+        }
+        case 34: {
+          email_[row] = input.readStringRequireUtf8();
+          break;
+        }
+        default:
+          if (!input.skipField(tag)) {
+            return row;
+          }
+          break;
+      }
+    }
+  }
+
+  /**
+   * Writes a row in the wire format of {@link com.example.tutorial.Person}.
+   */
+  public void writeRowTo(com.google.protobuf.CodedOutputStream output,
+      int row) throws java.io.IOException {
+    if (!name_[row].isEmpty()) {
+      output.writeString(2, name_[row]);
+    }
+    if (age_[row] != 0) {
+      output.writeInt32(3, age_[row]);
+    }
+    if (!email_[row].isEmpty()) {
+      output.writeString(4, email_[row]);
+    }
+  }
+
+  /**
+   * The number of bytes {@link #writeRowTo} writes for a row.
+   */
+  public int getRowSerializedSize(int row) {
+    int size = 0;
+    if (!name_[row].isEmpty()) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeStringSize(2, name_[row]);
+    }
+    if (age_[row] != 0) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeInt32Size(3, age_[row]);
+    }
+    if (!email_[row].isEmpty()) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeStringSize(4, email_[row]);
+    }
+    return size;
+  }
+
+  /**
+   * Returns a new cursor, move it over the rows instead of creating one
+   * per row.
+   */
+  public Cursor cursor() {
+    return new Cursor();
+  }
+
+  /**
+   * Accessors for the fields of one row, {@link #moveTo} points it at
+   * another one.
+   */
+  public final class Cursor {
+    private int row;
+
+    private Cursor() {
+    }
+
+    public Cursor moveTo(int row) {
+      if (row < 0 || row >= size_) {
+        throw new java.lang.IndexOutOfBoundsException(
+            "row " + row + " of " + size_);
+      }
+      this.row = row;
+      return this;
+    }
+
+    public int getRow() {
+      return row;
+    }
+
+    public java.lang.String getName() {
+      return name_[row];
+    }
+
+    public Cursor setName(java.lang.String value) {
+      if (value == null) {
+        name_[row] = "";
+        return this;
+      }
+      name_[row] = value;
+      return this;
+    }
+
+    public int getAge() {
+      return age_[row];
+    }
+
+    public Cursor setAge(int value) {
+      age_[row] = value;
+      return this;
+    }
+
+    public java.lang.String getEmail() {
+      return email_[row];
+    }
+
+    public Cursor setEmail(java.lang.String value) {
+      if (value == null) {
+        email_[row] = "";
+        return this;
+      }
+      email_[row] = value;
+      return this;
+    }
+  }
+}
+
@@ -68,6 +68,19 @@ public enum PhoneType
     }
   }
 
+  /**
+   * @param name The name of the enum entry as written in the .proto file.
+   * @return The enum with the given name, or null if there is none.
+   */
+  public static PhoneType forName(java.lang.String name) {
+    switch (name) {
+      case "MOBILE": return MOBILE;
+      case "HOME": return HOME;
+      case "WORK": return WORK;
+      default: return null;
+    }
+  }
+
   public static com.google.protobuf.Internal.EnumLiteMap<PhoneType>
       internalGetValueMap() {
     return internalValueMap;
@@ -0,0 +1,774 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+/**
+ * Protobuf type {@code tutorial.Session}
+ */
+public final class Session extends
+    SessionCustom implements
+    // @@protoc_insertion_point(message_implements:tutorial.Session)
+    SessionInterface<Session> {
+private static final long serialVersionUID = 0L;
+  public Session() {
+    started_ = null;
+    length_ = null;
+    retries_ = null;
+    device_ = null;
+    afterMessageInit();
+  }
+
+  @java.lang.Override
+  @SuppressWarnings({"unused"})
+  protected java.lang.Object newInstance(
+      UnusedPrivateParameter unused) {
+    return new Session();
+  }
+
+  @java.lang.Override
+  public final com.google.protobuf.UnknownFieldSet
+  getUnknownFields() {
+    return this.unknownFields;
+  }
+  public Session(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    this();
+    updateFrom(input, extensionRegistry);
+  }
+  public void updateFrom(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    if (extensionRegistry == null) {
+      throw new java.lang.NullPointerException();
+    }
+    beforeMessageUpdate();
+    int mutable_bitField0_ = 0;
+    com.google.protobuf.UnknownFieldSet.Builder unknownFields = null;
+    try {
+      clear();
+      boolean done = false;
+      while (!done) {
+        int tag = input.readTag();
+        switch (tag) {
+          case 0:
+            done = true;
+            break;
+          case 10: {
+            bitField0_ |= 0x00000001;
+            started_ = de.leohilbert.proto.InstantCodec.read(input);
+            break;
+          }
+          case 18: {
+            bitField0_ |= 0x00000002;
+            length_ = de.leohilbert.proto.DurationCodec.read(input);
+            break;
+          }
+          case 26: {
+            bitField0_ |= 0x00000004;
+            retries_ = de.leohilbert.proto.WrapperCodecs.Int32Value.read(input);
+            break;
+          }
+          case 34: {
+            bitField0_ |= 0x00000008;
+            device_ = de.leohilbert.proto.WrapperCodecs.StringValue.read(input);
+            break;
+          }
+          default: {
+            if (unknownFields == null) {
+              unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();
+            }
+            if (!parseUnknownField(
+                input, unknownFields, extensionRegistry, tag)) {
+              done = true;
+            }
+            break;
+          }
+        }
+      }
+      afterMessageUpdate();
+    } catch (com.google.protobuf.InvalidProtocolBufferException e) {
+      throw e.setUnfinishedMessage(this);
+    } catch (java.io.IOException e) {
+      throw new com.google.protobuf.InvalidProtocolBufferException(
+          e).setUnfinishedMessage(this);
+    } finally {
+      this.unknownFields = unknownFields == null
+          ? com.google.protobuf.UnknownFieldSet.getDefaultInstance()
+          : unknownFields.build();
+      makeExtensionsImmutable();
+    }
+  }
+  private static final class DescriptorHolder {
+    static final com.google.protobuf.Descriptors.Descriptor
+      descriptor =
+        com.example.tutorial.AddressBookProtos.getDescriptor().getMessageTypes().get(2);
+    static final
+      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+        fieldAccessorTable = new
+          com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
+            descriptor,
+            new java.lang.String[] { "Started", "Length", "Retries", "Device", });
+  }
+
+  public static final com.google.protobuf.Descriptors.Descriptor
+      getDescriptor() {
+    return DescriptorHolder.descriptor;
+  }
+
+  @java.lang.Override
+  protected com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+      internalGetFieldAccessorTable() {
+    return DescriptorHolder.fieldAccessorTable
+        .ensureFieldAccessorsInitialized(
+            com.example.tutorial.Session.class);
+  }
+
+  private int bitField0_;
+  private java.time.Instant started_;
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @return Whether the started field is set.
+   */
+  @java.lang.Override
+  public boolean hasStarted() {
+    return ((bitField0_ & 0x00000001) != 0);
+  }
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @return The started.
+   */
+  @java.lang.Override
+  public java.time.Instant getStarted() {
+    return started_;
+  }
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @param value The started to set.
+   */
+  public Session setStarted(java.time.Instant value) {
+    beforeMessageUpdate();
+    bitField0_ |= 0x00000001;
+    if(started_ != value) {
+      started_ = value;
+      onChanged(STARTED_FIELD_NUMBER);
+    }
+    return this;
+  }
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @return 'This' for chaining.
+   */
+  public Session clearStarted() {
+    beforeMessageUpdate();
+    started_ = null;
+    onChanged(STARTED_FIELD_NUMBER);
+    return this;
+  }
+
+  private java.time.Duration length_;
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @return Whether the length field is set.
+   */
+  @java.lang.Override
+  public boolean hasLength() {
+    return ((bitField0_ & 0x00000002) != 0);
+  }
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @return The length.
+   */
+  @java.lang.Override
+  public java.time.Duration getLength() {
+    return length_;
+  }
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @param value The length to set.
+   */
+  public Session setLength(java.time.Duration value) {
+    beforeMessageUpdate();
+    bitField0_ |= 0x00000002;
+    if(length_ != value) {
+      length_ = value;
+      onChanged(LENGTH_FIELD_NUMBER);
+    }
+    return this;
+  }
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @return 'This' for chaining.
+   */
+  public Session clearLength() {
+    beforeMessageUpdate();
+    length_ = null;
+    onChanged(LENGTH_FIELD_NUMBER);
+    return this;
+  }
+
+  private java.lang.Integer retries_;
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @return Whether the retries field is set.
+   */
+  @java.lang.Override
+  public boolean hasRetries() {
+    return ((bitField0_ & 0x00000004) != 0);
+  }
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @return The retries.
+   */
+  @java.lang.Override
+  public java.lang.Integer getRetries() {
+    return retries_;
+  }
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @param value The retries to set.
+   */
+  public Session setRetries(java.lang.Integer value) {
+    beforeMessageUpdate();
+    bitField0_ |= 0x00000004;
+    if(retries_ != value) {
+      retries_ = value;
+      onChanged(RETRIES_FIELD_NUMBER);
+    }
+    return this;
+  }
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @return 'This' for chaining.
+   */
+  public Session clearRetries() {
+    beforeMessageUpdate();
+    retries_ = null;
+    onChanged(RETRIES_FIELD_NUMBER);
+    return this;
+  }
+
+  private java.lang.String device_;
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @return Whether the device field is set.
+   */
+  @java.lang.Override
+  public boolean hasDevice() {
+    return ((bitField0_ & 0x00000008) != 0);
+  }
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @return The device.
+   */
+  @java.lang.Override
+  public java.lang.String getDevice() {
+    return device_;
+  }
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @param value The device to set.
+   */
+  public Session setDevice(java.lang.String value) {
+    beforeMessageUpdate();
+    bitField0_ |= 0x00000008;
+    if(device_ != value) {
+      device_ = value;
+      onChanged(DEVICE_FIELD_NUMBER);
+    }
+    return this;
+  }
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @return 'This' for chaining.
+   */
+  public Session clearDevice() {
+    beforeMessageUpdate();
+    device_ = null;
+    onChanged(DEVICE_FIELD_NUMBER);
+    return this;
+  }
+
+  private byte memoizedIsInitialized = -1;
+  @java.lang.Override
+  public final boolean isInitialized() {
+    byte isInitialized = memoizedIsInitialized;
+    if (isInitialized == 1) return true;
+    if (isInitialized == 0) return false;
+
+    memoizedIsInitialized = 1;
+    return true;
+  }
+
+  @java.lang.Override
+  public void writeTo(com.google.protobuf.CodedOutputStream output)
+                      throws java.io.IOException {
+    if (((bitField0_ & 0x00000001) != 0)) {
+      de.leohilbert.proto.InstantCodec.write(output, 1, started_);
+    }
+    if (((bitField0_ & 0x00000002) != 0)) {
+      de.leohilbert.proto.DurationCodec.write(output, 2, length_);
+    }
+    if (((bitField0_ & 0x00000004) != 0)) {
+      de.leohilbert.proto.WrapperCodecs.Int32Value.write(output, 3, retries_);
+    }
+    if (((bitField0_ & 0x00000008) != 0)) {
+      de.leohilbert.proto.WrapperCodecs.StringValue.write(output, 4, device_);
+    }
+    unknownFields.writeTo(output);
+  }
+
+  @java.lang.Override
+  public int getSerializedSize() {
+    int size = memoizedSize;
+    // LEO: caching is disabled for now, since custom objects are not yet considered
+    // if (size != -1) return size;
+
+    size = 0;
+    if (((bitField0_ & 0x00000001) != 0)) {
+      size += 1 + de.leohilbert.proto.InstantCodec.size(started_);
+    }
+    if (((bitField0_ & 0x00000002) != 0)) {
+      size += 1 + de.leohilbert.proto.DurationCodec.size(length_);
+    }
+    if (((bitField0_ & 0x00000004) != 0)) {
+      size += 1 + de.leohilbert.proto.WrapperCodecs.Int32Value.size(retries_);
+    }
+    if (((bitField0_ & 0x00000008) != 0)) {
+      size += 1 + de.leohilbert.proto.WrapperCodecs.StringValue.size(device_);
+    }
+    size += unknownFields.getSerializedSize();
+    memoizedSize = size;
+    return size;
+  }
+
+  @java.lang.Override
+  public boolean equals(final java.lang.Object obj) {
+    if (obj == this) {
+     return true;
+    }
+    if (!(obj instanceof com.example.tutorial.Session)) {
+      return false;
+    }
+    com.example.tutorial.Session other = (com.example.tutorial.Session) obj;
+
+    if (!java.util.Objects.equals(getStarted(),
+        other.getStarted())) return false;
+    if (!java.util.Objects.equals(getLength(),
+        other.getLength())) return false;
+    if (!java.util.Objects.equals(getRetries(),
+        other.getRetries())) return false;
+    if (!java.util.Objects.equals(getDevice(),
+        other.getDevice())) return false;
+    if (!unknownFields.equals(other.unknownFields)) return false;
+    return true;
+  }
+
+  @java.lang.Override
+  public int hashCode() {
+    if (memoizedHashCode != 0) {
+      return memoizedHashCode;
+    }
+    int hash = 41;
+    hash = (19 * hash) + "tutorial.Session".hashCode();
+    hash = (37 * hash) + STARTED_FIELD_NUMBER;
+    hash = (53 * hash) + java.util.Objects.hashCode(getStarted());
+    hash = (37 * hash) + LENGTH_FIELD_NUMBER;
+    hash = (53 * hash) + java.util.Objects.hashCode(getLength());
+    hash = (37 * hash) + RETRIES_FIELD_NUMBER;
+    hash = (53 * hash) + java.util.Objects.hashCode(getRetries());
+    hash = (37 * hash) + DEVICE_FIELD_NUMBER;
+    hash = (53 * hash) + java.util.Objects.hashCode(getDevice());
+    hash = (29 * hash) + unknownFields.hashCode();
+    memoizedHashCode = hash;
+    return hash;
+  }
+
+  public static final long STARTED_DIFF_BIT = 1L << 0;
+  public static final long LENGTH_DIFF_BIT = 1L << 1;
+  public static final long RETRIES_DIFF_BIT = 1L << 2;
+  public static final long DEVICE_DIFF_BIT = 1L << 3;
+
+  /**
+   * Returns a mask with the {@code *_DIFF_BIT} of every field that is not
+   * equal in {@code other}.
+   */
+  public long diffMask(com.example.tutorial.Session other) {
+    long mask = 0L;
+    if (!java.util.Objects.equals(started_, other.started_)) {
+      mask |= STARTED_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(length_, other.length_)) {
+      mask |= LENGTH_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(retries_, other.retries_)) {
+      mask |= RETRIES_DIFF_BIT;
+    }
+    if (!java.util.Objects.equals(device_, other.device_)) {
+      mask |= DEVICE_DIFF_BIT;
+    }
+    return mask;
+  }
+
+  /**
+   * Returns the paths of all fields that are not equal in {@code other}.
+   * Nested messages are compared recursively, e.g. "phones[0].number".
+   */
+  public java.util.List<java.lang.String> diffPaths(com.example.tutorial.Session other) {
+    java.util.List<java.lang.String> paths = new java.util.ArrayList<>();
+    diffPaths(other, "", paths);
+    return paths;
+  }
+
+  public void diffPaths(com.example.tutorial.Session other, java.lang.String prefix,
+      java.util.List<java.lang.String> paths) {
+    long mask = diffMask(other);
+    if (mask == 0L) {
+      return;
+    }
+    if ((mask & STARTED_DIFF_BIT) != 0L) {
+      paths.add(prefix + "started");
+    }
+    if ((mask & LENGTH_DIFF_BIT) != 0L) {
+      paths.add(prefix + "length");
+    }
+    if ((mask & RETRIES_DIFF_BIT) != 0L) {
+      paths.add(prefix + "retries");
+    }
+    if ((mask & DEVICE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "device");
+    }
+  }
+
+  @java.lang.Override
+  public void clear() {
+    beforeMessageUpdate();
+    started_ = null;
+    bitField0_ = (bitField0_ & ~0x00000001);
+    length_ = null;
+    bitField0_ = (bitField0_ & ~0x00000002);
+    retries_ = null;
+    bitField0_ = (bitField0_ & ~0x00000004);
+    device_ = null;
+    bitField0_ = (bitField0_ & ~0x00000008);
+  }
+
+  /**
+   * Copies all fields of {@code other} into this message without a
+   * serialization round-trip. Nested messages and repeated fields are
+   * deep-copied, immutable values are shared.
+   */
+  public com.example.tutorial.Session copyFrom(com.example.tutorial.Session other) {
+    if (other == this) {
+      return this;
+    }
+    beforeMessageUpdate();
+    bitField0_ = other.bitField0_;
+    started_ = other.started_;
+    length_ = other.length_;
+    retries_ = other.retries_;
+    device_ = other.device_;
+    this.unknownFields = other.unknownFields;
+    onChanged(0);
+    afterMessageUpdate();
+    return this;
+  }
+
+  public com.example.tutorial.Session deepCopy() {
+    return new com.example.tutorial.Session().copyFrom(this);
+  }
+
+  /**
+   * Returns an immutable snapshot of this message. Nested messages that
+   * did not change since the last freeze() are shared with the previous
+   * snapshot. Changes that bypass the setters, e.g. through lists returned
+   * by getters or inside javatype values, are not tracked.
+   */
+  public com.example.tutorial.Session freeze() {
+    if (isFrozen()) {
+      return this;
+    }
+    com.example.tutorial.Session previous = (com.example.tutorial.Session) frozenSnapshot;
+    if (previous != null) {
+      return previous;
+    }
+    com.example.tutorial.Session snapshot = new com.example.tutorial.Session();
+    snapshot.freezeFrom(this);
+    snapshot.markFrozen();
+    frozenSnapshot = snapshot;
+    return snapshot;
+  }
+
+  private void freezeFrom(com.example.tutorial.Session other) {
+    bitField0_ = other.bitField0_;
+    started_ = other.started_;
+    length_ = other.length_;
+    retries_ = other.retries_;
+    device_ = other.device_;
+    this.unknownFields = other.unknownFields;
+  }
+
+  @java.lang.Override
+  public java.lang.Object getFieldByNumber(int number) {
+    switch (number) {
+      case 1: return getStarted();
+      case 2: return getLength();
+      case 3: return getRetries();
+      case 4: return getDevice();
+      default: return super.getFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  @SuppressWarnings("unchecked")
+  public void setFieldByNumber(int number, java.lang.Object value) {
+    switch (number) {
+      case 1:
+        de.leohilbert.proto.FieldValues.check(value, java.time.Instant.class, true,
+            "tutorial.Session.started");
+        break;
+      case 2:
+        de.leohilbert.proto.FieldValues.check(value, java.time.Duration.class, true,
+            "tutorial.Session.length");
+        break;
+      case 3:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.Integer.class, true,
+            "tutorial.Session.retries");
+        break;
+      case 4:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+            "tutorial.Session.device");
+        break;
+      default:
+        super.setFieldByNumber(number, value);
+        return;
+    }
+    beforeMessageUpdate();
+    switch (number) {
+      case 1:
+        setStarted((java.time.Instant) value);
+        break;
+      case 2:
+        setLength((java.time.Duration) value);
+        break;
+      case 3:
+        setRetries((java.lang.Integer) value);
+        break;
+      case 4:
+        setDevice((java.lang.String) value);
+        break;
+    }
+  }
+
+  @java.lang.Override
+  public java.lang.String toString() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder("Session: {\n");
+    sb.append("\"started\": \"").append(java.lang.String.valueOf(started_)).append("\",\n");
+    sb.append("\"length\": \"").append(java.lang.String.valueOf(length_)).append("\",\n");
+    sb.append("\"retries\": \"").append(java.lang.String.valueOf(retries_)).append("\",\n");
+    sb.append("\"device\": \"").append(java.lang.String.valueOf(device_)).append("\",\n");
+    return sb.append('}').toString();
+  }
+
+  /**
+   * Writes this message as proto3 JSON without reflection. Fields are
+   * written by the same presence rules as the binary format.
+   */
+  public void writeJson(java.lang.Appendable out) throws java.io.IOException {
+    out.append('{');
+    boolean first = true;
+    if (((bitField0_ & 0x00000001) != 0)) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "started");
+      de.leohilbert.proto.InstantCodec.toProto(started_).writeJson(out);
+    }
+    if (((bitField0_ & 0x00000002) != 0)) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "length");
+      de.leohilbert.proto.DurationCodec.toProto(length_).writeJson(out);
+    }
+    if (((bitField0_ & 0x00000004) != 0)) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "retries");
+      de.leohilbert.proto.WrapperCodecs.Int32Value.toProto(retries_).writeJson(out);
+    }
+    if (((bitField0_ & 0x00000008) != 0)) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "device");
+      de.leohilbert.proto.WrapperCodecs.StringValue.toProto(device_).writeJson(out);
+    }
+    out.append('}');
+  }
+
+  public java.lang.String toJson() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder();
+    try {
+      writeJson(sb);
+    } catch (java.io.IOException e) {
+      throw new java.lang.RuntimeException(
+          "Writing to a StringBuilder threw an IOException (should never happen).", e);
+    }
+    return sb.toString();
+  }
+
+  /**
+   * Reads proto3 JSON into this message. Like updateFrom, all fields not
+   * contained in the JSON are reset to their defaults.
+   */
+  public void updateFromJson(java.io.Reader reader) throws java.io.IOException {
+    updateFromJson(new de.leohilbert.proto.JsonReader(reader));
+  }
+
+  public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {
+    beforeMessageUpdate();
+    clear();
+    in.beginObject();
+    while (in.hasNextMember()) {
+      switch (in.nextName()) {
+        case "started":
+          if (!in.nextNull()) {
+            com.google.protobuf.Timestamp message = new com.google.protobuf.Timestamp();
+            message.updateFromJson(in);
+            bitField0_ |= 0x00000001;
+            started_ = de.leohilbert.proto.InstantCodec.fromProto(message);
+          }
+          break;
+        case "length":
+          if (!in.nextNull()) {
+            com.google.protobuf.Duration message = new com.google.protobuf.Duration();
+            message.updateFromJson(in);
+            bitField0_ |= 0x00000002;
+            length_ = de.leohilbert.proto.DurationCodec.fromProto(message);
+          }
+          break;
+        case "retries":
+          if (!in.nextNull()) {
+            com.google.protobuf.Int32Value message = new com.google.protobuf.Int32Value();
+            message.updateFromJson(in);
+            bitField0_ |= 0x00000004;
+            retries_ = de.leohilbert.proto.WrapperCodecs.Int32Value.fromProto(message);
+          }
+          break;
+        case "device":
+          if (!in.nextNull()) {
+            com.google.protobuf.StringValue message = new com.google.protobuf.StringValue();
+            message.updateFromJson(in);
+            bitField0_ |= 0x00000008;
+            device_ = de.leohilbert.proto.WrapperCodecs.StringValue.fromProto(message);
+          }
+          break;
+        default:
+          in.skipValue();
+      }
+    }
+    onChanged(0);
+    afterMessageUpdate();
+  }
+
+  public static com.example.tutorial.Session parseFrom(
+      java.nio.ByteBuffer data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      java.nio.ByteBuffer data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      com.google.protobuf.ByteString data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      com.google.protobuf.ByteString data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Session parseFrom(byte[] data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      byte[] data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Session parseFrom(java.io.InputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      java.io.InputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input, extensionRegistry);
+  }
+  public static com.example.tutorial.Session parseDelimitedFrom(java.io.InputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseDelimitedWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Session parseDelimitedFrom(
+      java.io.InputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseDelimitedWithIOException(PARSER, input, extensionRegistry);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      com.google.protobuf.CodedInputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Session parseFrom(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input, extensionRegistry);
+  }
+
+
+  // @@protoc_insertion_point(class_scope:tutorial.Session)
+  private static final com.example.tutorial.Session DEFAULT_INSTANCE;
+  static {
+    DEFAULT_INSTANCE = new com.example.tutorial.Session();
+  }
+
+  public static com.example.tutorial.Session getDefaultInstance() {
+    return DEFAULT_INSTANCE;
+  }
+
+  private static final com.google.protobuf.Parser<Session>
+      PARSER = new com.google.protobuf.AbstractParser<Session>() {
+    @java.lang.Override
+    public Session parsePartialFrom(
+        com.google.protobuf.CodedInputStream input,
+        com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+        throws com.google.protobuf.InvalidProtocolBufferException {
+      return new Session(input, extensionRegistry);
+    }
+  };
+
+  public static com.google.protobuf.Parser<Session> parser() {
+    return PARSER;
+  }
+
+  @java.lang.Override
+  public com.google.protobuf.Parser<Session> getParserForType() {
+    return PARSER;
+  }
+
+  @java.lang.Override
+  public com.example.tutorial.Session getDefaultInstanceForType() {
+    return DEFAULT_INSTANCE;
+  }
+
+}
+
@@ -0,0 +1,77 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+public interface SessionInterface<SELF> extends
+    // @@protoc_insertion_point(interface_extends:tutorial.Session)
+    com.google.protobuf.MessageOrBuilder {
+  public static final int STARTED_FIELD_NUMBER = 1;
+
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @return Whether the started field is set.
+   */
+  boolean hasStarted();
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @return The started.
+   */
+  java.time.Instant getStarted();
+  /**
+   * <code>.google.protobuf.Timestamp started = 1 [json_name = "started"];</code>
+   * @param value The started to set.
+   */
+  SELF setStarted(java.time.Instant value);
+  public static final int LENGTH_FIELD_NUMBER = 2;
+
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @return Whether the length field is set.
+   */
+  boolean hasLength();
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @return The length.
+   */
+  java.time.Duration getLength();
+  /**
+   * <code>.google.protobuf.Duration length = 2 [json_name = "length"];</code>
+   * @param value The length to set.
+   */
+  SELF setLength(java.time.Duration value);
+  public static final int RETRIES_FIELD_NUMBER = 3;
+
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @return Whether the retries field is set.
+   */
+  boolean hasRetries();
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @return The retries.
+   */
+  java.lang.Integer getRetries();
+  /**
+   * <code>.google.protobuf.Int32Value retries = 3 [json_name = "retries"];</code>
+   * @param value The retries to set.
+   */
+  SELF setRetries(java.lang.Integer value);
+  public static final int DEVICE_FIELD_NUMBER = 4;
+
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @return Whether the device field is set.
+   */
+  boolean hasDevice();
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @return The device.
+   */
+  java.lang.String getDevice();
+  /**
+   * <code>.google.protobuf.StringValue device = 4 [json_name = "device"];</code>
+   * @param value The device to set.
+   */
+  SELF setDevice(java.lang.String value);
+}
@@ -0,0 +1,1008 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+/**
+ * Protobuf type {@code tutorial.Setting}
+ */
+public final class Setting extends
+    SettingCustom implements
+    // @@protoc_insertion_point(message_implements:tutorial.Setting)
+    SettingInterface<Setting> {
+private static final long serialVersionUID = 0L;
+  public Setting() {
+    key_ = null;
+    afterMessageInit();
+  }
+
+  @java.lang.Override
+  @SuppressWarnings({"unused"})
+  protected java.lang.Object newInstance(
+      UnusedPrivateParameter unused) {
+    return new Setting();
+  }
+
+  @java.lang.Override
+  public final com.google.protobuf.UnknownFieldSet
+  getUnknownFields() {
+    return this.unknownFields;
+  }
+  public Setting(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    this();
+    updateFrom(input, extensionRegistry);
+  }
+  public void updateFrom(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    if (extensionRegistry == null) {
+      throw new java.lang.NullPointerException();
+    }
+    beforeMessageUpdate();
+    com.google.protobuf.UnknownFieldSet.Builder unknownFields = null;
+    try {
+      clear();
+      boolean done = false;
+      while (!done) {
+        int tag = input.readTag();
+        switch (tag) {
+          case 0:
+            done = true;
+            break;
+          case 10: {
+            java.lang.String s = input.readStringRequireUtf8();
+
+            key_ = s;
+            break;
+          }
+          case 16: {
+            valueCase_ = 2;
+            valueBits_ = input.readInt64();
+            value_ = null;
+            break;
+          }
+          case 25: {
+            valueCase_ = 3;
+            valueBits_ = java.lang.Double.doubleToRawLongBits(input.readDouble());
+            value_ = null;
+            break;
+          }
+          case 32: {
+            valueCase_ = 4;
+            valueBits_ = (input.readBool() ? 1L : 0L);
+            value_ = null;
+            break;
+          }
+          case 42: {
+            java.lang.String s = input.readStringRequireUtf8();
+            valueCase_ = 5;
+            value_ = s;
+            break;
+          }
+          default: {
+            if (unknownFields == null) {
+              unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();
+            }
+            if (!parseUnknownField(
+                input, unknownFields, extensionRegistry, tag)) {
+              done = true;
+            }
+            break;
+          }
+        }
+      }
+      afterMessageUpdate();
+    } catch (com.google.protobuf.InvalidProtocolBufferException e) {
+      throw e.setUnfinishedMessage(this);
+    } catch (java.io.IOException e) {
+      throw new com.google.protobuf.InvalidProtocolBufferException(
+          e).setUnfinishedMessage(this);
+    } finally {
+      this.unknownFields = unknownFields == null
+          ? com.google.protobuf.UnknownFieldSet.getDefaultInstance()
+          : unknownFields.build();
+      makeExtensionsImmutable();
+    }
+  }
+  private static final class DescriptorHolder {
+    static final com.google.protobuf.Descriptors.Descriptor
+      descriptor =
+        com.example.tutorial.AddressBookProtos.getDescriptor().getMessageTypes().get(3);
+    static final
+      com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+        fieldAccessorTable = new
+          com.google.protobuf.GeneratedMessageV3.FieldAccessorTable(
+            descriptor,
+            new java.lang.String[] { "Key", "LongValue", "DoubleValue", "BoolValue", "StringValue", "Value", });
+  }
+
+  public static final com.google.protobuf.Descriptors.Descriptor
+      getDescriptor() {
+    return DescriptorHolder.descriptor;
+  }
+
+  @java.lang.Override
+  protected com.google.protobuf.GeneratedMessageV3.FieldAccessorTable
+      internalGetFieldAccessorTable() {
+    return DescriptorHolder.fieldAccessorTable
+        .ensureFieldAccessorsInitialized(
+            com.example.tutorial.Setting.class);
+  }
+
+  private int valueCase_ = 0;
+  private java.lang.Object value_;
+  private long valueBits_;
+  public enum ValueCase
+      implements com.google.protobuf.Internal.EnumLite,
+          com.google.protobuf.AbstractMessage.InternalOneOfEnum {
+    LONG_VALUE(2),
+    DOUBLE_VALUE(3),
+    BOOL_VALUE(4),
+    STRING_VALUE(5),
+    VALUE_NOT_SET(0);
+    private final int value;
+    private ValueCase(int value) {
+      this.value = value;
+    }
+    /**
+     * @param value The number of the enum to look for.
+     * @return The enum associated with the given number.
+     * @deprecated Use {@link #forNumber(int)} instead.
+     */
+    @java.lang.Deprecated
+    public static ValueCase valueOf(int value) {
+      return forNumber(value);
+    }
+
+    public static ValueCase forNumber(int value) {
+      switch (value) {
+        case 2: return LONG_VALUE;
+        case 3: return DOUBLE_VALUE;
+        case 4: return BOOL_VALUE;
+        case 5: return STRING_VALUE;
+        case 0: return VALUE_NOT_SET;
+        default: return null;
+      }
+    }
+    public int getNumber() {
+      return this.value;
+    }
+  };
+
+  public ValueCase
+  getValueCase() {
+    return ValueCase.forNumber(
+        valueCase_);
+  }
+
+  private volatile java.lang.String key_;
+  /**
+   * <code>string key = 1 [json_name = "key"];</code>
+   * @return The key.
+   */
+  @java.lang.Override
+  public java.lang.String getKey() {
+    return key_;
+  }
+  /**
+   * <code>string key = 1 [json_name = "key"];</code>
+   * @param value The key to set.
+   */
+  public Setting setKey(
+      java.lang.String value) {
+    beforeMessageUpdate();
+    
+    if (!java.util.Objects.equals(value, key_)) {
+      key_ = value;
+      onChanged(KEY_FIELD_NUMBER);
+    }
+    return this;
+  }
+
+  /**
+   * <code>int64 long_value = 2 [json_name = "longValue"];</code>
+   * @return The longValue.
+   */
+  public long getLongValue() {
+    if (valueCase_ == 2) {
+      return valueBits_;
+    }
+    return 0L;
+  }
+  /**
+   * <code>int64 long_value = 2 [json_name = "longValue"];</code>
+   * @param value The longValue to set.
+   * @return 'This' for chaining.
+   */
+  public Setting setLongValue(long value) {
+    beforeMessageUpdate();
+    valueCase_ = 2;
+    valueBits_ = value;
+    value_ = null;
+    onChanged(LONG_VALUE_FIELD_NUMBER);
+    return this;
+  }
+  /**
+   * <code>int64 long_value = 2 [json_name = "longValue"];</code>
+   * @return 'This' for chaining.
+   */
+  public Setting clearLongValue() {
+    beforeMessageUpdate();
+    if (valueCase_ == 2) {
+      valueCase_ = 0;
+      value_ = null;
+      onChanged(LONG_VALUE_FIELD_NUMBER);
+    }
+    return this;
+  }
+
+  /**
+   * <code>double double_value = 3 [json_name = "doubleValue"];</code>
+   * @return The doubleValue.
+   */
+  public double getDoubleValue() {
+    if (valueCase_ == 3) {
+      return java.lang.Double.longBitsToDouble(valueBits_);
+    }
+    return 0D;
+  }
+  /**
+   * <code>double double_value = 3 [json_name = "doubleValue"];</code>
+   * @param value The doubleValue to set.
+   * @return 'This' for chaining.
+   */
+  public Setting setDoubleValue(double value) {
+    beforeMessageUpdate();
+    valueCase_ = 3;
+    valueBits_ = java.lang.Double.doubleToRawLongBits(value);
+    value_ = null;
+    onChanged(DOUBLE_VALUE_FIELD_NUMBER);
+    return this;
+  }
+  /**
+   * <code>double double_value = 3 [json_name = "doubleValue"];</code>
+   * @return 'This' for chaining.
+   */
+  public Setting clearDoubleValue() {
+    beforeMessageUpdate();
+    if (valueCase_ == 3) {
+      valueCase_ = 0;
+      value_ = null;
+      onChanged(DOUBLE_VALUE_FIELD_NUMBER);
+    }
+    return this;
+  }
+
+  /**
+   * <code>bool bool_value = 4 [json_name = "boolValue"];</code>
+   * @return The boolValue.
+   */
+  public boolean getBoolValue() {
+    if (valueCase_ == 4) {
+      return (valueBits_ != 0L);
+    }
+    return false;
+  }
+  /**
+   * <code>bool bool_value = 4 [json_name = "boolValue"];</code>
+   * @param value The boolValue to set.
+   * @return 'This' for chaining.
+   */
+  public Setting setBoolValue(boolean value) {
+    beforeMessageUpdate();
+    valueCase_ = 4;
+    valueBits_ = (value ? 1L : 0L);
+    value_ = null;
+    onChanged(BOOL_VALUE_FIELD_NUMBER);
+    return this;
+  }
+  /**
+   * <code>bool bool_value = 4 [json_name = "boolValue"];</code>
+   * @return 'This' for chaining.
+   */
+  public Setting clearBoolValue() {
+    beforeMessageUpdate();
+    if (valueCase_ == 4) {
+      valueCase_ = 0;
+      value_ = null;
+      onChanged(BOOL_VALUE_FIELD_NUMBER);
+    }
+    return this;
+  }
+
+  /**
+   * <code>string string_value = 5 [json_name = "stringValue"];</code>
+   * @return The stringValue.
+   */
+  public java.lang.String getStringValue() {
+    if (valueCase_ == 5) {
+      return (java.lang.String) value_;
+    }
+    return null;
+  }
+  /**
+   * <code>string string_value = 5 [json_name = "stringValue"];</code>
+   * @param value The stringValue to set.
+   * @return 'This' for chaining.
+   */
+  public Setting setStringValue(
+      java.lang.String value) {
+    beforeMessageUpdate();
+    valueCase_ = 5;
+    value_ = value;
+    onChanged(STRING_VALUE_FIELD_NUMBER);
+    return this;
+  }
+  /**
+   * <code>string string_value = 5 [json_name = "stringValue"];</code>
+   * @return 'This' for chaining.
+   */
+  public Setting clearStringValue() {
+    beforeMessageUpdate();
+    if (valueCase_ == 5) {
+      valueCase_ = 0;
+      value_ = null;
+      onChanged(STRING_VALUE_FIELD_NUMBER);
+    }
+    return this;
+  }
+
+  private byte memoizedIsInitialized = -1;
+  @java.lang.Override
+  public final boolean isInitialized() {
+    byte isInitialized = memoizedIsInitialized;
+    if (isInitialized == 1) return true;
+    if (isInitialized == 0) return false;
+
+    memoizedIsInitialized = 1;
+    return true;
+  }
+
+  @java.lang.Override
+  public void writeTo(com.google.protobuf.CodedOutputStream output)
+                      throws java.io.IOException {
+    if (key_ != null) {
+      com.google.protobuf.GeneratedMessageV3.writeString(output, 1, key_);
+    }
+    if (valueCase_ == 2) {
+      output.writeInt64(2, valueBits_);
+    }
+    if (valueCase_ == 3) {
+      output.writeDouble(3, java.lang.Double.longBitsToDouble(valueBits_));
+    }
+    if (valueCase_ == 4) {
+      output.writeBool(4, (valueBits_ != 0L));
+    }
+    if (valueCase_ == 5) {
+      com.google.protobuf.GeneratedMessageV3.writeString(output, 5, value_);
+    }
+    unknownFields.writeTo(output);
+  }
+
+  @java.lang.Override
+  public int getSerializedSize() {
+    int size = memoizedSize;
+    // LEO: caching is disabled for now, since custom objects are not yet considered
+    // if (size != -1) return size;
+
+    size = 0;
+    if (key_ != null) {
+      size += com.google.protobuf.GeneratedMessageV3.computeStringSize(1, key_);
+    }
+    if (valueCase_ == 2) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeInt64Size(2, valueBits_);
+    }
+    if (valueCase_ == 3) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeDoubleSize(3, java.lang.Double.longBitsToDouble(valueBits_));
+    }
+    if (valueCase_ == 4) {
+      size += com.google.protobuf.CodedOutputStream
+        .computeBoolSize(4, (valueBits_ != 0L));
+    }
+    if (valueCase_ == 5) {
+      size += com.google.protobuf.GeneratedMessageV3.computeStringSize(5, value_);
+    }
+    size += unknownFields.getSerializedSize();
+    memoizedSize = size;
+    return size;
+  }
+
+  @java.lang.Override
+  public boolean equals(final java.lang.Object obj) {
+    if (obj == this) {
+     return true;
+    }
+    if (!(obj instanceof com.example.tutorial.Setting)) {
+      return false;
+    }
+    com.example.tutorial.Setting other = (com.example.tutorial.Setting) obj;
+
+    if (!java.util.Objects.equals(getKey(),
+        other.getKey())) return false;
+    if (!java.util.Objects.equals(getValueCase(), other.getValueCase())) return false;
+    switch (valueCase_) {
+      case 2:
+        if (getLongValue()
+            != other.getLongValue()) return false;
+        break;
+      case 3:
+        if (java.lang.Double.doubleToLongBits(getDoubleValue())
+            != java.lang.Double.doubleToLongBits(
+                other.getDoubleValue())) return false;
+        break;
+      case 4:
+        if (getBoolValue()
+            != other.getBoolValue()) return false;
+        break;
+      case 5:
+        if (!java.util.Objects.equals(getStringValue(),
+            other.getStringValue())) return false;
+        break;
+      case 0:
+      default:
+    }
+    if (!unknownFields.equals(other.unknownFields)) return false;
+    return true;
+  }
+
+  @java.lang.Override
+  public int hashCode() {
+    if (memoizedHashCode != 0) {
+      return memoizedHashCode;
+    }
+    int hash = 41;
+    hash = (19 * hash) + "tutorial.Setting".hashCode();
+    hash = (37 * hash) + KEY_FIELD_NUMBER;
+    hash = (53 * hash) + java.util.Objects.hashCode(getKey());
+    switch (valueCase_) {
+      case 2:
+        hash = (37 * hash) + LONG_VALUE_FIELD_NUMBER;
+        hash = (53 * hash) + com.google.protobuf.Internal.hashLong(
+            getLongValue());
+        break;
+      case 3:
+        hash = (37 * hash) + DOUBLE_VALUE_FIELD_NUMBER;
+        hash = (53 * hash) + com.google.protobuf.Internal.hashLong(
+            java.lang.Double.doubleToLongBits(getDoubleValue()));
+        break;
+      case 4:
+        hash = (37 * hash) + BOOL_VALUE_FIELD_NUMBER;
+        hash = (53 * hash) + com.google.protobuf.Internal.hashBoolean(
+            getBoolValue());
+        break;
+      case 5:
+        hash = (37 * hash) + STRING_VALUE_FIELD_NUMBER;
+        hash = (53 * hash) + java.util.Objects.hashCode(getStringValue());
+        break;
+      case 0:
+      default:
+    }
+    hash = (29 * hash) + unknownFields.hashCode();
+    memoizedHashCode = hash;
+    return hash;
+  }
+
+  public static final long KEY_DIFF_BIT = 1L << 0;
+  public static final long LONG_VALUE_DIFF_BIT = 1L << 1;
+  public static final long DOUBLE_VALUE_DIFF_BIT = 1L << 2;
+  public static final long BOOL_VALUE_DIFF_BIT = 1L << 3;
+  public static final long STRING_VALUE_DIFF_BIT = 1L << 4;
+
+  /**
+   * Returns a mask with the {@code *_DIFF_BIT} of every field that is not
+   * equal in {@code other}.
+   */
+  public long diffMask(com.example.tutorial.Setting other) {
+    long mask = 0L;
+    if (!java.util.Objects.equals(key_, other.key_)) {
+      mask |= KEY_DIFF_BIT;
+    }
+    if ((valueCase_ == 2) != (other.valueCase_ == 2)) {
+      mask |= LONG_VALUE_DIFF_BIT;
+    } else if (valueCase_ == 2) {
+      if (valueBits_ != other.valueBits_) {
+        mask |= LONG_VALUE_DIFF_BIT;
+      }
+    }
+    if ((valueCase_ == 3) != (other.valueCase_ == 3)) {
+      mask |= DOUBLE_VALUE_DIFF_BIT;
+    } else if (valueCase_ == 3) {
+      if (valueBits_ != other.valueBits_) {
+        mask |= DOUBLE_VALUE_DIFF_BIT;
+      }
+    }
+    if ((valueCase_ == 4) != (other.valueCase_ == 4)) {
+      mask |= BOOL_VALUE_DIFF_BIT;
+    } else if (valueCase_ == 4) {
+      if (valueBits_ != other.valueBits_) {
+        mask |= BOOL_VALUE_DIFF_BIT;
+      }
+    }
+    if ((valueCase_ == 5) != (other.valueCase_ == 5)) {
+      mask |= STRING_VALUE_DIFF_BIT;
+    } else if (valueCase_ == 5) {
+      if (!java.util.Objects.equals(value_, other.value_)) {
+        mask |= STRING_VALUE_DIFF_BIT;
+      }
+    }
+    return mask;
+  }
+
+  /**
+   * Returns the paths of all fields that are not equal in {@code other}.
+   * Nested messages are compared recursively, e.g. "phones[0].number".
+   */
+  public java.util.List<java.lang.String> diffPaths(com.example.tutorial.Setting other) {
+    java.util.List<java.lang.String> paths = new java.util.ArrayList<>();
+    diffPaths(other, "", paths);
+    return paths;
+  }
+
+  public void diffPaths(com.example.tutorial.Setting other, java.lang.String prefix,
+      java.util.List<java.lang.String> paths) {
+    long mask = diffMask(other);
+    if (mask == 0L) {
+      return;
+    }
+    if ((mask & KEY_DIFF_BIT) != 0L) {
+      paths.add(prefix + "key");
+    }
+    if ((mask & LONG_VALUE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "long_value");
+    }
+    if ((mask & DOUBLE_VALUE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "double_value");
+    }
+    if ((mask & BOOL_VALUE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "bool_value");
+    }
+    if ((mask & STRING_VALUE_DIFF_BIT) != 0L) {
+      paths.add(prefix + "string_value");
+    }
+  }
+
+  @java.lang.Override
+  public void clear() {
+    beforeMessageUpdate();
+    key_ = null;
+
+    valueCase_ = 0;
+    value_ = null;
+    valueBits_ = 0L;
+  }
+
+  /**
+   * Copies all fields of {@code other} into this message without a
+   * serialization round-trip. Nested messages and repeated fields are
+   * deep-copied, immutable values are shared.
+   */
+  public com.example.tutorial.Setting copyFrom(com.example.tutorial.Setting other) {
+    if (other == this) {
+      return this;
+    }
+    beforeMessageUpdate();
+    key_ = other.key_;
+    switch (other.valueCase_) {
+      case 2:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 3:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 4:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 5:
+        value_ = other.value_;
+        break;
+      default:
+        value_ = null;
+    }
+    valueCase_ = other.valueCase_;
+    this.unknownFields = other.unknownFields;
+    onChanged(0);
+    afterMessageUpdate();
+    return this;
+  }
+
+  public com.example.tutorial.Setting deepCopy() {
+    return new com.example.tutorial.Setting().copyFrom(this);
+  }
+
+  /**
+   * Returns an immutable snapshot of this message. Nested messages that
+   * did not change since the last freeze() are shared with the previous
+   * snapshot. Changes that bypass the setters, e.g. through lists returned
+   * by getters or inside javatype values, are not tracked.
+   */
+  public com.example.tutorial.Setting freeze() {
+    if (isFrozen()) {
+      return this;
+    }
+    com.example.tutorial.Setting previous = (com.example.tutorial.Setting) frozenSnapshot;
+    if (previous != null) {
+      return previous;
+    }
+    com.example.tutorial.Setting snapshot = new com.example.tutorial.Setting();
+    snapshot.freezeFrom(this);
+    snapshot.markFrozen();
+    frozenSnapshot = snapshot;
+    return snapshot;
+  }
+
+  private void freezeFrom(com.example.tutorial.Setting other) {
+    key_ = other.key_;
+    switch (other.valueCase_) {
+      case 2:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 3:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 4:
+        valueBits_ = other.valueBits_;
+        value_ = null;
+        break;
+      case 5:
+        value_ = other.value_;
+        break;
+    }
+    valueCase_ = other.valueCase_;
+    this.unknownFields = other.unknownFields;
+  }
+
+  @java.lang.Override
+  public java.lang.Object getFieldByNumber(int number) {
+    switch (number) {
+      case 1: return getKey();
+      case 2: return getLongValue();
+      case 3: return getDoubleValue();
+      case 4: return getBoolValue();
+      case 5: return getStringValue();
+      default: return super.getFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  @SuppressWarnings("unchecked")
+  public void setFieldByNumber(int number, java.lang.Object value) {
+    switch (number) {
+      case 1:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+            "tutorial.Setting.key");
+        break;
+      case 2:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.Long.class, false,
+            "tutorial.Setting.long_value");
+        break;
+      case 3:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.Double.class, false,
+            "tutorial.Setting.double_value");
+        break;
+      case 4:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.Boolean.class, false,
+            "tutorial.Setting.bool_value");
+        break;
+      case 5:
+        de.leohilbert.proto.FieldValues.check(value, java.lang.String.class, true,
+            "tutorial.Setting.string_value");
+        break;
+      default:
+        super.setFieldByNumber(number, value);
+        return;
+    }
+    beforeMessageUpdate();
+    switch (number) {
+      case 1:
+        setKey((java.lang.String) value);
+        break;
+      case 2:
+        valueBits_ = (java.lang.Long) value;
+        value_ = null;
+        valueCase_ = 2;
+        onChanged(LONG_VALUE_FIELD_NUMBER);
+        break;
+      case 3:
+        valueBits_ = java.lang.Double.doubleToRawLongBits((java.lang.Double) value);
+        value_ = null;
+        valueCase_ = 3;
+        onChanged(DOUBLE_VALUE_FIELD_NUMBER);
+        break;
+      case 4:
+        valueBits_ = ((java.lang.Boolean) value ? 1L : 0L);
+        value_ = null;
+        valueCase_ = 4;
+        onChanged(BOOL_VALUE_FIELD_NUMBER);
+        break;
+      case 5:
+        value_ = (java.lang.String) value;
+        valueCase_ = 5;
+        onChanged(STRING_VALUE_FIELD_NUMBER);
+        break;
+    }
+  }
+
+  @java.lang.Override
+  public long getLongFieldByNumber(int number) {
+    switch (number) {
+      case 2: return getLongValue();
+      default: return super.getLongFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  public void setLongFieldByNumber(int number, long value) {
+    switch (number) {
+      case 2:
+        setLongValue(value);
+        break;
+      default:
+        super.setLongFieldByNumber(number, value);
+    }
+  }
+
+  @java.lang.Override
+  public double getDoubleFieldByNumber(int number) {
+    switch (number) {
+      case 3: return getDoubleValue();
+      default: return super.getDoubleFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  public void setDoubleFieldByNumber(int number, double value) {
+    switch (number) {
+      case 3:
+        setDoubleValue(value);
+        break;
+      default:
+        super.setDoubleFieldByNumber(number, value);
+    }
+  }
+
+  @java.lang.Override
+  public boolean getBooleanFieldByNumber(int number) {
+    switch (number) {
+      case 4: return getBoolValue();
+      default: return super.getBooleanFieldByNumber(number);
+    }
+  }
+
+  @java.lang.Override
+  public void setBooleanFieldByNumber(int number, boolean value) {
+    switch (number) {
+      case 4:
+        setBoolValue(value);
+        break;
+      default:
+        super.setBooleanFieldByNumber(number, value);
+    }
+  }
+
+  @java.lang.Override
+  public java.lang.String toString() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder("Setting: {\n");
+    sb.append("\"key\": \"").append(java.lang.String.valueOf(key_)).append("\",\n");
+    sb.append("\"value\": \"").append(java.lang.String.valueOf(value_)).append("'\n");
+    return sb.append('}').toString();
+  }
+
+  /**
+   * Writes this message as proto3 JSON without reflection. Fields are
+   * written by the same presence rules as the binary format.
+   */
+  public void writeJson(java.lang.Appendable out) throws java.io.IOException {
+    out.append('{');
+    boolean first = true;
+    if (key_ != null) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "key");
+      de.leohilbert.proto.JsonWriter.writeString(out, key_);
+    }
+    if (valueCase_ == 2) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "longValue");
+      de.leohilbert.proto.JsonWriter.writeQuotedLong(out, valueBits_);
+    }
+    if (valueCase_ == 3) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "doubleValue");
+      de.leohilbert.proto.JsonWriter.writeDouble(out, java.lang.Double.longBitsToDouble(valueBits_));
+    }
+    if (valueCase_ == 4) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "boolValue");
+      de.leohilbert.proto.JsonWriter.writeBool(out, (valueBits_ != 0L));
+    }
+    if (valueCase_ == 5) {
+      first = de.leohilbert.proto.JsonWriter.name(out, first, "stringValue");
+      de.leohilbert.proto.JsonWriter.writeString(out, (java.lang.String) value_);
+    }
+    out.append('}');
+  }
+
+  public java.lang.String toJson() {
+    java.lang.StringBuilder sb = new java.lang.StringBuilder();
+    try {
+      writeJson(sb);
+    } catch (java.io.IOException e) {
+      throw new java.lang.RuntimeException(
+          "Writing to a StringBuilder threw an IOException (should never happen).", e);
+    }
+    return sb.toString();
+  }
+
+  /**
+   * Reads proto3 JSON into this message. Like updateFrom, all fields not
+   * contained in the JSON are reset to their defaults.
+   */
+  public void updateFromJson(java.io.Reader reader) throws java.io.IOException {
+    updateFromJson(new de.leohilbert.proto.JsonReader(reader));
+  }
+
+  public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {
+    beforeMessageUpdate();
+    clear();
+    in.beginObject();
+    while (in.hasNextMember()) {
+      switch (in.nextName()) {
+        case "key":
+          if (!in.nextNull()) {
+
+            key_ = in.readString();
+          }
+          break;
+        case "longValue":
+        case "long_value":
+          if (!in.nextNull()) {
+            valueBits_ = in.readLong();
+            value_ = null;
+            valueCase_ = 2;
+          }
+          break;
+        case "doubleValue":
+        case "double_value":
+          if (!in.nextNull()) {
+            valueBits_ = java.lang.Double.doubleToRawLongBits(in.readDouble());
+            value_ = null;
+            valueCase_ = 3;
+          }
+          break;
+        case "boolValue":
+        case "bool_value":
+          if (!in.nextNull()) {
+            valueBits_ = (in.readBool() ? 1L : 0L);
+            value_ = null;
+            valueCase_ = 4;
+          }
+          break;
+        case "stringValue":
+        case "string_value":
+          if (!in.nextNull()) {
+            value_ = in.readString();
+            valueCase_ = 5;
+          }
+          break;
+        default:
+          in.skipValue();
+      }
+    }
+    onChanged(0);
+    afterMessageUpdate();
+  }
+
+  public static com.example.tutorial.Setting parseFrom(
+      java.nio.ByteBuffer data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      java.nio.ByteBuffer data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      com.google.protobuf.ByteString data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      com.google.protobuf.ByteString data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Setting parseFrom(byte[] data)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      byte[] data,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws com.google.protobuf.InvalidProtocolBufferException {
+    return PARSER.parseFrom(data, extensionRegistry);
+  }
+  public static com.example.tutorial.Setting parseFrom(java.io.InputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      java.io.InputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input, extensionRegistry);
+  }
+  public static com.example.tutorial.Setting parseDelimitedFrom(java.io.InputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseDelimitedWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Setting parseDelimitedFrom(
+      java.io.InputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseDelimitedWithIOException(PARSER, input, extensionRegistry);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      com.google.protobuf.CodedInputStream input)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input);
+  }
+  public static com.example.tutorial.Setting parseFrom(
+      com.google.protobuf.CodedInputStream input,
+      com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+      throws java.io.IOException {
+    return com.google.protobuf.GeneratedMessageV3
+        .parseWithIOException(PARSER, input, extensionRegistry);
+  }
+
+
+  // @@protoc_insertion_point(class_scope:tutorial.Setting)
+  private static final com.example.tutorial.Setting DEFAULT_INSTANCE;
+  static {
+    DEFAULT_INSTANCE = new com.example.tutorial.Setting();
+  }
+
+  public static com.example.tutorial.Setting getDefaultInstance() {
+    return DEFAULT_INSTANCE;
+  }
+
+  private static final com.google.protobuf.Parser<Setting>
+      PARSER = new com.google.protobuf.AbstractParser<Setting>() {
+    @java.lang.Override
+    public Setting parsePartialFrom(
+        com.google.protobuf.CodedInputStream input,
+        com.google.protobuf.ExtensionRegistryLite extensionRegistry)
+        throws com.google.protobuf.InvalidProtocolBufferException {
+      return new Setting(input, extensionRegistry);
+    }
+  };
+
+  public static com.google.protobuf.Parser<Setting> parser() {
+    return PARSER;
+  }
+
+  @java.lang.Override
+  public com.google.protobuf.Parser<Setting> getParserForType() {
+    return PARSER;
+  }
+
+  @java.lang.Override
+  public com.example.tutorial.Setting getDefaultInstanceForType() {
+    return DEFAULT_INSTANCE;
+  }
+
+}
+
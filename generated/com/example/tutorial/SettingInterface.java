@@ -0,0 +1,71 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: addressbook.proto
+
+package com.example.tutorial;
+
+public interface SettingInterface<SELF> extends
+    // @@protoc_insertion_point(interface_extends:tutorial.Setting)
+    com.google.protobuf.MessageOrBuilder {
+  public static final int KEY_FIELD_NUMBER = 1;
+
+  /**
+   * <code>string key = 1 [json_name = "key"];</code>
+   * @return The key.
+   */
+  java.lang.String getKey();
+  /**
+   * <code>string key = 1 [json_name = "key"];</code>
+   * @param value The key to set.
+   */
+  SELF setKey(java.lang.String value);
+  public static final int LONG_VALUE_FIELD_NUMBER = 2;
+
+  /**
+   * <code>int64 long_value = 2 [json_name = "longValue"];</code>
+   * @return The longValue.
+   */
+  long getLongValue();
+  /**
+   * <code>int64 long_value = 2 [json_name = "longValue"];</code>
+   * @param value The longValue to set.
+   */
+  SELF setLongValue(long value);
+  public static final int DOUBLE_VALUE_FIELD_NUMBER = 3;
+
+  /**
+   * <code>double double_value = 3 [json_name = "doubleValue"];</code>
+   * @return The doubleValue.
+   */
+  double getDoubleValue();
+  /**
+   * <code>double double_value = 3 [json_name = "doubleValue"];</code>
+   * @param value The doubleValue to set.
+   */
+  SELF setDoubleValue(double value);
+  public static final int BOOL_VALUE_FIELD_NUMBER = 4;
+
+  /**
+   * <code>bool bool_value = 4 [json_name = "boolValue"];</code>
+   * @return The boolValue.
+   */
+  boolean getBoolValue();
+  /**
+   * <code>bool bool_value = 4 [json_name = "boolValue"];</code>
+   * @param value The boolValue to set.
+   */
+  SELF setBoolValue(boolean value);
+  public static final int STRING_VALUE_FIELD_NUMBER = 5;
+
+  /**
+   * <code>string string_value = 5 [json_name = "stringValue"];</code>
+   * @return The stringValue.
+   */
+  java.lang.String getStringValue();
+  /**
+   * <code>string string_value = 5 [json_name = "stringValue"];</code>
+   * @param value The stringValue to set.
+   */
+  SELF setStringValue(java.lang.String value);
+
+  public com.example.tutorial.Setting.ValueCase getValueCase();
+}
@@ -0,0 +1,228 @@
+package com.google.protobuf;
+
+import com.google.protobuf.Internal.BooleanList;
+import com.google.protobuf.Internal.DoubleList;
+import com.google.protobuf.Internal.FloatList;
+import com.google.protobuf.Internal.IntList;
+import com.google.protobuf.Internal.LongList;
+import java.io.IOException;
+import java.io.InputStream;
+
+/**
+ * Base class of messages generated with the {@code lean} file-option.
+ *
+ * <p>Unlike {@link GeneratedMessageV3} it knows nothing about descriptors, FieldAccessorTables or
+ * reflection. It only provides what the generated leo methods ({@code updateFrom}, {@code writeTo},
+ * {@code equals}, {@code freeze}, ...) need, so loading a lean message class loads little more than
+ * the class itself.
+ */
+@SuppressWarnings("rawtypes")
+public abstract class GeneratedMessageLean extends AbstractMessageLite implements LeoMessage {
+
+  /** For use by generated code only.  */
+  protected UnknownFieldSet unknownFields = UnknownFieldSet.getDefaultInstance();
+
+  protected int memoizedSize = -1;
+
+  public UnknownFieldSet getUnknownFields() {
+    return unknownFields;
+  }
+
+  /**
+   * Called by subclasses to parse an unknown field.
+   *
+   * @return {@code true} unless the tag is an end-group tag.
+   */
+  protected boolean parseUnknownField(
+      CodedInputStream input,
+      UnknownFieldSet.Builder unknownFields,
+      ExtensionRegistryLite extensionRegistry,
+      int tag)
+      throws IOException {
+    if (input.shouldDiscardUnknownFields()) {
+      return input.skipField(tag);
+    }
+    return unknownFields.mergeFieldFrom(tag, input);
+  }
+
+  /**
+   * Used by parsing constructors in generated classes. Lean messages have no extensions.
+   */
+  protected void makeExtensionsImmutable() {
+  }
+
+  protected static <M extends MessageLite> M parseWithIOException(Parser<M> parser,
+      InputStream input) throws IOException {
+    try {
+      return parser.parseFrom(input);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static <M extends MessageLite> M parseWithIOException(Parser<M> parser,
+      InputStream input, ExtensionRegistryLite extensions) throws IOException {
+    try {
+      return parser.parseFrom(input, extensions);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static <M extends MessageLite> M parseWithIOException(Parser<M> parser,
+      CodedInputStream input) throws IOException {
+    try {
+      return parser.parseFrom(input);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static <M extends MessageLite> M parseWithIOException(Parser<M> parser,
+      CodedInputStream input, ExtensionRegistryLite extensions) throws IOException {
+    try {
+      return parser.parseFrom(input, extensions);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static <M extends MessageLite> M parseDelimitedWithIOException(Parser<M> parser,
+      InputStream input) throws IOException {
+    try {
+      return parser.parseDelimitedFrom(input);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static <M extends MessageLite> M parseDelimitedWithIOException(Parser<M> parser,
+      InputStream input, ExtensionRegistryLite extensions) throws IOException {
+    try {
+      return parser.parseDelimitedFrom(input, extensions);
+    } catch (InvalidProtocolBufferException e) {
+      throw e.unwrapIOException();
+    }
+  }
+
+  protected static IntList emptyIntList() {
+    return IntArrayList.emptyList();
+  }
+
+  protected static LongList emptyLongList() {
+    return LongArrayList.emptyList();
+  }
+
+  protected static FloatList emptyFloatList() {
+    return FloatArrayList.emptyList();
+  }
+
+  protected static DoubleList emptyDoubleList() {
+    return DoubleArrayList.emptyList();
+  }
+
+  protected static BooleanList emptyBooleanList() {
+    return BooleanArrayList.emptyList();
+  }
+
+  protected static IntList newIntList() {
+    return new IntArrayList();
+  }
+
+  protected static LongList newLongList() {
+    return new LongArrayList();
+  }
+
+  protected static FloatList newFloatList() {
+    return new FloatArrayList();
+  }
+
+  protected static DoubleList newDoubleList() {
+    return new DoubleArrayList();
+  }
+
+  protected static BooleanList newBooleanList() {
+    return new BooleanArrayList();
+  }
+
+  protected static int computeStringSize(final int fieldNumber, final Object value) {
+    if (value instanceof String) {
+      return CodedOutputStream.computeStringSize(fieldNumber, (String) value);
+    } else {
+      return CodedOutputStream.computeBytesSize(fieldNumber, (ByteString) value);
+    }
+  }
+
+  protected static int computeStringSizeNoTag(final Object value) {
+    if (value instanceof String) {
+      return CodedOutputStream.computeStringSizeNoTag((String) value);
+    } else {
+      return CodedOutputStream.computeBytesSizeNoTag((ByteString) value);
+    }
+  }
+
+  protected static void writeString(
+      CodedOutputStream output, final int fieldNumber, final Object value) throws IOException {
+    if (value instanceof String) {
+      output.writeString(fieldNumber, (String) value);
+    } else {
+      output.writeBytes(fieldNumber, (ByteString) value);
+    }
+  }
+
+  protected static void writeStringNoTag(
+      CodedOutputStream output, final Object value) throws IOException {
+    if (value instanceof String) {
+      output.writeStringNoTag((String) value);
+    } else {
+      output.writeBytesNoTag((ByteString) value);
+    }
+  }
+
+  @Override
+  int getMemoizedSerializedSize() {
+    return memoizedSize;
+  }
+
+  @Override
+  void setMemoizedSerializedSize(int size) {
+    memoizedSize = size;
+  }
+
+  // LEOS STUFF, the logic shared with GeneratedMessageV3 is in LeoMessage and LeoMessageState
+  public transient Runnable updateReceiver = null;
+
+  // the snapshot returned by the last freeze(), dropped on every change
+  protected transient GeneratedMessageLean frozenSnapshot = null;
+  private transient boolean frozen = false;
+
+  @Override
+  public void onChanged(int fieldNumber) {
+    beforeMessageUpdate();
+    LeoMessageState.changed(this, updateReceiver);
+  }
+
+  @Override
+  public MessageLite.Builder toBuilder() {
+    throw new UnsupportedOperationException("builders are not implemented");
+  }
+
+  @Override
+  public MessageLite.Builder newBuilderForType() {
+    throw new UnsupportedOperationException("builders are not implemented");
+  }
+
+  @Override
+  public boolean isFrozen() {
+    return frozen;
+  }
+
+  protected final void markFrozen() {
+    frozen = true;
+  }
+
+  protected final void beforeMessageUpdate() {
+    LeoMessageState.checkNotFrozen(frozen);
+    frozenSnapshot = null;
+  }
+}
@@ -76,7 +76,7 @@ import java.util.TreeMap;
  * @author kenton@google.com Kenton Varda
  */
 public abstract class GeneratedMessageV3 extends AbstractMessage
-    implements Serializable {
+    implements Serializable, LeoMessage {
   private static final long serialVersionUID = 1L;
 
   /**
@@ -3152,15 +3152,17 @@ public abstract class GeneratedMessageV3 extends AbstractMessage
     }
   }
 
-  // LEOS STUFF
+  // LEOS STUFF, the logic shared with GeneratedMessageLean is in LeoMessage and LeoMessageState
   public transient Runnable updateReceiver = null;
 
+  // the snapshot returned by the last freeze(), dropped on every change
+  protected transient GeneratedMessageV3 frozenSnapshot = null;
+  private transient boolean frozen = false;
+
+  @Override
   public void onChanged(int fieldNumber) {
-      memoizedSize = -1;
-      memoizedHashCode = -1;
-      if (updateReceiver != null) {
-          updateReceiver.run();
-      }
+      beforeMessageUpdate();
+      LeoMessageState.changed(this, updateReceiver);
   }
 
   @Override
@@ -3173,12 +3175,18 @@ public abstract class GeneratedMessageV3 extends AbstractMessage
         throw new UnsupportedOperationException("builders are not implemented");
     }
 
-  public void afterMessageInit() {
+  @Override
+  public boolean isFrozen() {
+      return frozen;
   }
 
-  public void afterMessageUpdate() {
+  protected final void markFrozen() {
+      frozen = true;
   }
 
-  public abstract void clear();
+  protected final void beforeMessageUpdate() {
+      LeoMessageState.checkNotFrozen(frozen);
+      frozenSnapshot = null;
+  }
 }
 
@@ -0,0 +1,95 @@
+package com.google.protobuf;
+
+/**
+ * The leo hooks of generated messages, implemented by both {@link GeneratedMessageV3} and
+ * {@link GeneratedMessageLean}.
+ *
+ * <p>The {@code *FieldByNumber} defaults reject every number, generated messages override them with
+ * a switch over their fields.
+ */
+public interface LeoMessage {
+
+  /**
+   * Resets all fields to their defaults.
+   */
+  void clear();
+
+  /**
+   * Called after a setter changed a field, runs the {@code updateReceiver} of the message. copyFrom
+   * and updateFromJson pass 0 since they replace all fields.
+   */
+  void onChanged(int fieldNumber);
+
+  /**
+   * Returns true if this message is a snapshot created by {@code freeze()}.
+   */
+  boolean isFrozen();
+
+  default void afterMessageInit() {
+  }
+
+  default void afterMessageUpdate() {
+  }
+
+  /**
+   * Returns the value of a field like its getter does, e.g. a List for repeated fields. Unlike
+   * {@link Message#getField} this is a generated switch and doesn't need the FieldAccessorTable.
+   */
+  default Object getFieldByNumber(int number) {
+    throw unknownField(number, "");
+  }
+
+  /**
+   * Replaces the value of a field, taking the type {@link #getFieldByNumber} returns. Unknown
+   * numbers and values of the wrong type throw an {@link IllegalArgumentException} before anything
+   * is written.
+   */
+  default void setFieldByNumber(int number, Object value) {
+    throw unknownField(number, "");
+  }
+
+  default int getIntFieldByNumber(int number) {
+    throw unknownField(number, "int ");
+  }
+
+  default void setIntFieldByNumber(int number, int value) {
+    throw unknownField(number, "int ");
+  }
+
+  default long getLongFieldByNumber(int number) {
+    throw unknownField(number, "long ");
+  }
+
+  default void setLongFieldByNumber(int number, long value) {
+    throw unknownField(number, "long ");
+  }
+
+  default float getFloatFieldByNumber(int number) {
+    throw unknownField(number, "float ");
+  }
+
+  default void setFloatFieldByNumber(int number, float value) {
+    throw unknownField(number, "float ");
+  }
+
+  default double getDoubleFieldByNumber(int number) {
+    throw unknownField(number, "double ");
+  }
+
+  default void setDoubleFieldByNumber(int number, double value) {
+    throw unknownField(number, "double ");
+  }
+
+  default boolean getBooleanFieldByNumber(int number) {
+    throw unknownField(number, "boolean ");
+  }
+
+  default void setBooleanFieldByNumber(int number, boolean value) {
+    throw unknownField(number, "boolean ");
+  }
+
+  private IllegalArgumentException unknownField(int number, String type) {
+    return new IllegalArgumentException(
+        getClass().getName() + " has no " + type + "field with number " + number);
+  }
+}
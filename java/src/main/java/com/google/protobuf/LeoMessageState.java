@@ -0,0 +1,26 @@
+package com.google.protobuf;
+
+/**
+ * The stateful part of the {@link LeoMessage} hooks. {@link GeneratedMessageV3} and
+ * {@link GeneratedMessageLean} keep the state in their own fields, since they share no base class
+ * below {@link AbstractMessageLite}, and delegate here.
+ */
+final class LeoMessageState {
+  private LeoMessageState() {
+  }
+
+  static void checkNotFrozen(boolean frozen) {
+    if (frozen) {
+      throw new UnsupportedOperationException("frozen messages can not be modified");
+    }
+  }
+
+  static void changed(AbstractMessageLite<?, ?> message, Runnable updateReceiver) {
+    message.setMemoizedSerializedSize(-1);
+    // 0 is the "not computed" marker of the generated hashCode()
+    message.memoizedHashCode = 0;
+    if (updateReceiver != null) {
+      updateReceiver.run();
+    }
+  }
+}
@@ -0,0 +1,76 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.CodedOutputStream;
+
+import java.io.IOException;
+import java.time.Duration;
+
+/**
+ * Built-in codec for google.protobuf.Duration fields with {@code javatype = "java.time.Duration"}. Reads and writes
+ * the seconds and nanos directly, without a Duration message in between.
+ * <p>
+ * java.time.Duration always has positive nanos while the proto requires nanos with the same sign as the seconds,
+ * so negative durations are converted on the way out.
+ */
+public final class DurationCodec {
+    private static final int NANOS_PER_SECOND = 1_000_000_000;
+
+    private DurationCodec() {
+    }
+
+    public static Duration fromProto(final com.google.protobuf.Duration value) {
+        return Duration.ofSeconds(value.getSeconds(), value.getNanos());
+    }
+
+    public static com.google.protobuf.Duration toProto(final Duration value) {
+        return new com.google.protobuf.Duration().setSeconds(seconds(value)).setNanos(nanos(value));
+    }
+
+    public static Duration copy(final Duration value) {
+        return value;
+    }
+
+    public static Duration read(final CodedInputStream input) throws IOException {
+        final int oldLimit = input.pushLimit(input.readRawVarint32());
+        long seconds = 0;
+        int nanos = 0;
+        int tag;
+        while ((tag = input.readTag()) != 0) {
+            if (tag == SecondsAndNanos.SECONDS_TAG) {
+                seconds = input.readInt64();
+            } else if (tag == SecondsAndNanos.NANOS_TAG) {
+                nanos = input.readInt32();
+            } else if (!input.skipField(tag)) {
+                break;
+            }
+        }
+        input.checkLastTagWas(0);
+        input.popLimit(oldLimit);
+        try {
+            return Duration.ofSeconds(seconds, nanos);
+        } catch (final ArithmeticException e) {
+            throw SecondsAndNanos.outOfRange("Duration", e);
+        }
+    }
+
+    public static void write(final CodedOutputStream output, final int fieldNumber, final Duration value)
+            throws IOException {
+        SecondsAndNanos.write(output, fieldNumber, seconds(value), nanos(value));
+    }
+
+    /**
+     * Size of the length-delimited value without its tag.
+     */
+    public static int size(final Duration value) {
+        return SecondsAndNanos.size(seconds(value), nanos(value));
+    }
+
+    private static long seconds(final Duration value) {
+        return value.isNegative() && value.getNano() != 0 ? value.getSeconds() + 1 : value.getSeconds();
+    }
+
+    private static int nanos(final Duration value) {
+        return value.isNegative() && value.getNano() != 0 ? value.getNano() - NANOS_PER_SECOND : value.getNano();
+    }
+}
@@ -0,0 +1,20 @@
+package de.leohilbert.proto;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+
+/**
+ * Looks up the VarHandles used by messages generated with {@code field_memory = "release_acquire"}.
+ */
+public final class FieldHandles {
+    private FieldHandles() {
+    }
+
+    public static VarHandle find(final MethodHandles.Lookup lookup, final String fieldName, final Class<?> type) {
+        try {
+            return lookup.findVarHandle(lookup.lookupClass(), fieldName, type);
+        } catch (final ReflectiveOperationException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+package de.leohilbert.proto;
+
+/**
+ * A selection of fields of one message type, read by the {@code updateFrom(input, mask)},
+ * {@code writeTo(output, mask)} and {@code getSerializedSize(mask)} methods that messages with the {@code field_masks}
+ * option generate.
+ * <p>
+ * Masks are built by the generated {@code compileMask(paths)} of the message type and reused for every message after
+ * that. A field is addressed by its index in the message declaration, the same index its {@code *_DIFF_BIT} is taken
+ * from. A message field is either selected as a whole or through a nested mask for the fields of its type, selecting
+ * it as a whole wins.
+ */
+public final class FieldMask {
+    private final long[] words;
+    // set for the fields selected through a nested mask only
+    private final FieldMask[] nested;
+
+    /**
+     * @param fieldCount the number of fields of the message type
+     */
+    public FieldMask(final int fieldCount) {
+        this.words = new long[(fieldCount + 63) >>> 6];
+        this.nested = new FieldMask[fieldCount];
+    }
+
+    public boolean contains(final int field) {
+        return (words[field >>> 6] & (1L << field)) != 0;
+    }
+
+    /**
+     * The mask for the fields of a selected message field, null if the field is selected as a whole.
+     */
+    public FieldMask nested(final int field) {
+        return nested[field];
+    }
+
+    /**
+     * Selects a field as a whole.
+     */
+    public void add(final int field) {
+        words[field >>> 6] |= 1L << field;
+        nested[field] = null;
+    }
+
+    /**
+     * Selects fields of a message field.
+     *
+     * @param fieldCount the number of fields of the type of the field
+     * @return the mask to add the nested paths to, which is not used if the field is already selected as a whole
+     */
+    public FieldMask addNested(final int field, final int fieldCount) {
+        if (contains(field) && nested[field] == null) {
+            return new FieldMask(fieldCount);
+        }
+        if (nested[field] == null) {
+            words[field >>> 6] |= 1L << field;
+            nested[field] = new FieldMask(fieldCount);
+        }
+        return nested[field];
+    }
+}
@@ -0,0 +1,65 @@
+package de.leohilbert.proto;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Checks of the values passed to the generated {@code setFieldByNumber(number, value)}, which runs them for the field
+ * before anything is written.
+ */
+public final class FieldValues {
+    private FieldValues() {
+    }
+
+    /**
+     * Throws an {@link IllegalArgumentException} if {@code value} is not an instance of {@code type}. Null is only
+     * accepted if {@code nullable}, i.e. if the setter of the field accepts it as well.
+     */
+    public static void check(final Object value, final Class<?> type, final boolean nullable, final String field) {
+        if (value == null ? !nullable : !type.isInstance(value)) {
+            throw invalid(field, type.getName(), value);
+        }
+    }
+
+    /**
+     * Returns a copy of {@code value} if it is a list of instances of {@code elementType}. The field is cleared before
+     * the copy is added, which keeps the elements if {@code value} is the list of the field itself.
+     */
+    public static List<?> checkList(final Object value, final Class<?> elementType, final String field) {
+        if (!(value instanceof List)) {
+            throw invalid(field, "java.util.List", value);
+        }
+        final List<?> list = (List<?>) value;
+        for (final Object element : list) {
+            if (!elementType.isInstance(element)) {
+                throw invalid(field, "java.util.List of " + elementType.getName(), element);
+            }
+        }
+        return new ArrayList<>(list);
+    }
+
+    /**
+     * Throws an {@link IllegalArgumentException} if {@code value} is not a map from {@code keyType} to
+     * {@code valueType}.
+     */
+    public static void checkMap(final Object value, final Class<?> keyType, final Class<?> valueType,
+                                final String field) {
+        if (!(value instanceof Map)) {
+            throw invalid(field, "java.util.Map", value);
+        }
+        for (final Map.Entry<?, ?> entry : ((Map<?, ?>) value).entrySet()) {
+            if (!keyType.isInstance(entry.getKey())) {
+                throw invalid(field, "java.util.Map with keys of " + keyType.getName(), entry.getKey());
+            }
+            if (!valueType.isInstance(entry.getValue())) {
+                throw invalid(field, "java.util.Map with values of " + valueType.getName(), entry.getValue());
+            }
+        }
+    }
+
+    private static IllegalArgumentException invalid(final String field, final String expected, final Object value) {
+        return new IllegalArgumentException(field + " takes a " + expected + ", not "
+                + (value == null ? "null" : value.getClass().getName()));
+    }
+}
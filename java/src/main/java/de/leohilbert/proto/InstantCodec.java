@@ -0,0 +1,65 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.Timestamp;
+
+import java.io.IOException;
+import java.time.DateTimeException;
+import java.time.Instant;
+
+/**
+ * Built-in codec for google.protobuf.Timestamp fields with {@code javatype = "java.time.Instant"}. Reads and writes
+ * the seconds and nanos directly, without a Timestamp message in between.
+ */
+public final class InstantCodec {
+    private InstantCodec() {
+    }
+
+    public static Instant fromProto(final Timestamp value) {
+        return Instant.ofEpochSecond(value.getSeconds(), value.getNanos());
+    }
+
+    public static Timestamp toProto(final Instant value) {
+        return new Timestamp().setSeconds(value.getEpochSecond()).setNanos(value.getNano());
+    }
+
+    public static Instant copy(final Instant value) {
+        return value;
+    }
+
+    public static Instant read(final CodedInputStream input) throws IOException {
+        final int oldLimit = input.pushLimit(input.readRawVarint32());
+        long seconds = 0;
+        int nanos = 0;
+        int tag;
+        while ((tag = input.readTag()) != 0) {
+            if (tag == SecondsAndNanos.SECONDS_TAG) {
+                seconds = input.readInt64();
+            } else if (tag == SecondsAndNanos.NANOS_TAG) {
+                nanos = input.readInt32();
+            } else if (!input.skipField(tag)) {
+                break;
+            }
+        }
+        input.checkLastTagWas(0);
+        input.popLimit(oldLimit);
+        try {
+            return Instant.ofEpochSecond(seconds, nanos);
+        } catch (final DateTimeException | ArithmeticException e) {
+            throw SecondsAndNanos.outOfRange("Timestamp", e);
+        }
+    }
+
+    public static void write(final CodedOutputStream output, final int fieldNumber, final Instant value)
+            throws IOException {
+        SecondsAndNanos.write(output, fieldNumber, value.getEpochSecond(), value.getNano());
+    }
+
+    /**
+     * Size of the length-delimited value without its tag.
+     */
+    public static int size(final Instant value) {
+        return SecondsAndNanos.size(value.getEpochSecond(), value.getNano());
+    }
+}
@@ -0,0 +1,619 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.ByteString;
+import com.google.protobuf.InvalidProtocolBufferException;
+import com.google.protobuf.LazyStringArrayList;
+import com.google.protobuf.ProtocolMessageEnum;
+import com.google.protobuf.UnsafeByteOperations;
+
+import java.io.IOException;
+import java.io.Reader;
+import java.math.BigDecimal;
+import java.math.BigInteger;
+import java.util.Arrays;
+import java.util.Base64;
+import java.util.function.Function;
+
+/**
+ * Streaming tokenizer for the generated {@code updateFromJson} methods. Reads proto3 JSON through a small buffer,
+ * the generated code decides which value to read next, so no intermediate tree is built.
+ */
+public final class JsonReader {
+    private final Reader reader;
+    private final char[] buffer = new char[4096];
+    private int pos;
+    private int limit;
+    // set after a value was read, the next member or element then needs a ','
+    private boolean afterValue;
+    private char[] token = new char[32];
+    private final StringBuilder string = new StringBuilder();
+    private int nanos;
+
+    public JsonReader(final Reader reader) {
+        this.reader = reader;
+    }
+
+    /**
+     * Returns the next non-whitespace character without consuming it, or -1 at the end of the input.
+     */
+    public int peek() throws IOException {
+        while (pos < limit || fill()) {
+            final char c = buffer[pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return c;
+            }
+            pos++;
+        }
+        return -1;
+    }
+
+    public void beginObject() throws IOException {
+        expect('{');
+        afterValue = false;
+    }
+
+    public void beginArray() throws IOException {
+        expect('[');
+        afterValue = false;
+    }
+
+    /**
+     * Returns whether the current object has another member. Consumes the ',' before it or the closing '}'.
+     */
+    public boolean hasNextMember() throws IOException {
+        return hasNext('}');
+    }
+
+    /**
+     * Returns whether the current array has another element. Consumes the ',' before it or the closing ']'.
+     */
+    public boolean hasNextElement() throws IOException {
+        return hasNext(']');
+    }
+
+    private boolean hasNext(final char close) throws IOException {
+        if (peek() == close) {
+            pos++;
+            afterValue = true;
+            return false;
+        }
+        if (afterValue) {
+            expect(',');
+            afterValue = false;
+        }
+        return true;
+    }
+
+    /**
+     * Reads the name of the next member, including the ':' after it.
+     */
+    public String nextName() throws IOException {
+        final String name = readString();
+        expect(':');
+        afterValue = false;
+        return name;
+    }
+
+    /**
+     * Consumes a null and returns true, or returns false if the next value is something else.
+     */
+    public boolean nextNull() throws IOException {
+        if (peek() != 'n') {
+            return false;
+        }
+        literal("null");
+        return true;
+    }
+
+    public String readString() throws IOException {
+        expect('"');
+        // fast path: the whole string is in the buffer and has no escapes
+        for (int i = pos; i < limit; i++) {
+            final char c = buffer[i];
+            if (c == '"') {
+                final String value = new String(buffer, pos, i - pos);
+                pos = i + 1;
+                afterValue = true;
+                return value;
+            }
+            if (c == '\\') {
+                break;
+            }
+        }
+        string.setLength(0);
+        while (true) {
+            final int start = pos;
+            while (pos < limit && buffer[pos] != '"' && buffer[pos] != '\\') {
+                pos++;
+            }
+            string.append(buffer, start, pos - start);
+            if (pos == limit) {
+                if (!fill()) {
+                    throw error("Unterminated string");
+                }
+                continue;
+            }
+            if (buffer[pos++] == '"') {
+                break;
+            }
+            final char escaped = next();
+            switch (escaped) {
+                case '"':
+                case '\\':
+                case '/':
+                    string.append(escaped);
+                    break;
+                case 'b':
+                    string.append('\b');
+                    break;
+                case 'f':
+                    string.append('\f');
+                    break;
+                case 'n':
+                    string.append('\n');
+                    break;
+                case 'r':
+                    string.append('\r');
+                    break;
+                case 't':
+                    string.append('\t');
+                    break;
+                case 'u':
+                    int c = 0;
+                    for (int i = 0; i < 4; i++) {
+                        final int digit = Character.digit(next(), 16);
+                        if (digit < 0) {
+                            throw error("Invalid unicode escape");
+                        }
+                        c = c << 4 | digit;
+                    }
+                    string.append((char) c);
+                    break;
+                default:
+                    throw error("Invalid escape \\" + escaped);
+            }
+        }
+        afterValue = true;
+        return string.toString();
+    }
+
+    public boolean readBool() throws IOException {
+        final int c = peek();
+        if (c == 't') {
+            literal("true");
+            return true;
+        }
+        if (c == 'f') {
+            literal("false");
+            return false;
+        }
+        throw error("Expected a boolean but found " + describe(c));
+    }
+
+    /**
+     * Reads an int32. Like all numbers it may also be quoted or written as e.g. 1e3.
+     */
+    public int readInt() throws IOException {
+        return toInt(readLong());
+    }
+
+    public int readUnsignedInt() throws IOException {
+        return toUnsignedInt(readLong());
+    }
+
+    public long readLong() throws IOException {
+        return parseLong(readToken(), false);
+    }
+
+    public long readUnsignedLong() throws IOException {
+        return parseLong(readToken(), true);
+    }
+
+    public float readFloat() throws IOException {
+        final double value = readDouble();
+        if (Math.abs(value) > Float.MAX_VALUE && !Double.isInfinite(value)) {
+            throw error("Out of range for float: " + value);
+        }
+        return (float) value;
+    }
+
+    /**
+     * Reads a double, "NaN", "Infinity" and "-Infinity" are accepted as strings.
+     */
+    public double readDouble() throws IOException {
+        // readToken() may replace the buffer, so it has to run before token is read
+        final int length = readToken();
+        final String text = new String(token, 0, length);
+        try {
+            return Double.parseDouble(text);
+        } catch (NumberFormatException e) {
+            throw error("Invalid number: " + text);
+        }
+    }
+
+    /**
+     * Reads standard or URL-safe base64, with or without padding.
+     */
+    public ByteString readBytes() throws IOException {
+        final String text = readString();
+        try {
+            final boolean urlSafe = text.indexOf('-') >= 0 || text.indexOf('_') >= 0;
+            return UnsafeByteOperations.unsafeWrap(
+                    (urlSafe ? Base64.getUrlDecoder() : Base64.getDecoder()).decode(text));
+        } catch (IllegalArgumentException e) {
+            throw error("Invalid base64: " + text);
+        }
+    }
+
+    /**
+     * Reads an enum given by name or number and returns its number.
+     */
+    public int readEnum(final Function<String, ? extends ProtocolMessageEnum> forName) throws IOException {
+        if (peek() != '"') {
+            return readInt();
+        }
+        final String name = readString();
+        final ProtocolMessageEnum value = forName.apply(name);
+        if (value == null) {
+            throw error("Invalid enum value: " + name);
+        }
+        return value.getNumber();
+    }
+
+    /**
+     * Skips the next value, e.g. the value of an unknown member.
+     */
+    public void skipValue() throws IOException {
+        int depth = 0;
+        do {
+            final int c = peek();
+            switch (c) {
+                case '{':
+                case '[':
+                    pos++;
+                    depth++;
+                    afterValue = false;
+                    break;
+                case '}':
+                case ']':
+                case ',':
+                case ':':
+                    if (depth == 0) {
+                        throw error("Expected a value but found " + describe(c));
+                    }
+                    pos++;
+                    if (c == '}' || c == ']') {
+                        depth--;
+                    }
+                    break;
+                case '"':
+                    readString();
+                    break;
+                case 't':
+                case 'f':
+                    readBool();
+                    break;
+                case 'n':
+                    nextNull();
+                    break;
+                default:
+                    readToken();
+            }
+        } while (depth > 0);
+        afterValue = true;
+    }
+
+    // map keys are always strings in JSON
+
+    public int intKey(final String key) throws IOException {
+        return toInt(parseLong(load(key), false));
+    }
+
+    public int unsignedIntKey(final String key) throws IOException {
+        return toUnsignedInt(parseLong(load(key), false));
+    }
+
+    public long longKey(final String key) throws IOException {
+        return parseLong(load(key), false);
+    }
+
+    public long unsignedLongKey(final String key) throws IOException {
+        return parseLong(load(key), true);
+    }
+
+    public boolean boolKey(final String key) throws IOException {
+        if (key.equals("true")) {
+            return true;
+        }
+        if (key.equals("false")) {
+            return false;
+        }
+        throw error("Invalid boolean map key: " + key);
+    }
+
+    /**
+     * Reads a google.protobuf.Timestamp like "1972-01-01T10:00:20.021Z" and returns its seconds.
+     * The nanos are available from {@link #lastNanos()} afterwards.
+     */
+    public long readTimestamp() throws IOException {
+        final String text = readString();
+        final int year = digits(text, 0, 4);
+        character(text, 4, '-');
+        final int month = digits(text, 5, 2);
+        character(text, 7, '-');
+        final int day = digits(text, 8, 2);
+        if (text.length() <= 10 || (text.charAt(10) != 'T' && text.charAt(10) != 't')) {
+            throw error("Invalid timestamp: " + text);
+        }
+        final int hour = digits(text, 11, 2);
+        character(text, 13, ':');
+        final int minute = digits(text, 14, 2);
+        character(text, 16, ':');
+        final int second = digits(text, 17, 2);
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) {
+            throw error("Invalid timestamp: " + text);
+        }
+        int i = fraction(text, 19);
+        int offset = 0;
+        if (i < text.length() && (text.charAt(i) == 'Z' || text.charAt(i) == 'z')) {
+            i++;
+        } else if (i < text.length() && (text.charAt(i) == '+' || text.charAt(i) == '-')) {
+            offset = digits(text, i + 1, 2) * 3600;
+            character(text, i + 3, ':');
+            offset += digits(text, i + 4, 2) * 60;
+            if (text.charAt(i) == '-') {
+                offset = -offset;
+            }
+            i += 6;
+        } else {
+            throw error("Invalid timestamp: " + text);
+        }
+        if (i != text.length()) {
+            throw error("Invalid timestamp: " + text);
+        }
+        return epochDay(year, month, day) * 86400L + hour * 3600 + minute * 60 + second - offset;
+    }
+
+    /**
+     * Reads a google.protobuf.Duration like "-1.500s" and returns its seconds.
+     * The nanos are available from {@link #lastNanos()} afterwards.
+     */
+    public long readDuration() throws IOException {
+        final String text = readString();
+        final int length = text.length();
+        final boolean negative = length > 0 && text.charAt(0) == '-';
+        int i = negative ? 1 : 0;
+        long seconds = 0;
+        final int start = i;
+        for (; i < length && text.charAt(i) >= '0' && text.charAt(i) <= '9'; i++) {
+            seconds = seconds * 10 + (text.charAt(i) - '0');
+        }
+        if (i == start || i - start > 12) {
+            throw error("Invalid duration: " + text);
+        }
+        i = fraction(text, i);
+        if (i != length - 1 || text.charAt(i) != 's') {
+            throw error("Invalid duration: " + text);
+        }
+        if (negative) {
+            nanos = -nanos;
+            return -seconds;
+        }
+        return seconds;
+    }
+
+    /**
+     * Returns the nanos of the last timestamp or duration.
+     */
+    public int lastNanos() {
+        return nanos;
+    }
+
+    /**
+     * Reads a google.protobuf.FieldMask and returns its paths in snake_case.
+     */
+    public LazyStringArrayList readFieldMask() throws IOException {
+        final String text = readString();
+        final LazyStringArrayList paths = new LazyStringArrayList();
+        if (text.isEmpty()) {
+            return paths;
+        }
+        string.setLength(0);
+        for (int i = 0; i <= text.length(); i++) {
+            final char c = i < text.length() ? text.charAt(i) : ',';
+            if (c == ',') {
+                paths.add(string.toString());
+                string.setLength(0);
+            } else if (Character.isUpperCase(c)) {
+                string.append('_').append(Character.toLowerCase(c));
+            } else {
+                string.append(c);
+            }
+        }
+        return paths;
+    }
+
+    private boolean fill() throws IOException {
+        final int read = reader.read(buffer, 0, buffer.length);
+        if (read <= 0) {
+            return false;
+        }
+        pos = 0;
+        limit = read;
+        return true;
+    }
+
+    private char next() throws IOException {
+        if (pos == limit && !fill()) {
+            throw error("Unexpected end of input");
+        }
+        return buffer[pos++];
+    }
+
+    private void expect(final char expected) throws IOException {
+        final int c = peek();
+        if (c != expected) {
+            throw error("Expected '" + expected + "' but found " + describe(c));
+        }
+        pos++;
+    }
+
+    private void literal(final String word) throws IOException {
+        for (int i = 0; i < word.length(); i++) {
+            if (next() != word.charAt(i)) {
+                throw error("Invalid literal, expected " + word);
+            }
+        }
+        afterValue = true;
+    }
+
+    // reads a plain or quoted number into token and returns its length
+    private int readToken() throws IOException {
+        int c = peek();
+        final boolean quoted = c == '"';
+        if (quoted) {
+            pos++;
+        }
+        int length = 0;
+        while (true) {
+            if (pos == limit && !fill()) {
+                if (quoted) {
+                    throw error("Unterminated string");
+                }
+                break;
+            }
+            c = buffer[pos];
+            if (quoted ? c == '"' : !isNumberChar(c)) {
+                break;
+            }
+            if (length == token.length) {
+                token = Arrays.copyOf(token, length * 2);
+            }
+            token[length++] = (char) c;
+            pos++;
+        }
+        if (quoted) {
+            pos++;
+        }
+        if (length == 0) {
+            throw error("Expected a number but found " + describe(c));
+        }
+        afterValue = true;
+        return length;
+    }
+
+    private static boolean isNumberChar(final int c) {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    private int load(final String text) {
+        if (text.length() > token.length) {
+            token = new char[text.length()];
+        }
+        text.getChars(0, text.length(), token, 0);
+        return text.length();
+    }
+
+    private long parseLong(final int length, final boolean unsigned) throws IOException {
+        final boolean negative = token[0] == '-';
+        int i = negative ? 1 : 0;
+        if (i < length && length - i <= 18) {
+            long value = 0;
+            for (; i < length; i++) {
+                final char c = token[i];
+                if (c < '0' || c > '9') {
+                    break;
+                }
+                value = value * 10 + (c - '0');
+            }
+            if (i == length && !(negative && unsigned && value != 0)) {
+                return negative ? -value : value;
+            }
+        }
+        // long values, exponents, fractions like 2.0 and everything invalid
+        final String text = new String(token, 0, length);
+        try {
+            final BigInteger value = new BigDecimal(text).toBigIntegerExact();
+            if (unsigned ? value.signum() >= 0 && value.bitLength() <= 64 : value.bitLength() <= 63) {
+                return value.longValue();
+            }
+        } catch (NumberFormatException | ArithmeticException e) {
+            throw error("Invalid integer: " + text);
+        }
+        throw error("Integer out of range: " + text);
+    }
+
+    private int toInt(final long value) throws IOException {
+        if ((int) value != value) {
+            throw error("Out of range for int32: " + value);
+        }
+        return (int) value;
+    }
+
+    private int toUnsignedInt(final long value) throws IOException {
+        if (value < 0 || value > 0xFFFFFFFFL) {
+            throw error("Out of range for uint32: " + value);
+        }
+        return (int) value;
+    }
+
+    private int digits(final String text, final int start, final int count) throws IOException {
+        if (start + count > text.length()) {
+            throw error("Invalid value: " + text);
+        }
+        int value = 0;
+        for (int i = start; i < start + count; i++) {
+            final char c = text.charAt(i);
+            if (c < '0' || c > '9') {
+                throw error("Invalid value: " + text);
+            }
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    }
+
+    private void character(final String text, final int index, final char expected) throws IOException {
+        if (index >= text.length() || text.charAt(index) != expected) {
+            throw error("Invalid value: " + text);
+        }
+    }
+
+    // parses an optional fraction of a second into nanos and returns the index after it
+    private int fraction(final String text, int i) throws IOException {
+        nanos = 0;
+        if (i >= text.length() || text.charAt(i) != '.') {
+            return i;
+        }
+        final int start = ++i;
+        for (; i < text.length() && text.charAt(i) >= '0' && text.charAt(i) <= '9'; i++) {
+            if (i - start < 9) {
+                nanos = nanos * 10 + (text.charAt(i) - '0');
+            }
+        }
+        if (i == start || i - start > 9) {
+            throw error("Invalid fraction: " + text);
+        }
+        for (int digits = i - start; digits < 9; digits++) {
+            nanos *= 10;
+        }
+        return i;
+    }
+
+    // days since 1970-01-01, the inverse of JsonWriter.writeTimestamp
+    private static long epochDay(long year, final int month, final int day) {
+        year -= month <= 2 ? 1 : 0;
+        final long era = Math.floorDiv(year, 400);
+        final long yearOfEra = year - era * 400;
+        final long dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        final long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    private static String describe(final int c) {
+        return c < 0 ? "end of input" : "'" + (char) c + "'";
+    }
+
+    private static InvalidProtocolBufferException error(final String message) {
+        return new InvalidProtocolBufferException(message);
+    }
+}
@@ -0,0 +1,315 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.ByteString;
+
+import java.io.IOException;
+import java.util.List;
+import java.util.function.IntFunction;
+
+/**
+ * Writes the values of the generated {@code writeJson(Appendable)} methods as proto3 JSON.
+ * Apart from floating point numbers nothing is allocated.
+ */
+public final class JsonWriter {
+    private static final char[] HEX = "0123456789abcdef".toCharArray();
+    private static final char[] BASE64 =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/".toCharArray();
+    private static final long SECONDS_PER_DAY = 86400L;
+
+    private JsonWriter() {
+    }
+
+    /**
+     * Writes the name of the next member of an object and returns the new value of {@code first}.
+     */
+    public static boolean name(final Appendable out, final boolean first, final String name) throws IOException {
+        if (!first) {
+            out.append(',');
+        }
+        writeString(out, name);
+        out.append(':');
+        return false;
+    }
+
+    /**
+     * Writes a numeric map key, which JSON requires to be a string.
+     */
+    public static boolean key(final Appendable out, final boolean first, final long key) throws IOException {
+        if (!first) {
+            out.append(',');
+        }
+        writeQuotedLong(out, key);
+        out.append(':');
+        return false;
+    }
+
+    public static boolean unsignedKey(final Appendable out, final boolean first, final long key) throws IOException {
+        if (!first) {
+            out.append(',');
+        }
+        writeQuotedUnsignedLong(out, key);
+        out.append(':');
+        return false;
+    }
+
+    public static boolean key(final Appendable out, final boolean first, final boolean key) throws IOException {
+        return name(out, first, key ? "true" : "false");
+    }
+
+    /**
+     * Writes a quoted and escaped string. Leo uses null for unset strings, so null is written as "".
+     */
+    public static void writeString(final Appendable out, final CharSequence value) throws IOException {
+        out.append('"');
+        if (value != null) {
+            int start = 0;
+            final int length = value.length();
+            for (int i = 0; i < length; i++) {
+                final char c = value.charAt(i);
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                out.append(value, start, i);
+                start = i + 1;
+                switch (c) {
+                    case '"':
+                        out.append("\\\"");
+                        break;
+                    case '\\':
+                        out.append("\\\\");
+                        break;
+                    case '\n':
+                        out.append("\\n");
+                        break;
+                    case '\r':
+                        out.append("\\r");
+                        break;
+                    case '\t':
+                        out.append("\\t");
+                        break;
+                    default:
+                        out.append("\\u00").append(HEX[c >> 4]).append(HEX[c & 0xF]);
+                }
+            }
+            out.append(value, start, length);
+        }
+        out.append('"');
+    }
+
+    public static void writeBool(final Appendable out, final boolean value) throws IOException {
+        out.append(value ? "true" : "false");
+    }
+
+    public static void writeInt(final Appendable out, final int value) throws IOException {
+        writeLong(out, value);
+    }
+
+    public static void writeUnsignedInt(final Appendable out, final int value) throws IOException {
+        writeLong(out, value & 0xFFFFFFFFL);
+    }
+
+    public static void writeLong(final Appendable out, long value) throws IOException {
+        if (value == Long.MIN_VALUE) {
+            out.append("-9223372036854775808");
+            return;
+        }
+        if (value < 0) {
+            out.append('-');
+            value = -value;
+        }
+        long divisor = 1;
+        while (value / divisor >= 10) {
+            divisor *= 10;
+        }
+        for (; divisor > 0; divisor /= 10) {
+            out.append((char) ('0' + (value / divisor) % 10));
+        }
+    }
+
+    public static void writeUnsignedLong(final Appendable out, final long value) throws IOException {
+        if (value >= 0) {
+            writeLong(out, value);
+        } else {
+            // split off the last digit so the rest fits into a signed long
+            final long quotient = (value >>> 1) / 5;
+            writeLong(out, quotient);
+            out.append((char) ('0' + (value - quotient * 10)));
+        }
+    }
+
+    /**
+     * 64 bit integers are written as strings in proto3 JSON.
+     */
+    public static void writeQuotedLong(final Appendable out, final long value) throws IOException {
+        out.append('"');
+        writeLong(out, value);
+        out.append('"');
+    }
+
+    public static void writeQuotedUnsignedLong(final Appendable out, final long value) throws IOException {
+        out.append('"');
+        writeUnsignedLong(out, value);
+        out.append('"');
+    }
+
+    public static void writeFloat(final Appendable out, final float value) throws IOException {
+        if (Float.isNaN(value) || Float.isInfinite(value)) {
+            writeNonFinite(out, value);
+        } else {
+            out.append(Float.toString(value));
+        }
+    }
+
+    public static void writeDouble(final Appendable out, final double value) throws IOException {
+        if (Double.isNaN(value) || Double.isInfinite(value)) {
+            writeNonFinite(out, value);
+        } else {
+            out.append(Double.toString(value));
+        }
+    }
+
+    private static void writeNonFinite(final Appendable out, final double value) throws IOException {
+        if (Double.isNaN(value)) {
+            out.append("\"NaN\"");
+        } else {
+            out.append(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+        }
+    }
+
+    /**
+     * Writes the name of the enum value, or its number if it is unknown.
+     */
+    public static void writeEnum(final Appendable out, final int number, final IntFunction<? extends Enum<?>> forNumber)
+            throws IOException {
+        final Enum<?> value = forNumber.apply(number);
+        if (value == null) {
+            writeInt(out, number);
+        } else {
+            writeString(out, value.name());
+        }
+    }
+
+    /**
+     * Writes standard base64 with padding.
+     */
+    public static void writeBytes(final Appendable out, final ByteString value) throws IOException {
+        out.append('"');
+        if (value != null) {
+            final int size = value.size();
+            int i = 0;
+            for (; i + 2 < size; i += 3) {
+                final int bits = (value.byteAt(i) & 0xFF) << 16 | (value.byteAt(i + 1) & 0xFF) << 8
+                        | (value.byteAt(i + 2) & 0xFF);
+                out.append(BASE64[bits >> 18]).append(BASE64[(bits >> 12) & 0x3F])
+                        .append(BASE64[(bits >> 6) & 0x3F]).append(BASE64[bits & 0x3F]);
+            }
+            if (i + 1 == size) {
+                final int bits = (value.byteAt(i) & 0xFF) << 16;
+                out.append(BASE64[bits >> 18]).append(BASE64[(bits >> 12) & 0x3F]).append("==");
+            } else if (i + 2 == size) {
+                final int bits = (value.byteAt(i) & 0xFF) << 16 | (value.byteAt(i + 1) & 0xFF) << 8;
+                out.append(BASE64[bits >> 18]).append(BASE64[(bits >> 12) & 0x3F])
+                        .append(BASE64[(bits >> 6) & 0x3F]).append('=');
+            }
+        }
+        out.append('"');
+    }
+
+    /**
+     * Writes a google.protobuf.Timestamp as RFC 3339 string, e.g. "1972-01-01T10:00:20.021Z".
+     */
+    public static void writeTimestamp(final Appendable out, final long seconds, final int nanos) throws IOException {
+        long days = Math.floorDiv(seconds, SECONDS_PER_DAY);
+        final int secondOfDay = (int) Math.floorMod(seconds, SECONDS_PER_DAY);
+
+        // days since 1970-01-01 to year/month/day, see java.time.LocalDate.ofEpochDay
+        days += 719468;
+        final long era = Math.floorDiv(days, 146097);
+        final long dayOfEra = days - era * 146097;
+        final long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        final long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        final long shiftedMonth = (5 * dayOfYear + 2) / 153;
+        final int day = (int) (dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+        final int month = (int) (shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+        final long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+        out.append('"');
+        writePadded(out, year, 4);
+        out.append('-');
+        writePadded(out, month, 2);
+        out.append('-');
+        writePadded(out, day, 2);
+        out.append('T');
+        writePadded(out, secondOfDay / 3600, 2);
+        out.append(':');
+        writePadded(out, secondOfDay / 60 % 60, 2);
+        out.append(':');
+        writePadded(out, secondOfDay % 60, 2);
+        writeNanos(out, nanos);
+        out.append("Z\"");
+    }
+
+    /**
+     * Writes a google.protobuf.Duration as string, e.g. "-1.500s".
+     */
+    public static void writeDuration(final Appendable out, final long seconds, final int nanos) throws IOException {
+        out.append('"');
+        if (seconds < 0 || nanos < 0) {
+            out.append('-');
+            writeUnsignedLong(out, seconds == Long.MIN_VALUE ? seconds : Math.abs(seconds));
+        } else {
+            writeLong(out, seconds);
+        }
+        writeNanos(out, Math.abs(nanos));
+        out.append("s\"");
+    }
+
+    /**
+     * Writes a google.protobuf.FieldMask as comma separated lowerCamelCase paths.
+     */
+    public static void writeFieldMask(final Appendable out, final List<String> paths) throws IOException {
+        out.append('"');
+        for (int i = 0; i < paths.size(); i++) {
+            if (i > 0) {
+                out.append(',');
+            }
+            final String path = paths.get(i);
+            boolean upper = false;
+            for (int j = 0; j < path.length(); j++) {
+                final char c = path.charAt(j);
+                if (c == '_') {
+                    upper = true;
+                } else {
+                    out.append(upper ? Character.toUpperCase(c) : c);
+                    upper = false;
+                }
+            }
+        }
+        out.append('"');
+    }
+
+    private static void writeNanos(final Appendable out, final int nanos) throws IOException {
+        if (nanos == 0) {
+            return;
+        }
+        out.append('.');
+        if (nanos % 1000000 == 0) {
+            writePadded(out, nanos / 1000000, 3);
+        } else if (nanos % 1000 == 0) {
+            writePadded(out, nanos / 1000, 6);
+        } else {
+            writePadded(out, nanos, 9);
+        }
+    }
+
+    private static void writePadded(final Appendable out, final long value, final int digits) throws IOException {
+        long limit = 10;
+        for (int i = 1; i < digits; i++) {
+            if (value < limit) {
+                out.append('0');
+            }
+            limit *= 10;
+        }
+        writeLong(out, value);
+    }
+}
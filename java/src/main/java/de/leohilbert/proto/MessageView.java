@@ -0,0 +1,267 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.ByteString;
+import com.google.protobuf.InvalidProtocolBufferException;
+import com.google.protobuf.UnsafeByteOperations;
+
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+
+/**
+ * Base class of the generated {@code <Message>View} classes, read-only views of a serialized message that decode a
+ * field only when its getter is called.
+ * <p>
+ * A view wraps a {@code byte[]} region or the remaining bytes of a {@link ByteBuffer} without copying them. The first
+ * getter call walks the tags once and remembers where the value of every field of the view starts, getters then decode
+ * from there. Views are reset onto new bytes instead of being created per message, the index and the views of nested
+ * messages are reused. Malformed bytes surface as an {@link UncheckedIOException} wrapping an
+ * {@link InvalidProtocolBufferException} from the getter that built the index.
+ */
+public abstract class MessageView {
+    private byte[] array;
+    private ByteBuffer buffer;
+    private int start;
+    private int end;
+    private boolean indexed;
+    // the position after the last varint or length prefix that was read
+    private int next;
+    // counts the resets, a nested view remembers the one of its parent to keep its index while both stay put
+    private int epoch;
+    private MessageView parent;
+    private int parentEpoch;
+
+    protected MessageView() {
+    }
+
+    protected final void wrap(final byte[] array, final int offset, final int length) {
+        if (offset < 0 || length < 0 || offset + length > array.length) {
+            throw new IndexOutOfBoundsException(
+                    "offset " + offset + " and length " + length + " of " + array.length + " bytes");
+        }
+        this.array = array;
+        this.buffer = null;
+        this.start = offset;
+        this.end = offset + length;
+        this.indexed = false;
+        this.parent = null;
+        epoch++;
+    }
+
+    /**
+     * Wraps the bytes between the position and the limit of {@code buffer}, which is read with absolute gets and keeps
+     * its position.
+     */
+    protected final void wrap(final ByteBuffer buffer) {
+        if (buffer.hasArray()) {
+            wrap(buffer.array(), buffer.arrayOffset() + buffer.position(), buffer.remaining());
+            return;
+        }
+        this.array = null;
+        this.buffer = buffer;
+        this.start = buffer.position();
+        this.end = buffer.limit();
+        this.indexed = false;
+        this.parent = null;
+        epoch++;
+    }
+
+    /**
+     * The number of bytes of the wrapped message.
+     */
+    public final int getSerializedSize() {
+        return end - start;
+    }
+
+    /**
+     * Resets the index, every field of the view becomes absent.
+     */
+    protected abstract void clearIndex();
+
+    /**
+     * Called for every tag of the message while the index is built.
+     *
+     * @param position where the value of the field starts
+     */
+    protected abstract void indexField(int tag, int position);
+
+    protected final void ensureIndexed() {
+        if (indexed) {
+            return;
+        }
+        clearIndex();
+        int position = start;
+        while (position < end) {
+            final int tag = (int) readVarint(position);
+            if (tag >>> 3 == 0) {
+                throw malformed("Protocol message contained an invalid tag (zero).");
+            }
+            indexField(tag, next);
+            position = skipField(tag, next);
+        }
+        indexed = true;
+    }
+
+    private int skipField(final int tag, final int position) {
+        switch (tag & 7) {
+            case 0:
+                readVarint(position);
+                return next;
+            case 1:
+                return checked(position + 8);
+            case 2: {
+                final int length = readLength(position);
+                return next + length;
+            }
+            case 3: {
+                int current = position;
+                while (true) {
+                    final int inner = (int) readVarint(current);
+                    if (inner == ((tag & ~7) | 4)) {
+                        return next;
+                    }
+                    if (inner >>> 3 == 0 || (inner & 7) == 4) {
+                        throw malformed("Protocol message end-group tag did not match expected tag.");
+                    }
+                    current = skipField(inner, next);
+                }
+            }
+            case 5:
+                return checked(position + 4);
+            default:
+                throw malformed("Protocol message tag had invalid wire type.");
+        }
+    }
+
+    private int checked(final int position) {
+        if (position < 0 || position > end) {
+            throw truncated();
+        }
+        return position;
+    }
+
+    private byte byteAt(final int position) {
+        if (position >= end) {
+            throw truncated();
+        }
+        return array != null ? array[position] : buffer.get(position);
+    }
+
+    protected final long readVarint(final int position) {
+        long result = 0;
+        for (int shift = 0, current = position; shift < 64; shift += 7, current++) {
+            final byte b = byteAt(current);
+            result |= (long) (b & 0x7F) << shift;
+            if (b >= 0) {
+                next = current + 1;
+                return result;
+            }
+        }
+        throw malformed("CodedInputStream encountered a malformed varint.");
+    }
+
+    private int readLength(final int position) {
+        final int length = (int) readVarint(position);
+        // next + length could overflow for lengths close to Integer.MAX_VALUE
+        if (length < 0 || length > end - next) {
+            throw truncated();
+        }
+        return length;
+    }
+
+    protected final int readInt32(final int position) {
+        return (int) readVarint(position);
+    }
+
+    protected final long readInt64(final int position) {
+        return readVarint(position);
+    }
+
+    protected final int readSInt32(final int position) {
+        final int n = (int) readVarint(position);
+        return (n >>> 1) ^ -(n & 1);
+    }
+
+    protected final long readSInt64(final int position) {
+        final long n = readVarint(position);
+        return (n >>> 1) ^ -(n & 1);
+    }
+
+    protected final boolean readBool(final int position) {
+        return readVarint(position) != 0;
+    }
+
+    protected final int readFixed32(final int position) {
+        return (byteAt(position) & 0xFF)
+                | (byteAt(position + 1) & 0xFF) << 8
+                | (byteAt(position + 2) & 0xFF) << 16
+                | (byteAt(position + 3) & 0xFF) << 24;
+    }
+
+    protected final long readFixed64(final int position) {
+        return (readFixed32(position) & 0xFFFFFFFFL) | (long) readFixed32(position + 4) << 32;
+    }
+
+    protected final float readFloat(final int position) {
+        return Float.intBitsToFloat(readFixed32(position));
+    }
+
+    protected final double readDouble(final int position) {
+        return Double.longBitsToDouble(readFixed64(position));
+    }
+
+    /**
+     * Decodes a string, invalid UTF-8 is replaced instead of rejected.
+     */
+    protected final String readString(final int position) {
+        final int length = readLength(position);
+        if (array != null) {
+            return new String(array, next, length, StandardCharsets.UTF_8);
+        }
+        return new String(copy(next, length), StandardCharsets.UTF_8);
+    }
+
+    protected final ByteString readBytes(final int position) {
+        final int length = readLength(position);
+        if (length == 0) {
+            return ByteString.EMPTY;
+        }
+        return UnsafeByteOperations.unsafeWrap(array != null ? Arrays.copyOfRange(array, next, next + length)
+                : copy(next, length));
+    }
+
+    private byte[] copy(final int position, final int length) {
+        final byte[] bytes = new byte[length];
+        buffer.get(position, bytes);
+        return bytes;
+    }
+
+    /**
+     * Resets {@code view} onto the length-delimited message at {@code position}, sharing the bytes of this view. A view
+     * that is still on that message keeps its index.
+     */
+    protected final <V extends MessageView> V readMessage(final V view, final int position) {
+        final int length = readLength(position);
+        if (view.parent == this && view.parentEpoch == epoch && view.start == next) {
+            return view;
+        }
+        view.array = array;
+        view.buffer = buffer;
+        view.start = next;
+        view.end = next + length;
+        view.indexed = false;
+        view.parent = this;
+        view.parentEpoch = epoch;
+        view.epoch++;
+        return view;
+    }
+
+    private static UncheckedIOException truncated() {
+        return malformed("While parsing a protocol message, the input ended unexpectedly in the middle of a field.");
+    }
+
+    private static UncheckedIOException malformed(final String message) {
+        return new UncheckedIOException(new InvalidProtocolBufferException(message));
+    }
+}
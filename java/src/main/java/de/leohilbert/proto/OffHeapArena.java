@@ -0,0 +1,198 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.ByteString;
+import com.google.protobuf.CodedOutputStream;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * Direct memory for the records of the generated {@code <Message>OffHeap} classes of messages with the
+ * {@code off_heap} option.
+ * <p>
+ * Records and the blobs holding string and bytes values are allocated from one direct {@link ByteBuffer}, which is
+ * replaced by a larger copy when it runs full. Everything is addressed by offsets into the arena, so they stay valid
+ * when it grows. Nothing is freed on its own: a blob that is too small for a new value is left behind, {@link #clear()}
+ * drops all records and blobs at once. Offset 0 is never handed out and stands for "no blob".
+ * <p>
+ * An arena is not thread-safe.
+ */
+public final class OffHeapArena {
+    private static final int FIRST_OFFSET = 8;
+
+    private ByteBuffer memory;
+    // shares the memory, its position and limit are moved to write blobs
+    private ByteBuffer window;
+    private int top = FIRST_OFFSET;
+
+    public OffHeapArena() {
+        this(64 * 1024);
+    }
+
+    /**
+     * @param capacity number of bytes reserved up front
+     */
+    public OffHeapArena(final int capacity) {
+        setMemory(ByteBuffer.allocateDirect(Math.max(capacity, 64)));
+    }
+
+    private void setMemory(final ByteBuffer memory) {
+        this.memory = memory.order(ByteOrder.LITTLE_ENDIAN);
+        this.window = this.memory.duplicate();
+    }
+
+    /**
+     * The number of bytes in use.
+     */
+    public int size() {
+        return top;
+    }
+
+    public int capacity() {
+        return memory.capacity();
+    }
+
+    /**
+     * Drops all records and blobs, their offsets must not be used anymore. The memory is kept.
+     */
+    public void clear() {
+        top = FIRST_OFFSET;
+    }
+
+    /**
+     * Allocates {@code size} zeroed bytes, aligned to 8 bytes.
+     *
+     * @return the offset of the first byte
+     */
+    public int allocate(final int size) {
+        final int offset = top;
+        final int end = offset + ((size + 7) & ~7);
+        if (end < 0) {
+            throw new OutOfMemoryError("off-heap arena can not grow beyond 2 GiB");
+        }
+        if (end > memory.capacity()) {
+            grow(end);
+        }
+        for (int i = offset; i < end; i += 8) {
+            memory.putLong(i, 0L);
+        }
+        top = end;
+        return offset;
+    }
+
+    private void grow(final int required) {
+        int capacity = memory.capacity();
+        while (capacity < required) {
+            capacity = capacity > Integer.MAX_VALUE / 2 ? Integer.MAX_VALUE : capacity * 2;
+        }
+        final ByteBuffer bigger = ByteBuffer.allocateDirect(capacity);
+        final ByteBuffer used = memory.duplicate();
+        used.position(0).limit(top);
+        bigger.put(used).clear();
+        setMemory(bigger);
+    }
+
+    public byte getByte(final int offset) {
+        return memory.get(offset);
+    }
+
+    public void putByte(final int offset, final byte value) {
+        memory.put(offset, value);
+    }
+
+    public boolean getBoolean(final int offset) {
+        return memory.get(offset) != 0;
+    }
+
+    public void putBoolean(final int offset, final boolean value) {
+        memory.put(offset, value ? (byte) 1 : (byte) 0);
+    }
+
+    public int getInt(final int offset) {
+        return memory.getInt(offset);
+    }
+
+    public void putInt(final int offset, final int value) {
+        memory.putInt(offset, value);
+    }
+
+    public long getLong(final int offset) {
+        return memory.getLong(offset);
+    }
+
+    public void putLong(final int offset, final long value) {
+        memory.putLong(offset, value);
+    }
+
+    public float getFloat(final int offset) {
+        return memory.getFloat(offset);
+    }
+
+    public void putFloat(final int offset, final float value) {
+        memory.putFloat(offset, value);
+    }
+
+    public double getDouble(final int offset) {
+        return memory.getDouble(offset);
+    }
+
+    public void putDouble(final int offset, final double value) {
+        memory.putDouble(offset, value);
+    }
+
+    /**
+     * Stores {@code bytes} in {@code blob} if it is large enough, otherwise in a new blob.
+     *
+     * @param blob a blob returned earlier or 0
+     * @return the blob holding the bytes
+     */
+    public int storeBlob(final int blob, final byte[] bytes) {
+        final int target = reserveBlob(blob, bytes.length);
+        memory.put(target + 4, bytes);
+        return target;
+    }
+
+    /**
+     * Like {@link #storeBlob(int, byte[])}, copying straight out of the ByteString.
+     */
+    public int storeBlob(final int blob, final ByteString bytes) {
+        final int target = reserveBlob(blob, bytes.size());
+        window.limit(target + 4 + bytes.size()).position(target + 4);
+        bytes.copyTo(window);
+        return target;
+    }
+
+    // a blob starts with its capacity, the length of the value is kept by the record
+    private int reserveBlob(final int blob, final int length) {
+        if (blob != 0 && memory.getInt(blob) >= length) {
+            return blob;
+        }
+        final int target = allocate(4 + length);
+        memory.putInt(target, length);
+        return target;
+    }
+
+    public String readString(final int blob, final int length) {
+        final byte[] bytes = new byte[length];
+        memory.get(blob + 4, bytes);
+        return new String(bytes, StandardCharsets.UTF_8);
+    }
+
+    public ByteString readBytes(final int blob, final int length) {
+        if (length == 0) {
+            return ByteString.EMPTY;
+        }
+        window.limit(blob + 4 + length).position(blob + 4);
+        return ByteString.copyFrom(window);
+    }
+
+    /**
+     * Writes the first {@code length} bytes of a blob without a tag or length prefix.
+     */
+    public void writeBlob(final CodedOutputStream output, final int blob, final int length) throws IOException {
+        window.limit(blob + 4 + length).position(blob + 4);
+        output.write(window);
+    }
+}
@@ -0,0 +1,58 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.InvalidProtocolBufferException;
+import com.google.protobuf.WireFormat;
+
+import java.io.IOException;
+
+/**
+ * Writes the {@code seconds = 1} / {@code nanos = 2} layout google.protobuf.Timestamp and google.protobuf.Duration
+ * share, for {@link InstantCodec} and {@link DurationCodec}.
+ */
+final class SecondsAndNanos {
+    // field number << 3 | WIRETYPE_VARINT
+    static final int SECONDS_TAG = 8;
+    static final int NANOS_TAG = 16;
+
+    private SecondsAndNanos() {
+    }
+
+    static void write(final CodedOutputStream output, final int fieldNumber, final long seconds, final int nanos)
+            throws IOException {
+        output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+        output.writeUInt32NoTag(messageSize(seconds, nanos));
+        if (seconds != 0) {
+            output.writeInt64(1, seconds);
+        }
+        if (nanos != 0) {
+            output.writeInt32(2, nanos);
+        }
+    }
+
+    /**
+     * For seconds and nanos java.time can't hold, which the wire format doesn't rule out.
+     */
+    static InvalidProtocolBufferException outOfRange(final String type, final RuntimeException cause) {
+        final InvalidProtocolBufferException e =
+                new InvalidProtocolBufferException("Protocol message had a " + type + " out of range.");
+        e.initCause(cause);
+        return e;
+    }
+
+    static int size(final long seconds, final int nanos) {
+        final int messageSize = messageSize(seconds, nanos);
+        return CodedOutputStream.computeUInt32SizeNoTag(messageSize) + messageSize;
+    }
+
+    private static int messageSize(final long seconds, final int nanos) {
+        int size = 0;
+        if (seconds != 0) {
+            size += 1 + CodedOutputStream.computeInt64SizeNoTag(seconds);
+        }
+        if (nanos != 0) {
+            size += 1 + CodedOutputStream.computeInt32SizeNoTag(nanos);
+        }
+        return size;
+    }
+}
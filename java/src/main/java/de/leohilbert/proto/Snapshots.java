@@ -0,0 +1,43 @@
+package de.leohilbert.proto;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.function.UnaryOperator;
+
+/**
+ * Helpers for the generated {@code freeze()} methods.
+ */
+public final class Snapshots {
+    private Snapshots() {
+    }
+
+    /**
+     * Freezes all elements of {@code live}. Returns {@code previous} if it already contains exactly these
+     * snapshots, otherwise a new unmodifiable list.
+     */
+    public static <T> List<T> freezeList(final List<T> live, final List<T> previous, final UnaryOperator<T> freeze) {
+        final int size = live.size();
+        boolean unchanged = previous != null && previous.size() == size;
+        List<T> frozen = null;
+        for (int i = 0; i < size; i++) {
+            final T element = freeze.apply(live.get(i));
+            if (unchanged && element == previous.get(i)) {
+                continue;
+            }
+            if (frozen == null) {
+                frozen = new ArrayList<>(size);
+                // the elements before i are identical to the previous ones
+                for (int j = 0; j < i; j++) {
+                    frozen.add(previous.get(j));
+                }
+            }
+            unchanged = false;
+            frozen.add(element);
+        }
+        if (unchanged) {
+            return previous;
+        }
+        return frozen == null ? Collections.emptyList() : Collections.unmodifiableList(frozen);
+    }
+}
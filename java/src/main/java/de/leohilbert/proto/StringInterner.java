@@ -0,0 +1,104 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.InvalidProtocolBufferException;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.CharacterCodingException;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+
+/**
+ * Deduplicates the values of a string field with the {@code intern} option while they are parsed.
+ * <p>
+ * A fixed-size table keyed on the UTF-8 bytes of the strings it has seen. A hit returns the cached String without
+ * creating a new one, a miss decodes the bytes and replaces whatever was in that slot, so the table never grows.
+ * Entries are immutable and stored without locks, a reader on another thread sees either a complete entry or an
+ * older one.
+ */
+public final class StringInterner {
+    /**
+     * Longer values are decoded as usual, low cardinality strings are short.
+     */
+    public static final int MAX_LENGTH = 128;
+
+    private static final ThreadLocal<byte[]> SCRATCH = ThreadLocal.withInitial(() -> new byte[MAX_LENGTH]);
+
+    private final Entry[] table;
+
+    public StringInterner() {
+        this(1024);
+    }
+
+    /**
+     * @param size number of slots, rounded up to a power of two
+     */
+    public StringInterner(final int size) {
+        table = new Entry[size <= 1 ? 1 : Integer.highestOneBit(size - 1) << 1];
+    }
+
+    /**
+     * Reads a length-delimited string like {@link CodedInputStream#readStringRequireUtf8()}.
+     */
+    public String readStringRequireUtf8(final CodedInputStream input) throws IOException {
+        return read(input, true);
+    }
+
+    /**
+     * Reads a length-delimited string like {@link CodedInputStream#readString()}.
+     */
+    public String readString(final CodedInputStream input) throws IOException {
+        return read(input, false);
+    }
+
+    private String read(final CodedInputStream input, final boolean requireUtf8) throws IOException {
+        final int size = input.readRawVarint32();
+        if (size == 0) {
+            return "";
+        }
+        if (size < 0 || size > MAX_LENGTH) {
+            return decode(input.readRawBytes(size), size, requireUtf8);
+        }
+        final byte[] bytes = SCRATCH.get();
+        int hash = 0;
+        for (int i = 0; i < size; i++) {
+            final byte b = input.readRawByte();
+            bytes[i] = b;
+            hash = 31 * hash + b;
+        }
+        final int index = (hash ^ (hash >>> 16)) & (table.length - 1);
+        final Entry entry = table[index];
+        if (entry != null && entry.hash == hash
+                && Arrays.equals(entry.utf8, 0, entry.utf8.length, bytes, 0, size)) {
+            return entry.value;
+        }
+        final String value = decode(bytes, size, requireUtf8);
+        table[index] = new Entry(hash, Arrays.copyOf(bytes, size), value);
+        return value;
+    }
+
+    private static String decode(final byte[] bytes, final int size, final boolean requireUtf8)
+            throws InvalidProtocolBufferException {
+        if (!requireUtf8) {
+            return new String(bytes, 0, size, StandardCharsets.UTF_8);
+        }
+        try {
+            return StandardCharsets.UTF_8.newDecoder().decode(ByteBuffer.wrap(bytes, 0, size)).toString();
+        } catch (final CharacterCodingException e) {
+            throw new InvalidProtocolBufferException("Protocol message had invalid UTF-8.");
+        }
+    }
+
+    private static final class Entry {
+        final int hash;
+        final byte[] utf8;
+        final String value;
+
+        Entry(final int hash, final byte[] utf8, final String value) {
+            this.hash = hash;
+            this.utf8 = utf8;
+            this.value = value;
+        }
+    }
+}
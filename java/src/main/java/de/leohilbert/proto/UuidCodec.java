@@ -0,0 +1,115 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.InvalidProtocolBufferException;
+import com.google.protobuf.WireFormat;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.util.UUID;
+
+/**
+ * Built-in codec for string fields with {@code javatype = "java.util.UUID"}.
+ * <p>
+ * The canonical 36 character form is parsed from the wire bytes into the two longs of the UUID and formatted back
+ * into the output byte by byte, so neither direction creates a String. Other forms {@link UUID#fromString} accepts are
+ * still read, they just take the slow path.
+ */
+public final class UuidCodec {
+    private static final int LENGTH = 36;
+    private static final byte[] DIGITS = "0123456789abcdef".getBytes(StandardCharsets.US_ASCII);
+
+    private UuidCodec() {
+    }
+
+    public static UUID fromProto(final String value) {
+        return UUID.fromString(value);
+    }
+
+    public static String toProto(final UUID value) {
+        return value.toString();
+    }
+
+    public static UUID copy(final UUID value) {
+        return value;
+    }
+
+    public static UUID read(final CodedInputStream input) throws IOException {
+        final int size = input.readRawVarint32();
+        if (size != LENGTH) {
+            return parseSlow(input.readRawBytes(size));
+        }
+        long mostSigBits = 0;
+        long leastSigBits = 0;
+        for (int i = 0; i < LENGTH; i++) {
+            final byte b = input.readRawByte();
+            if (i == 8 || i == 13 || i == 18 || i == 23) {
+                if (b != '-') {
+                    throw invalidUuid();
+                }
+            } else if (i < 18) {
+                mostSigBits = (mostSigBits << 4) | digit(b);
+            } else {
+                leastSigBits = (leastSigBits << 4) | digit(b);
+            }
+        }
+        return new UUID(mostSigBits, leastSigBits);
+    }
+
+    public static void write(final CodedOutputStream output, final int fieldNumber, final UUID value)
+            throws IOException {
+        output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+        output.writeUInt32NoTag(LENGTH);
+        final long mostSigBits = value.getMostSignificantBits();
+        final long leastSigBits = value.getLeastSignificantBits();
+        writeDigits(output, mostSigBits >>> 32, 8);
+        output.writeRawByte('-');
+        writeDigits(output, mostSigBits >>> 16, 4);
+        output.writeRawByte('-');
+        writeDigits(output, mostSigBits, 4);
+        output.writeRawByte('-');
+        writeDigits(output, leastSigBits >>> 48, 4);
+        output.writeRawByte('-');
+        writeDigits(output, leastSigBits, 12);
+    }
+
+    /**
+     * Size of the length-delimited value without its tag.
+     */
+    public static int size(final UUID value) {
+        return 1 + LENGTH;
+    }
+
+    private static void writeDigits(final CodedOutputStream output, final long bits, final int digits)
+            throws IOException {
+        for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+            output.writeRawByte(DIGITS[(int) (bits >>> shift) & 0xF]);
+        }
+    }
+
+    private static long digit(final byte b) throws InvalidProtocolBufferException {
+        if (b >= '0' && b <= '9') {
+            return b - '0';
+        }
+        if (b >= 'a' && b <= 'f') {
+            return b - 'a' + 10;
+        }
+        if (b >= 'A' && b <= 'F') {
+            return b - 'A' + 10;
+        }
+        throw invalidUuid();
+    }
+
+    private static UUID parseSlow(final byte[] bytes) throws InvalidProtocolBufferException {
+        try {
+            return UUID.fromString(new String(bytes, StandardCharsets.UTF_8));
+        } catch (final IllegalArgumentException e) {
+            throw invalidUuid();
+        }
+    }
+
+    private static InvalidProtocolBufferException invalidUuid() {
+        return new InvalidProtocolBufferException("Protocol message had an invalid UUID.");
+    }
+}
@@ -0,0 +1,505 @@
+package de.leohilbert.proto;
+
+import com.google.protobuf.ByteString;
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.WireFormat;
+
+import java.io.IOException;
+
+/**
+ * Built-in codecs for the google.protobuf wrapper types, used for fields that are unboxed with the
+ * {@code unbox_well_known_types} option (or have the matching {@code java.lang} javatype).
+ * <p>
+ * The value is read from and written to the wire directly, the wrapper message is only created for JSON.
+ */
+public final class WrapperCodecs {
+    private WrapperCodecs() {
+    }
+
+    public static final class Int32Value {
+        private Int32Value() {
+        }
+
+        public static Integer fromProto(final com.google.protobuf.Int32Value value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.Int32Value toProto(final Integer value) {
+            return new com.google.protobuf.Int32Value().setValue(value);
+        }
+
+        public static Integer copy(final Integer value) {
+            return value;
+        }
+
+        public static Integer read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            int value = 0;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 8) { // field 1, varint
+                    value = input.readInt32();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Integer value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeInt32(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Integer value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final int value) {
+            return value == 0 ? 0 : 1 + CodedOutputStream.computeInt32SizeNoTag(value);
+        }
+    }
+
+    public static final class UInt32Value {
+        private UInt32Value() {
+        }
+
+        public static Integer fromProto(final com.google.protobuf.UInt32Value value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.UInt32Value toProto(final Integer value) {
+            return new com.google.protobuf.UInt32Value().setValue(value);
+        }
+
+        public static Integer copy(final Integer value) {
+            return value;
+        }
+
+        public static Integer read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            int value = 0;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 8) { // field 1, varint
+                    value = input.readUInt32();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Integer value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeUInt32(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Integer value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final int value) {
+            return value == 0 ? 0 : 1 + CodedOutputStream.computeUInt32SizeNoTag(value);
+        }
+    }
+
+    public static final class Int64Value {
+        private Int64Value() {
+        }
+
+        public static Long fromProto(final com.google.protobuf.Int64Value value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.Int64Value toProto(final Long value) {
+            return new com.google.protobuf.Int64Value().setValue(value);
+        }
+
+        public static Long copy(final Long value) {
+            return value;
+        }
+
+        public static Long read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            long value = 0L;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 8) { // field 1, varint
+                    value = input.readInt64();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Long value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeInt64(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Long value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final long value) {
+            return value == 0 ? 0 : 1 + CodedOutputStream.computeInt64SizeNoTag(value);
+        }
+    }
+
+    public static final class UInt64Value {
+        private UInt64Value() {
+        }
+
+        public static Long fromProto(final com.google.protobuf.UInt64Value value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.UInt64Value toProto(final Long value) {
+            return new com.google.protobuf.UInt64Value().setValue(value);
+        }
+
+        public static Long copy(final Long value) {
+            return value;
+        }
+
+        public static Long read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            long value = 0L;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 8) { // field 1, varint
+                    value = input.readUInt64();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Long value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeUInt64(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Long value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final long value) {
+            return value == 0 ? 0 : 1 + CodedOutputStream.computeUInt64SizeNoTag(value);
+        }
+    }
+
+    public static final class FloatValue {
+        private FloatValue() {
+        }
+
+        public static Float fromProto(final com.google.protobuf.FloatValue value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.FloatValue toProto(final Float value) {
+            return new com.google.protobuf.FloatValue().setValue(value);
+        }
+
+        public static Float copy(final Float value) {
+            return value;
+        }
+
+        public static Float read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            float value = 0f;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 13) { // field 1, fixed32
+                    value = input.readFloat();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Float value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeFloat(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Float value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final float value) {
+            return Float.floatToRawIntBits(value) == 0 ? 0 : 1 + 4;
+        }
+    }
+
+    public static final class DoubleValue {
+        private DoubleValue() {
+        }
+
+        public static Double fromProto(final com.google.protobuf.DoubleValue value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.DoubleValue toProto(final Double value) {
+            return new com.google.protobuf.DoubleValue().setValue(value);
+        }
+
+        public static Double copy(final Double value) {
+            return value;
+        }
+
+        public static Double read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            double value = 0d;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 9) { // field 1, fixed64
+                    value = input.readDouble();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Double value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeDouble(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Double value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final double value) {
+            return Double.doubleToRawLongBits(value) == 0 ? 0 : 1 + 8;
+        }
+    }
+
+    public static final class BoolValue {
+        private BoolValue() {
+        }
+
+        public static Boolean fromProto(final com.google.protobuf.BoolValue value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.BoolValue toProto(final Boolean value) {
+            return new com.google.protobuf.BoolValue().setValue(value);
+        }
+
+        public static Boolean copy(final Boolean value) {
+            return value;
+        }
+
+        public static Boolean read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            boolean value = false;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 8) { // field 1, varint
+                    value = input.readBool();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final Boolean value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeBool(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final Boolean value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final boolean value) {
+            return !value ? 0 : 1 + 1;
+        }
+    }
+
+    public static final class StringValue {
+        private StringValue() {
+        }
+
+        public static String fromProto(final com.google.protobuf.StringValue value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.StringValue toProto(final String value) {
+            return new com.google.protobuf.StringValue().setValue(value);
+        }
+
+        public static String copy(final String value) {
+            return value;
+        }
+
+        public static String read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            String value = "";
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 10) { // field 1, length-delimited
+                    value = input.readStringRequireUtf8();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final String value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeString(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final String value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final String value) {
+            return value.isEmpty() ? 0 : 1 + CodedOutputStream.computeStringSizeNoTag(value);
+        }
+    }
+
+    public static final class BytesValue {
+        private BytesValue() {
+        }
+
+        public static ByteString fromProto(final com.google.protobuf.BytesValue value) {
+            return value.getValue();
+        }
+
+        public static com.google.protobuf.BytesValue toProto(final ByteString value) {
+            return new com.google.protobuf.BytesValue().setValue(value);
+        }
+
+        public static ByteString copy(final ByteString value) {
+            return value;
+        }
+
+        public static ByteString read(final CodedInputStream input) throws IOException {
+            final int oldLimit = input.pushLimit(input.readRawVarint32());
+            ByteString value = ByteString.EMPTY;
+            int tag;
+            while ((tag = input.readTag()) != 0) {
+                if (tag == 10) { // field 1, length-delimited
+                    value = input.readBytes();
+                } else if (!input.skipField(tag)) {
+                    break;
+                }
+            }
+            endMessage(input, oldLimit);
+            return value;
+        }
+
+        public static void write(final CodedOutputStream output, final int fieldNumber, final ByteString value)
+                throws IOException {
+            output.writeTag(fieldNumber, WireFormat.WIRETYPE_LENGTH_DELIMITED);
+            final int messageSize = messageSize(value);
+            output.writeUInt32NoTag(messageSize);
+            if (messageSize != 0) {
+                output.writeBytes(1, value);
+            }
+        }
+
+        /**
+         * Size of the length-delimited value without its tag.
+         */
+        public static int size(final ByteString value) {
+            return lengthDelimitedSize(messageSize(value));
+        }
+
+        private static int messageSize(final ByteString value) {
+            return value.isEmpty() ? 0 : 1 + CodedOutputStream.computeBytesSizeNoTag(value);
+        }
+    }
+
+    private static void endMessage(final CodedInputStream input, final int oldLimit) throws IOException {
+        input.checkLastTagWas(0);
+        input.popLimit(oldLimit);
+    }
+
+    private static int lengthDelimitedSize(final int messageSize) {
+        return CodedOutputStream.computeUInt32SizeNoTag(messageSize) + messageSize;
+    }
+}
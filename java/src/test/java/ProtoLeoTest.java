@@ -2,17 +2,52 @@ import static com.google.protobuf.CodedInputStream.newInstance;
 import static com.google.protobuf.ExtensionRegistryLite.getEmptyRegistry;
 import static org.assertj.core.api.Assertions.assertThat;
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 
 import com.example.custom.CustomOwnerClass;
 import com.example.custom.CustomPhoneType;
+import com.example.flags.EntityFlags;
+import com.example.flags.EntityFlagsOffHeap;
+import com.example.flags.EntityFlagsTable;
+import com.example.flags.Team;
+import com.example.gateway.Envelope;
+import com.example.gateway.EnvelopeView;
+import com.example.gateway.Priority;
+import com.example.gateway.Route;
+import com.example.gateway.RouteView;
+import com.example.lean.LeanPerson;
+import com.example.memory.Mode;
+import com.example.memory.PlainCounter;
+import com.example.memory.ReleaseAcquireCounter;
+import com.example.memory.VolatileCounter;
 import com.example.tutorial.AddressBook;
 import com.example.tutorial.Person;
+import com.example.tutorial.PersonOffHeap;
+import com.example.tutorial.PersonTable;
 import com.example.tutorial.PhoneType;
+import com.example.tutorial.Session;
+import com.example.tutorial.Setting;
+import com.google.protobuf.ByteString;
+import com.google.protobuf.CodedOutputStream;
+import com.google.protobuf.Int32Value;
 import com.google.protobuf.InvalidProtocolBufferException;
+import com.google.protobuf.StringValue;
+import de.leohilbert.proto.FieldMask;
+import de.leohilbert.proto.OffHeapArena;
 import org.junit.jupiter.api.Test;
 
 import java.io.IOException;
+import java.io.StringReader;
+import java.io.UncheckedIOException;
+import java.lang.reflect.Modifier;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.nio.ByteBuffer;
+import java.time.Duration;
+import java.time.Instant;
+import java.util.Set;
 import java.util.UUID;
+import java.util.concurrent.ConcurrentHashMap;
 
 public class ProtoLeoTest {
     @Test
@@ -78,6 +113,774 @@ public class ProtoLeoTest {
         addressBook.toByteArray();
     }
 
+    @Test
+    public void testDeepCopy() {
+        Person person = new Person()
+                .setId(UUID.randomUUID())
+                .setName("Hans")
+                .addPhones(new Person.PhoneNumber().setNumber("12345").setType(CustomPhoneType.HOME))
+                .addFriendIds("Dieter")
+                .addFavoriteNumber(14);
+        AddressBook addressBook = new AddressBook()
+                .addPeople(person)
+                .setOwner(new CustomOwnerClass("owner@test.de"));
+
+        AddressBook copy = addressBook.deepCopy();
+        assertThat(copy.getPeopleList()).containsExactly(person);
+        assertThat(copy.getPeople(0)).isNotSameAs(person);
+        assertThat(copy.getOwner()).isNotSameAs(addressBook.getOwner());
+        assertThat(copy.getOwner().email).isEqualTo("owner@test.de");
+
+        copy.getPeople(0).getPhones(0).setNumber("54321");
+        copy.getPeople(0).addFavoriteNumber(15);
+        assertThat(person.getPhones(0).getNumber()).isEqualTo("12345");
+        assertThat(person.getFavoriteNumberList()).containsExactly(14);
+
+        Person target = new Person().setEmail("old@test.de");
+        target.copyFrom(person);
+        assertEquals(target, person);
+        assertThat(target.getEmail()).isNull();
+
+        // copying a message into itself keeps its repeated fields
+        Person expected = target.deepCopy();
+        assertThat(target.copyFrom(target)).isSameAs(target);
+        assertEquals(expected, target);
+        assertThat(target.getPhonesList()).hasSize(1);
+        assertThat(target.getFavoriteNumberList()).containsExactly(14);
+
+        // copyFrom notifies like the setters do
+        int hash = target.hashCode();
+        int[] updates = new int[1];
+        target.updateReceiver = () -> updates[0]++;
+        target.copyFrom(new Person().setName("Peter"));
+        assertThat(updates[0]).isEqualTo(1);
+        assertThat(target.hashCode()).isNotEqualTo(hash);
+    }
+
+    @Test
+    public void testDiff() {
+        Person person = new Person()
+                .setName("Hans")
+                .setAge(30)
+                .addPhones(new Person.PhoneNumber().setNumber("12345"));
+        Person other = person.deepCopy();
+        assertThat(person.diffMask(other)).isZero();
+        assertThat(person.diffPaths(other)).isEmpty();
+
+        other.setAge(31);
+        other.getPhones(0).setNumber("54321");
+        assertThat(person.diffMask(other)).isEqualTo(Person.AGE_DIFF_BIT | Person.PHONES_DIFF_BIT);
+        assertThat(person.diffPaths(other)).containsExactly("age", "phones[0].number");
+    }
+
+    @Test
+    public void testFieldMemory() throws IOException, NoSuchFieldException {
+        PlainCounter plain = new PlainCounter()
+                .setCount(1).setTotal(2L).setRatio(0.5).setActive(true).setLabel("plain").setMode(Mode.RUNNING)
+                .setChild(new PlainCounter().setCount(2)).addSamples(3).setNumber(4L);
+        PlainCounter parsedPlain = new PlainCounter(newInstance(plain.toByteArray()), getEmptyRegistry());
+        assertThat(parsedPlain).isEqualTo(plain);
+        assertThat(parsedPlain.getChild().getCount()).isEqualTo(2);
+        parsedPlain.clearCount().setFieldByNumber(PlainCounter.TOTAL_FIELD_NUMBER, 5L);
+        assertThat(parsedPlain.getCount()).isZero();
+        assertThat(parsedPlain.getTotal()).isEqualTo(5L);
+        assertThat(parsedPlain.getNumber()).isEqualTo(4L);
+
+        VolatileCounter volatileCounter = new VolatileCounter()
+                .setCount(1).setTotal(2L).setRatio(0.5).setActive(true).setLabel("volatile").setMode(Mode.RUNNING)
+                .setChild(new VolatileCounter().setCount(2)).addSamples(3).setText("four");
+        VolatileCounter parsedVolatile = new VolatileCounter(newInstance(volatileCounter.toByteArray()),
+                getEmptyRegistry());
+        assertThat(parsedVolatile).isEqualTo(volatileCounter);
+        assertThat(parsedVolatile.getChild().getCount()).isEqualTo(2);
+        parsedVolatile.clearCount().setFieldByNumber(VolatileCounter.TOTAL_FIELD_NUMBER, 5L);
+        assertThat(parsedVolatile.getCount()).isZero();
+        assertThat(parsedVolatile.getTotal()).isEqualTo(5L);
+        assertThat(parsedVolatile.getText()).isEqualTo("four");
+
+        ReleaseAcquireCounter releaseAcquire = new ReleaseAcquireCounter()
+                .setCount(1).setTotal(2L).setRatio(0.5).setActive(true).setLabel("release").setMode(Mode.RUNNING)
+                .setChild(new ReleaseAcquireCounter().setCount(2)).addSamples(3).setNumber(4L);
+        ReleaseAcquireCounter parsedReleaseAcquire = new ReleaseAcquireCounter(
+                newInstance(releaseAcquire.toByteArray()), getEmptyRegistry());
+        assertThat(parsedReleaseAcquire).isEqualTo(releaseAcquire);
+        assertThat(parsedReleaseAcquire.getChild().getCount()).isEqualTo(2);
+        assertThat(parsedReleaseAcquire.getMode()).isEqualTo(Mode.RUNNING);
+        parsedReleaseAcquire.clearCount().clearChild().setFieldByNumber(ReleaseAcquireCounter.TOTAL_FIELD_NUMBER, 5L);
+        assertThat(parsedReleaseAcquire.getCount()).isZero();
+        assertThat(parsedReleaseAcquire.hasChild()).isFalse();
+        assertThat(parsedReleaseAcquire.getTotal()).isEqualTo(5L);
+        assertThat(parsedReleaseAcquire.getLabel()).isEqualTo("release");
+        int hash = parsedReleaseAcquire.hashCode();
+        parsedReleaseAcquire.setFieldByNumber(ReleaseAcquireCounter.LABEL_FIELD_NUMBER, "acquire");
+        assertThat(parsedReleaseAcquire.getLabel()).isEqualTo("acquire");
+        assertThat(parsedReleaseAcquire.hashCode()).isNotEqualTo(hash);
+        assertThat(new ReleaseAcquireCounter().copyFrom(parsedReleaseAcquire)).isEqualTo(parsedReleaseAcquire);
+        ReleaseAcquireCounter fromJson = new ReleaseAcquireCounter();
+        fromJson.updateFromJson(new StringReader(parsedReleaseAcquire.toJson()));
+        assertThat(fromJson).isEqualTo(parsedReleaseAcquire);
+
+        // plain also drops the default volatile of strings, release_acquire goes through VarHandles instead
+        assertThat(Modifier.isVolatile(PlainCounter.class.getDeclaredField("label_").getModifiers())).isFalse();
+        assertThat(Modifier.isVolatile(VolatileCounter.class.getDeclaredField("count_").getModifiers())).isTrue();
+        assertThat(Modifier.isVolatile(ReleaseAcquireCounter.class.getDeclaredField("label_").getModifiers()))
+                .isFalse();
+    }
+
+    @Test
+    public void testFreeze() {
+        Person person = new Person()
+                .setName("Hans")
+                .addFriendIds("Peter")
+                .addFriendIds2(UUID.randomUUID())
+                .addFavoriteNumber(7)
+                .addPhones(new Person.PhoneNumber().setNumber("12345"))
+                .addPhones(new Person.PhoneNumber().setNumber("67890"));
+        Person snapshot = person.freeze();
+        assertThat(snapshot.isFrozen()).isTrue();
+        assertThat(person.isFrozen()).isFalse();
+        assertThat(snapshot).isEqualTo(person);
+        assertThat(person.freeze()).isSameAs(snapshot);
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.clear());
+
+        // the setters reject a snapshot before they write anything
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.setName("Peter"));
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.clearAge());
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.addFriendIds("Paul"));
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.addFavoriteNumber(8));
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.clearPhones());
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.getPhones(0).setNumber("54321"));
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.getFriendIdsList().add("Paul"));
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.getFriendIds2List().clear());
+        assertThrows(UnsupportedOperationException.class, () -> snapshot.getFavoriteNumberList().add(8));
+        assertThrows(UnsupportedOperationException.class,
+                () -> snapshot.getPhonesList().add(new Person.PhoneNumber()));
+        assertThat(snapshot).isEqualTo(person);
+        assertThat(snapshot.getName()).isEqualTo("Hans");
+        assertThat(snapshot.getPhones(0).getNumber()).isEqualTo("12345");
+
+        person.getPhones(1).setNumber("54321");
+        Person next = person.freeze();
+        assertThat(next).isNotSameAs(snapshot);
+        assertThat(next.getPhones(0)).isSameAs(snapshot.getPhones(0));
+        assertThat(next.getPhones(1).getNumber()).isEqualTo("54321");
+        assertThat(snapshot.getPhones(1).getNumber()).isEqualTo("67890");
+    }
+
+    @Test
+    public void testSeqLock() {
+        Person.PhoneNumber phone = new Person.PhoneNumber().setNumber("12345");
+        String[] number = new String[1];
+        phone.readConsistent(p -> number[0] = p.getNumber());
+        assertThat(number[0]).isEqualTo("12345");
+
+        // a write while reading invalidates the read
+        assertThat(phone.tryRead(p -> p.setNumber("54321"))).isFalse();
+        assertThat(phone.tryRead(p -> number[0] = p.getNumber())).isTrue();
+        assertThat(number[0]).isEqualTo("54321");
+    }
+
+    @Test
+    public void testJson() {
+        Person person = new Person()
+                .setName("Hans \"Hansi\"")
+                .setAge(30)
+                .addPhones(new Person.PhoneNumber().setNumber("12345"))
+                .addFavoriteNumber(7)
+                .addFavoriteNumber(-1)
+                .setLastUpdated(new com.google.protobuf.Timestamp().setSeconds(63158400L).setNanos(20000000));
+        assertThat(person.toJson()).isEqualTo("{\"name\":\"Hans \\\"Hansi\\\"\",\"age\":30,"
+                + "\"phones\":[{\"number\":\"12345\"}],\"favoriteNumber\":[7,-1],"
+                + "\"lastUpdated\":\"1972-01-02T00:00:00.020Z\"}");
+        assertThat(new Person().toJson()).isEqualTo("{}");
+    }
+
+    @Test
+    public void testUpdateFromJson() throws IOException {
+        Person person = new Person()
+                .setName("Hans \"Hansi\"")
+                .setAge(30)
+                .addPhones(new Person.PhoneNumber().setNumber("12345"))
+                .addFavoriteNumber(7)
+                .setLastUpdated(new com.google.protobuf.Timestamp().setSeconds(63158400L).setNanos(20000000));
+        Person other = new Person().setEmail("hans@example.com");
+        other.updateFromJson(new StringReader(person.toJson()));
+        assertThat(other).isEqualTo(person);
+
+        other.updateFromJson(new StringReader("{\"age\": \"31\", \"unknown\": [1, {\"a\": null}], \"favoriteNumber\": null}"));
+        assertThat(other.getAge()).isEqualTo(31);
+        assertThat(other.getName()).isNull();
+        assertThat(other.getFavoriteNumberList()).isEmpty();
+        assertThrows(InvalidProtocolBufferException.class, () -> other.updateFromJson(new StringReader("{\"age\": 1.5}")));
+
+        // updateFromJson notifies like the setters do
+        int hash = other.hashCode();
+        int[] updates = new int[1];
+        other.updateReceiver = () -> updates[0]++;
+        other.updateFromJson(new StringReader("{\"name\": \"Peter\"}"));
+        assertThat(updates[0]).isEqualTo(1);
+        assertThat(other.hashCode()).isNotEqualTo(hash);
+
+        // numbers longer than the initial token buffer
+        Setting setting = new Setting();
+        setting.updateFromJson(new StringReader("{\"doubleValue\": 0.1000000000000000055511151231257827021181583404541015625}"));
+        assertThat(setting.getDoubleValue()).isEqualTo(0.1);
+    }
+
+    @Test
+    public void testFieldByNumber() {
+        Person person = new Person().setName("Hans").setAge(30);
+        assertThat(person.getFieldByNumber(Person.NAME_FIELD_NUMBER)).isEqualTo("Hans");
+        assertThat(person.getIntFieldByNumber(Person.AGE_FIELD_NUMBER)).isEqualTo(30);
+
+        person.setFieldByNumber(Person.NAME_FIELD_NUMBER, "Peter");
+        person.setFieldByNumber(Person.FAVORITENUMBER_FIELD_NUMBER, java.util.Arrays.asList(1, 2));
+        person.setIntFieldByNumber(Person.AGE_FIELD_NUMBER, 31);
+        assertThat(person.getName()).isEqualTo("Peter");
+        assertThat(person.getFavoriteNumberList()).containsExactly(1, 2);
+        assertThat(person.getAge()).isEqualTo(31);
+
+        assertThrows(IllegalArgumentException.class, () -> person.getFieldByNumber(1000));
+        assertThrows(IllegalArgumentException.class, () -> person.getLongFieldByNumber(Person.AGE_FIELD_NUMBER));
+
+        // a field replaced by its own list keeps its elements
+        person.setFieldByNumber(Person.FAVORITENUMBER_FIELD_NUMBER,
+                person.getFieldByNumber(Person.FAVORITENUMBER_FIELD_NUMBER));
+        assertThat(person.getFavoriteNumberList()).containsExactly(1, 2);
+
+        // values are checked before anything is written
+        assertThrows(IllegalArgumentException.class, () -> person.setFieldByNumber(Person.AGE_FIELD_NUMBER, "32"));
+        assertThrows(IllegalArgumentException.class, () -> person.setFieldByNumber(Person.AGE_FIELD_NUMBER, null));
+        assertThrows(IllegalArgumentException.class,
+                () -> person.setFieldByNumber(Person.FAVORITENUMBER_FIELD_NUMBER, java.util.Arrays.asList(3, "4")));
+        assertThrows(IllegalArgumentException.class,
+                () -> person.setFieldByNumber(Person.PHONES_FIELD_NUMBER, "12345"));
+        assertThat(person.getAge()).isEqualTo(31);
+        assertThat(person.getFavoriteNumberList()).containsExactly(1, 2);
+        Person snapshot = person.freeze();
+        assertThrows(IllegalArgumentException.class, () -> person.setFieldByNumber(1000, "x"));
+        assertThrows(IllegalArgumentException.class, () -> snapshot.setFieldByNumber(1000, "x"));
+        assertThat(person.freeze()).isSameAs(snapshot);
+    }
+
+    @Test
+    public void testLazyDescriptors() throws Exception {
+        // the other tests already initialized the classes, a loader of its own shows what LazyDescriptorsUse loads
+        RecordingClassLoader loader = new RecordingClassLoader();
+        ((Runnable) loader.loadClass(LazyDescriptorsUse.class.getName()).getConstructor().newInstance()).run();
+        assertThat(loader.defined).contains("com.example.tutorial.Person", "com.example.tutorial.Setting")
+                .doesNotContain("com.example.tutorial.AddressBookProtos", "com.example.tutorial.Person$DescriptorHolder");
+
+        loader.loadClass("com.example.tutorial.Person").getMethod("getDescriptor").invoke(null);
+        assertThat(loader.defined).contains("com.example.tutorial.AddressBookProtos");
+
+        assertThat(Person.getDescriptor().getFullName()).isEqualTo("tutorial.Person");
+        assertThat(Person.PhoneNumber.getDescriptor().getContainingType()).isSameAs(Person.getDescriptor());
+        assertThat(new AddressBook().getDescriptorForType()).isSameAs(AddressBook.getDescriptor());
+    }
+
+    /**
+     * Builds, serializes, parses, compares and hashes messages of the lazy_descriptors addressbook.proto.
+     */
+    public static final class LazyDescriptorsUse implements Runnable {
+        @Override
+        public void run() {
+            Person person = new Person().setName("Hans").setAge(30).addFavoriteNumber(7);
+            Setting setting = new Setting().setKey("volume").setDoubleValue(0.5);
+            try {
+                if (!new Person(newInstance(person.toByteArray()), getEmptyRegistry()).equals(person)
+                        || new Setting(newInstance(setting.toByteArray()), getEmptyRegistry()).hashCode()
+                        != setting.hashCode()) {
+                    throw new AssertionError("round trip failed");
+                }
+            } catch (IOException e) {
+                throw new UncheckedIOException(e);
+            }
+        }
+    }
+
+    /**
+     * Defines the com.example.tutorial classes and {@link LazyDescriptorsUse} itself instead of asking its parent,
+     * and records their names. Everything else, e.g. the converters, comes from the parent.
+     */
+    private static final class RecordingClassLoader extends URLClassLoader {
+        private final Set<String> defined = ConcurrentHashMap.newKeySet();
+
+        RecordingClassLoader() {
+            super(new URL[]{ProtoLeoTest.class.getProtectionDomain().getCodeSource().getLocation()},
+                    ProtoLeoTest.class.getClassLoader());
+        }
+
+        @Override
+        protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+            if (!name.startsWith("com.example.tutorial.") && !name.equals(LazyDescriptorsUse.class.getName())) {
+                return super.loadClass(name, resolve);
+            }
+            synchronized (getClassLoadingLock(name)) {
+                Class<?> loaded = findLoadedClass(name);
+                if (loaded == null) {
+                    loaded = findClass(name);
+                    defined.add(name);
+                }
+                if (resolve) {
+                    resolveClass(loaded);
+                }
+                return loaded;
+            }
+        }
+    }
+
+    @Test
+    public void testLean() throws InvalidProtocolBufferException {
+        LeanPerson person = new LeanPerson().setName("Hans").setAge(30).setKind(LeanPerson.Kind.FAMILY)
+                .addAddresses(new LeanPerson.Address().setStreet("Main Street")).addScores(42L);
+        assertThat(person).isNotInstanceOf(com.google.protobuf.Message.class);
+
+        LeanPerson parsed = LeanPerson.parseFrom(person.toByteArray());
+        assertThat(parsed).isEqualTo(person);
+        assertThat(parsed.hashCode()).isEqualTo(person.hashCode());
+        assertThat(parsed.getAddresses(0).getStreet()).isEqualTo("Main Street");
+        assertThat(parsed.freeze().getScoresList()).containsExactly(42L);
+        assertThat(LeanPerson.Kind.getDescriptor().getFullName()).isEqualTo("tutorial.lean.LeanPerson.Kind");
+    }
+
+    @Test
+    public void testUnknownFields() throws InvalidProtocolBufferException {
+        byte[] bytes = new Person().setAge(30).toByteArray();
+
+        AddressBook addressBook = AddressBook.parseFrom(bytes);
+        assertThat(addressBook.getUnknownFields().hasField(Person.AGE_FIELD_NUMBER)).isTrue();
+        assertThat(addressBook.toByteArray()).isEqualTo(bytes);
+
+        // PhoneNumber uses msg_discard_unknown_fields
+        Person.PhoneNumber phoneNumber = Person.PhoneNumber.parseFrom(bytes);
+        assertThat(phoneNumber.getUnknownFields().asMap()).isEmpty();
+        assertThat(phoneNumber.getSerializedSize()).isZero();
+    }
+
+    @Test
+    public void testRepeatedClearedInPlace() throws IOException {
+        Person person = new Person()
+                .addPhones(new Person.PhoneNumber().setNumber("12345"))
+                .addFavoriteNumber(14).addFavoriteNumber(15);
+        byte[] bytes = person.toByteArray();
+        // the getters return views of the lists the message keeps
+        java.util.List<Person.PhoneNumber> phones = person.getPhonesList();
+        java.util.List<Integer> favoriteNumbers = person.getFavoriteNumberList();
+
+        person.clear();
+        assertThat(phones).isEmpty();
+        assertThat(favoriteNumbers).isEmpty();
+        person.updateFrom(newInstance(bytes), getEmptyRegistry());
+        assertThat(phones).hasSize(1);
+        assertThat(favoriteNumbers).containsExactly(14, 15);
+
+        person.clear();
+        person.addPhones(new Person.PhoneNumber()).clearPhones().addPhones(new Person.PhoneNumber());
+        assertThat(phones).hasSize(1);
+
+        // lists above the trim threshold are replaced instead of kept
+        for (int i = 0; i <= 1024; i++) {
+            person.addFavoriteNumber(i);
+        }
+        person.clear();
+        assertThat(favoriteNumbers).hasSize(1025);
+        assertThat(person.getFavoriteNumberList()).isEmpty();
+    }
+
+    @Test
+    public void testRepeatedAllocatedOnFirstWrite() throws IOException {
+        Person person = new Person();
+        assertThat(person.getPhonesList()).isSameAs(new Person().getPhonesList());
+        assertThat(person.getFavoriteNumberList()).isSameAs(new Person().getFavoriteNumberList());
+
+        person.addPhones(new Person.PhoneNumber()).addFavoriteNumber(14);
+        assertThat(person.getPhonesList()).hasSize(1).isNotSameAs(new Person().getPhonesList());
+        assertThat(new Person().getPhonesList()).isEmpty();
+
+        // empty or not, the lists are only changed through the message
+        assertThrows(UnsupportedOperationException.class, () -> person.getFavoriteNumberList().add(15));
+        assertThrows(UnsupportedOperationException.class, () -> person.getPhonesList().clear());
+        assertThrows(UnsupportedOperationException.class, () -> person.getFriendIdsList().add("Paul"));
+        assertThrows(UnsupportedOperationException.class, () -> new Person().getFavoriteNumberList().add(15));
+
+        Person copy = new Person(newInstance(person.toByteArray()), getEmptyRegistry());
+        assertThat(copy).isEqualTo(person);
+        assertThat(person.deepCopy().getFriendIdsList()).isSameAs(new Person().getFriendIdsList());
+    }
+
+    @Test
+    public void testInternedStrings() throws IOException {
+        // friendIds uses the intern option
+        byte[] bytes = new Person().addFriendIds("Dieter").addFriendIds("Dieter").toByteArray();
+        Person first = new Person(newInstance(bytes), getEmptyRegistry());
+        Person second = new Person(newInstance(bytes), getEmptyRegistry());
+        assertThat(first.getFriendIds(0)).isEqualTo("Dieter")
+                .isSameAs(first.getFriendIds(1))
+                .isSameAs(second.getFriendIds(0));
+    }
+
+    @Test
+    public void testUuidCodec() throws IOException {
+        // friendIds2 uses the built-in UUID codec, id the ProtoConverter_JAVA_UTIL_UUID of the tests, which takes
+        // precedence without builtin_codec. Both write the canonical string.
+        UUID id = UUID.randomUUID();
+        Person person = new Person().setId(id).addFriendIds2(id);
+        byte[] bytes = person.toByteArray();
+        byte[] expected = new byte[bytes.length];
+        CodedOutputStream output = CodedOutputStream.newInstance(expected);
+        output.writeString(1, id.toString());
+        output.writeString(7, id.toString());
+        assertThat(bytes).isEqualTo(expected);
+        assertEquals(person, new Person(newInstance(bytes), getEmptyRegistry()));
+
+        // upper case digits are accepted like UUID.fromString does
+        output = CodedOutputStream.newInstance(expected);
+        output.writeString(7, id.toString().toUpperCase());
+        assertEquals(id, new Person(newInstance(expected, 0, output.getTotalBytesWritten()), getEmptyRegistry())
+                .getFriendIds2(0));
+
+        output = CodedOutputStream.newInstance(expected);
+        output.writeString(7, "not-a-uuid");
+        byte[] invalid = expected;
+        int length = output.getTotalBytesWritten();
+        assertThrows(InvalidProtocolBufferException.class,
+                () -> new Person(newInstance(invalid, 0, length), getEmptyRegistry()));
+    }
+
+    @Test
+    public void testStreamConverter() throws IOException {
+        // PhoneNumber.type is written through the converter's write/size
+        Person.PhoneNumber phone = new Person.PhoneNumber().setNumber("12345").setType(CustomPhoneType.WORK);
+        byte[] bytes = phone.toByteArray();
+        byte[] expected = new byte[bytes.length];
+        CodedOutputStream output = CodedOutputStream.newInstance(expected);
+        output.writeString(1, "12345");
+        output.writeEnum(2, CustomPhoneType.WORK.protoNumber);
+        assertThat(bytes).isEqualTo(expected);
+        assertEquals(CustomPhoneType.WORK,
+                new Person.PhoneNumber(newInstance(bytes), getEmptyRegistry()).getType());
+    }
+
+    @Test
+    public void testInPlaceConverter() throws IOException {
+        // AddressBook.owner is merged into the existing CustomOwnerClass
+        CustomOwnerClass owner = new CustomOwnerClass("a@a.de");
+        AddressBook addressBook = new AddressBook().setOwner(owner);
+        addressBook.updateFrom(newInstance(new AddressBook()
+                .setOwner(new CustomOwnerClass("b@b.de")).toByteArray()), getEmptyRegistry());
+        assertThat(addressBook.getOwner()).isSameAs(owner);
+        assertThat(owner.email).isEqualTo("b@b.de");
+
+        addressBook.updateFrom(newInstance(new AddressBook().toByteArray()), getEmptyRegistry());
+        assertThat(addressBook.hasOwner()).isFalse();
+    }
+
+    @Test
+    public void testUnboxedWellKnownTypes() throws IOException {
+        // Session uses msg_unbox_well_known_types, the wire format is the same as for the messages
+        Session session = new Session()
+                .setStarted(Instant.ofEpochSecond(63158400L, 20000000))
+                .setLength(Duration.ofMillis(-1500))
+                .setRetries(3)
+                .setDevice("phone");
+        byte[] bytes = session.toByteArray();
+        byte[] expected = new byte[bytes.length];
+        CodedOutputStream output = CodedOutputStream.newInstance(expected);
+        output.writeMessage(1, new com.google.protobuf.Timestamp().setSeconds(63158400L).setNanos(20000000));
+        output.writeMessage(2, new com.google.protobuf.Duration().setSeconds(-1).setNanos(-500000000));
+        output.writeMessage(3, new Int32Value().setValue(3));
+        output.writeMessage(4, new StringValue().setValue("phone"));
+        assertThat(bytes).isEqualTo(expected);
+        assertEquals(session, new Session(newInstance(bytes), getEmptyRegistry()));
+
+        // seconds java.time can't hold fail like any other malformed input
+        byte[] outOfRange = new byte[64];
+        output = CodedOutputStream.newInstance(outOfRange);
+        output.writeMessage(1, new com.google.protobuf.Timestamp().setSeconds(Long.MAX_VALUE));
+        int timestampLength = output.getTotalBytesWritten();
+        assertThrows(InvalidProtocolBufferException.class,
+                () -> new Session(newInstance(outOfRange, 0, timestampLength), getEmptyRegistry()));
+        output = CodedOutputStream.newInstance(outOfRange);
+        output.writeMessage(2, new com.google.protobuf.Duration().setSeconds(Long.MAX_VALUE).setNanos(1_000_000_000));
+        int durationLength = output.getTotalBytesWritten();
+        assertThrows(InvalidProtocolBufferException.class,
+                () -> new Session(newInstance(outOfRange, 0, durationLength), getEmptyRegistry()));
+    }
+
+    @Test
+    public void testOneofBits() throws IOException {
+        Setting setting = new Setting().setKey("volume").setDoubleValue(-0.5);
+        assertThat(setting.getDoubleValue()).isEqualTo(-0.5);
+        assertThat(setting.getLongValue()).isEqualTo(0L);
+        setting.setStringValue("loud");
+        assertThat(setting.getValueCase()).isEqualTo(Setting.ValueCase.STRING_VALUE);
+        setting.setBoolValue(true);
+        assertThat(setting.getBoolValue()).isTrue();
+        assertThat(setting.getStringValue()).isNull();
+
+        setting.setLongValue(Long.MIN_VALUE);
+        Setting parsed = new Setting(newInstance(setting.toByteArray()), getEmptyRegistry());
+        assertEquals(setting, parsed);
+        assertThat(parsed.getLongValue()).isEqualTo(Long.MIN_VALUE);
+        assertThat(parsed.toJson()).isEqualTo("{\"key\":\"volume\",\"longValue\":\"-9223372036854775808\"}");
+        Setting fromJson = new Setting();
+        fromJson.updateFromJson(new StringReader(parsed.toJson()));
+        assertEquals(parsed, fromJson);
+        assertThat(parsed.diffMask(new Setting().setKey("volume").setLongValue(1L))).isEqualTo(Setting.LONG_VALUE_DIFF_BIT);
+    }
+
+    @Test
+    public void testCompactLayout() throws IOException {
+        // entity_flags.proto uses compact_layout, the bools and enums share the int with the has-bits
+        EntityFlags flags = new EntityFlags();
+        assertThat(flags.getVisible()).isTrue();
+        assertThat(flags.hasVisible()).isFalse();
+        assertThat(flags.getStance()).isEqualTo(EntityFlags.Stance.STANDING);
+
+        flags.setSolid(true).setTeam(Team.NEUTRAL).setStance(EntityFlags.Stance.PRONE).setVisible(false).setId(7);
+        assertThat(flags.getVisible()).isFalse();
+        assertThat(flags.getSolid()).isTrue();
+        assertThat(flags.getBurning()).isFalse();
+        assertThat(flags.getTeam()).isEqualTo(Team.NEUTRAL);
+        assertThat(flags.getStance()).isEqualTo(EntityFlags.Stance.PRONE);
+
+        byte[] bytes = flags.toByteArray();
+        byte[] expected = new byte[bytes.length];
+        CodedOutputStream output = CodedOutputStream.newInstance(expected);
+        output.writeBool(1, false);
+        output.writeBool(2, true);
+        output.writeEnum(4, 3);
+        output.writeEnum(5, 5);
+        output.writeInt32(6, 7);
+        assertThat(bytes).isEqualTo(expected);
+        EntityFlags parsed = new EntityFlags(newInstance(bytes), getEmptyRegistry());
+        assertEquals(flags, parsed);
+        assertThat(parsed.toJson())
+                .isEqualTo("{\"visible\":false,\"solid\":true,\"team\":\"NEUTRAL\",\"stance\":\"PRONE\",\"id\":7}");
+
+        parsed.setStance(EntityFlags.Stance.CROUCHING);
+        assertThat(flags.diffMask(parsed)).isEqualTo(EntityFlags.STANCE_DIFF_BIT);
+        parsed.clear();
+        assertThat(parsed.getVisible()).isTrue();
+        assertThat(parsed.hasTeam()).isFalse();
+        assertThat(parsed.getTeam()).isEqualTo(Team.RED);
+        assertThat(parsed.getId()).isZero();
+    }
+
+    @Test
+    public void testTable() throws IOException {
+        Person person = new Person().setName("Leo").setAge(31).setEmail("leo@example.com");
+        byte[] personBytes = person.toByteArray();
+        person.addFavoriteNumber(7);
+
+        // the Person has the msg_table option, the table keeps its scalar fields column by column
+        PersonTable table = new PersonTable(1);
+        assertThat(table.append(new Person().setAge(5))).isZero();
+        assertThat(table.appendFrom(newInstance(person.toByteArray()))).isEqualTo(1);
+        assertThat(table.size()).isEqualTo(2);
+        assertThat(table.ageColumn()).startsWith(5, 31);
+        assertThat(table.nameColumn()).startsWith("", "Leo");
+
+        // the repeated favoriteNumber has no column and was skipped
+        byte[] rowBytes = new byte[table.getRowSerializedSize(1)];
+        table.writeRowTo(CodedOutputStream.newInstance(rowBytes), 1);
+        assertThat(rowBytes).isEqualTo(personBytes);
+
+        PersonTable.Cursor cursor = table.cursor();
+        assertThat(cursor.moveTo(0).getName()).isEmpty();
+        cursor.setName("Anna").setAge(6);
+        assertThat(table.nameColumn()[0]).isEqualTo("Anna");
+        // an empty string without presence is absent like in the message
+        cursor.setName("").setEmail(null);
+        assertThat(cursor.getEmail()).isEmpty();
+        assertThat(table.getRowSerializedSize(0)).isEqualTo(new Person().setAge(6).getSerializedSize());
+        assertThrows(IndexOutOfBoundsException.class, () -> cursor.moveTo(2));
+
+        // proto2 fields keep their has-bits per row
+        EntityFlagsTable flags = new EntityFlagsTable();
+        EntityFlagsTable.Cursor flag = flags.cursor().moveTo(flags.addRow());
+        assertThat(flag.getVisible()).isTrue();
+        assertThat(flag.hasVisible()).isFalse();
+        assertThat(flag.getLabel()).isEqualTo("none");
+        flag.setLabel("").setLabel(null);
+        assertThat(flag.hasLabel()).isFalse();
+        flag.setTeam(Team.BLUE).setStance(EntityFlags.Stance.PRONE);
+        byte[] flagBytes = new byte[flags.getRowSerializedSize(0)];
+        flags.writeRowTo(CodedOutputStream.newInstance(flagBytes), 0);
+        assertEquals(new EntityFlags().setTeam(Team.BLUE).setStance(EntityFlags.Stance.PRONE),
+                new EntityFlags(newInstance(flagBytes), getEmptyRegistry()));
+
+        flags.clear();
+        assertThat(flags.size()).isZero();
+    }
+
+    @Test
+    public void testView() {
+        Envelope envelope = new Envelope()
+                .setRoute(new Route().setService("chat").setShard(-3))
+                .setSequence(42L)
+                .setPriority(Priority.HIGH)
+                .setPayload(ByteString.copyFromUtf8("hello"))
+                .addTags("a")
+                .setGroup(7L);
+        byte[] bytes = envelope.toByteArray();
+
+        // gateway.proto has the view option, the view reads the fields out of the bytes
+        EnvelopeView view = new EnvelopeView().reset(bytes);
+        assertThat(view.getSequence()).isEqualTo(42L);
+        assertThat(view.getPriority()).isEqualTo(Priority.HIGH);
+        assertThat(view.getPayload().toStringUtf8()).isEqualTo("hello");
+        assertThat(view.hasGroup()).isTrue();
+        assertThat(view.hasUser()).isFalse();
+        assertThat(view.getGroup()).isEqualTo(7L);
+        RouteView route = view.getRoute();
+        assertThat(route.getService()).isEqualTo("chat");
+        assertThat(route.getShard()).isEqualTo(-3);
+        assertThat(view.getRoute()).isSameAs(route);
+
+        // reset onto other bytes, the nested view is reused
+        envelope.clearRoute().setUser("leo");
+        ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length + 16);
+        buffer.position(8);
+        buffer.put(envelope.toByteArray()).flip().position(8);
+        view.reset(buffer);
+        assertThat(view.hasRoute()).isFalse();
+        assertThat(view.getRoute()).isNull();
+        assertThat(view.getUser()).isEqualTo("leo");
+        assertThat(view.hasGroup()).isFalse();
+        assertThat(buffer.position()).isEqualTo(8);
+
+        view.reset(bytes, 0, bytes.length - 1);
+        assertThrows(UncheckedIOException.class, view::getSequence);
+
+        // absent strings and bytes read as their proto default, like in protobuf
+        view.reset(new Envelope().setRoute(new Route()).toByteArray());
+        assertThat(view.getPayload()).isSameAs(ByteString.EMPTY);
+        assertThat(view.getUser()).isEmpty();
+        assertThat(view.getRoute().getService()).isEmpty();
+
+        // a length close to Integer.MAX_VALUE must not overflow the bounds check
+        view.reset(new byte[] {0x22, (byte) 0xFF, (byte) 0xFF, (byte) 0xFF, (byte) 0xFF, 0x07});
+        assertThrows(UncheckedIOException.class, view::getPayload);
+    }
+
+    @Test
+    public void testOffHeap() throws IOException {
+        Person person = new Person().setName("Leo").setAge(31).setEmail("leo@example.com");
+
+        // the Person has the msg_off_heap option, its records live in the direct memory of the arena
+        OffHeapArena arena = new OffHeapArena(64);
+        PersonOffHeap record = new PersonOffHeap(arena).allocate();
+        record.copyFrom(person);
+        int first = record.getOffset();
+        for (int i = 0; i < 100; i++) {
+            record.allocate().setName("person " + i).setAge(i);
+        }
+        assertThat(arena.capacity()).isGreaterThan(64);
+
+        record.moveTo(first);
+        assertThat(record.getName()).isEqualTo("Leo");
+        assertThat(record.getEmail()).isEqualTo("leo@example.com");
+        assertThat(record.toByteArray()).isEqualTo(person.toByteArray());
+
+        // a shorter value reuses the blob, a longer one gets a new one
+        int used = arena.size();
+        record.setName("Al");
+        assertThat(arena.size()).isEqualTo(used);
+        record.setName("Leopold");
+        assertThat(arena.size()).isGreaterThan(used);
+        // proto3 strings without presence are only written while they are not empty
+        record.setEmail(null);
+        assertThat(record.getEmail()).isEmpty();
+        int size = record.getSerializedSize();
+        record.setEmail("");
+        assertThat(record.getSerializedSize()).isEqualTo(size);
+
+        record.updateFrom(newInstance(person.toByteArray()));
+        assertThat(record.getName()).isEqualTo("Leo");
+        assertThat(record.getAge()).isEqualTo(31);
+        Person parsed = new Person(newInstance(record.toByteArray()), getEmptyRegistry());
+        assertEquals(person, parsed);
+
+        // proto2 fields keep their has-bits and defaults
+        EntityFlagsOffHeap flags = new EntityFlagsOffHeap(arena).allocate();
+        assertThat(flags.getVisible()).isTrue();
+        assertThat(flags.getStance()).isEqualTo(EntityFlags.Stance.STANDING);
+        flags.setVisible(false).setTeam(Team.GREEN);
+        assertThat(flags.hasSolid()).isFalse();
+        assertEquals(new EntityFlags().setVisible(false).setTeam(Team.GREEN),
+                new EntityFlags(newInstance(flags.toByteArray()), getEmptyRegistry()));
+        flags.clearVisible();
+        assertThat(flags.getVisible()).isTrue();
+        assertThat(flags.hasVisible()).isFalse();
+        assertThat(flags.getLabel()).isEqualTo("none");
+        flags.setLabel("");
+        assertThat(flags.hasLabel()).isTrue();
+        assertThat(flags.getLabel()).isEmpty();
+        assertThat(new EntityFlags(newInstance(flags.toByteArray()), getEmptyRegistry()).hasLabel()).isTrue();
+    }
+
+    @Test
+    public void testFieldMask() throws IOException {
+        Envelope envelope = new Envelope()
+                .setRoute(new Route().setService("chat").setShard(-3))
+                .setSequence(42L)
+                .setPayload(ByteString.copyFromUtf8("hello"))
+                .addTags("a")
+                .setUser("leo");
+        byte[] bytes = envelope.toByteArray();
+
+        // gateway.proto has the field_masks option, fields outside the mask are skipped and stay at their default
+        FieldMask mask = Envelope.compileMask("sequence", "route.shard", "user");
+        Envelope parsed = new Envelope().setPriority(Priority.HIGH);
+        parsed.updateFrom(newInstance(bytes), mask);
+        assertThat(parsed.getSequence()).isEqualTo(42L);
+        assertThat(parsed.getPriority()).isEqualTo(Priority.NORMAL);
+        assertThat(parsed.getPayload()).isNull();
+        assertThat(parsed.getTagsCount()).isZero();
+        assertThat(parsed.getUser()).isEqualTo("leo");
+        assertThat(parsed.getRoute().getShard()).isEqualTo(-3);
+        assertThat(parsed.getRoute().getService()).isNull();
+
+        // selecting the message as a whole wins over a nested path
+        parsed.updateFrom(newInstance(bytes), Envelope.compileMask("route", "route.shard"));
+        assertThat(parsed.getRoute()).isEqualTo(envelope.getRoute());
+        assertThat(parsed.getSequence()).isZero();
+        assertThat(parsed.getUser()).isNull();
+
+        assertThrows(IllegalArgumentException.class, () -> Envelope.compileMask("route.unknown"));
+        assertThrows(IllegalArgumentException.class, () -> Envelope.compileMask("sequence.value"));
+    }
+
+    @Test
+    public void testMaskedWriteTo() throws IOException {
+        Envelope envelope = new Envelope()
+                .setRoute(new Route().setService("chat").setShard(-3))
+                .setSequence(42L)
+                .setPayload(ByteString.copyFromUtf8("hello"))
+                .addTags("a")
+                .setUser("leo");
+
+        // the mask is compiled once and shared by all recipients, only the selected fields are written
+        FieldMask mask = Envelope.compileMask("route.service", "tags", "group");
+        byte[] bytes = new byte[envelope.getSerializedSize(mask)];
+        CodedOutputStream output = CodedOutputStream.newInstance(bytes);
+        envelope.writeTo(output, mask);
+        output.checkNoSpaceLeft();
+
+        Envelope parsed = Envelope.parseFrom(bytes);
+        assertThat(parsed.getRoute().getService()).isEqualTo("chat");
+        assertThat(parsed.getRoute().getShard()).isZero();
+        assertThat(parsed.getTags(0)).isEqualTo("a");
+        assertThat(parsed.getSequence()).isZero();
+        assertThat(parsed.getPayload()).isNull();
+        assertThat(parsed.getUser()).isNull();
+
+        FieldMask all = Envelope.compileMask("route", "sequence", "priority", "payload", "tags", "user", "group");
+        assertThat(envelope.getSerializedSize(all)).isEqualTo(envelope.getSerializedSize());
+    }
+
     @Test
     public void testHashCode() {
         AddressBook addressBook = new AddressBook();
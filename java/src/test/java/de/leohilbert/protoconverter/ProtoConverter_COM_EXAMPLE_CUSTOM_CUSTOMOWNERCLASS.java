@@ -11,5 +11,19 @@ public class ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMOWNERCLASS {
     public static Person toProto(final CustomOwnerClass obj) {
         return new Person().setEmail(obj.email);
     }
+
+    // copy_converter method
+    public static CustomOwnerClass copy(final CustomOwnerClass obj) {
+        return new CustomOwnerClass(obj.email);
+    }
+
+    // inplace_converter method, existing is null if the field was not set before
+    public static CustomOwnerClass mergeInto(final CustomOwnerClass existing, final Person obj) {
+        if (existing == null) {
+            return fromProto(obj);
+        }
+        existing.email = obj.getEmail();
+        return existing;
+    }
 }
 
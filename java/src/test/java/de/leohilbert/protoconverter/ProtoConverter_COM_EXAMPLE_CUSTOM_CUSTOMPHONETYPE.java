@@ -1,6 +1,10 @@
 package de.leohilbert.protoconverter;
 
 import com.example.custom.CustomPhoneType;
+import com.google.protobuf.CodedInputStream;
+import com.google.protobuf.CodedOutputStream;
+
+import java.io.IOException;
 
 public class ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE {
     public static CustomPhoneType fromProto(final int readEnum) {
@@ -10,4 +14,18 @@ public class ProtoConverter_COM_EXAMPLE_CUSTOM_CUSTOMPHONETYPE {
     public static int toProto(final CustomPhoneType type_) {
         return type_.protoNumber;
     }
+
+    // stream_converter methods
+    public static CustomPhoneType read(final CodedInputStream input) throws IOException {
+        return CustomPhoneType.forNumber(input.readEnum());
+    }
+
+    public static void write(final CodedOutputStream output, final int fieldNumber, final CustomPhoneType type_)
+            throws IOException {
+        output.writeEnum(fieldNumber, type_.protoNumber);
+    }
+
+    public static int size(final CustomPhoneType type_) {
+        return CodedOutputStream.computeEnumSizeNoTag(type_.protoNumber);
+    }
 }
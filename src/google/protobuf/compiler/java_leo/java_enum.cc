@@ -205,6 +205,29 @@ void EnumGenerator::Generate(io::Printer* printer) {
                    StrCat(canonical_values_[i]->number()));
   }
 
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "    default: return null;\n"
+      "  }\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * @param name The name of the enum entry as written in the .proto file.\n"
+      " * @return The enum with the given name, or null if there is none.\n"
+      " */\n"
+      "public static $classname$ forName(java.lang.String name) {\n"
+      "  switch (name) {\n",
+      "classname", descriptor_->name());
+  printer->Indent();
+  printer->Indent();
+
+  // aliases are accepted by name as well
+  for (int i = 0; i < descriptor_->value_count(); i++) {
+    printer->Print("case \"$name$\": return $name$;\n", "name",
+                   descriptor_->value(i)->name());
+  }
+
   printer->Outdent();
   printer->Outdent();
   printer->Print(
@@ -273,6 +296,20 @@ void EnumGenerator::Generate(io::Printer* printer) {
           "file",
           name_resolver_->GetClassName(descriptor_->file(), immutable_api_),
           "index", StrCat(descriptor_->index()));
+    } else if (IsLean(descriptor_->file())) {
+      // lean messages have no getDescriptor(), so walk down from the file
+      std::string path;
+      for (const Descriptor* parent = descriptor_->containing_type();
+           parent != NULL; parent = parent->containing_type()) {
+        path = StrCat(parent->containing_type() == NULL ? ".getMessageTypes()"
+                                                        : ".getNestedTypes()",
+                      ".get(", parent->index(), ")", path);
+      }
+      printer->Print(
+          "  return $file$.getDescriptor()$path$.getEnumTypes().get($index$);\n",
+          "file",
+          name_resolver_->GetClassName(descriptor_->file(), immutable_api_),
+          "path", path, "index", StrCat(descriptor_->index()));
     } else {
       printer->Print(
           "  return $parent$.$descriptor$.getEnumTypes().get($index$);\n",
@@ -126,12 +126,6 @@ void SetEnumVariables(const FieldDescriptor* descriptor, int messageBitIndex,
   } else {
     (*variables)["unknown"] = (*variables)["default"];
   }
-
-  if (descriptor->is_packed()) {
-    (*variables)["resetMemoized"] = "  " + (*variables)["name"] + "MemoizedSerializedSize = -1;\n";
-  } else {
-    (*variables)["resetMemoized"] = "";
-  }
 }
 
 }  // namespace
@@ -145,6 +139,7 @@ ImmutableEnumFieldGenerator::ImmutableEnumFieldGenerator(
   SetEnumVariables(descriptor, messageBitIndex, builderBitIndex,
                    context->GetFieldGeneratorInfo(descriptor), name_resolver_,
                    &variables_);
+  SetFieldMemoryVariables(descriptor, "int", false, &variables_);
 }
 
 ImmutableEnumFieldGenerator::~ImmutableEnumFieldGenerator() {}
@@ -178,7 +173,7 @@ void ImmutableEnumFieldGenerator::GenerateInterfaceMembers(
 }
 
 void ImmutableEnumFieldGenerator::GenerateMembers(io::Printer* printer) const {
-  printer->Print(variables_, "private int $name$_;\n");
+  PrintFieldDeclaration(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
   if (SupportFieldPresence(descriptor_)) {
     WriteFieldAccessorDocComment(printer, descriptor_, HAZZER);
@@ -194,7 +189,7 @@ void ImmutableEnumFieldGenerator::GenerateMembers(io::Printer* printer) const {
     printer->Print(variables_,
                    "@java.lang.Override $deprecation$public int "
                    "${$get$capitalized_name$Value$}$() {\n"
-                   "  return $name$_;\n"
+                   "  return $read_field$;\n"
                    "}\n");
     printer->Annotate("{", "}", descriptor_);
   }
@@ -203,7 +198,7 @@ void ImmutableEnumFieldGenerator::GenerateMembers(io::Printer* printer) const {
                  "@java.lang.Override $deprecation$public $type$ "
                  "${$get$capitalized_name$$}$() {\n"
                  "  @SuppressWarnings(\"deprecation\")\n"
-                 "  $type$ result = $type$.$for_number$($name$_);\n"
+                 "  $type$ result = $type$.$for_number$($read_field$);\n"
                  "  return result == null ? $unknown$ : result;\n"
                  "}\n");
   printer->Annotate("{", "}", descriptor_);
@@ -212,16 +207,18 @@ void ImmutableEnumFieldGenerator::GenerateMembers(io::Printer* printer) const {
   WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
   printer->Print(variables_,
                  "$deprecation$public $classname$ "
-                 "${$set$capitalized_name$$}$($type$ value) {\n"
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  int valueNumber = value.getNumber();\n"
                  "  $set_has_field_bit_builder$\n"
                  "  if($name$_ != valueNumber) {\n"
-                 "    $name$_ = valueNumber;\n"
+                 "    $store_prefix$valueNumber$store_suffix$;\n"
                  "    $on_changed$\n"
-                 "  }\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableEnumFieldGenerator::GenerateInitializationCode(
@@ -257,6 +254,53 @@ void ImmutableEnumFieldGenerator::GenerateMergingCode(
   }
 }
 
+void ImmutableEnumFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$store_prefix$other.$name$_$store_suffix$;\n");
+}
+
+void ImmutableEnumFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$name$_", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableEnumFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 ("$set_has_field_bit_message$\n"
+                  "$store_prefix$" +
+                  JsonValueReader(descriptor_, name_resolver_) +
+                  "$store_suffix$;\n")
+                     .c_str());
+}
+
+void ImmutableEnumFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckByNumber(descriptor_, variables_.at("type"), false, printer);
+}
+
+void ImmutableEnumFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  // the setter stores with the field memory semantics and notifies
+  printer->Print(variables_, "set$capitalized_name$(($type$) value);\n");
+}
+
+void ImmutableEnumFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($name$_ != other.$name$_) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableEnumFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (SupportUnknownEnumValue(descriptor_->file())) {
@@ -269,8 +313,12 @@ void ImmutableEnumFieldGenerator::GenerateParsingCode(
                    "int rawValue = input.readEnum();\n"
                    "  @SuppressWarnings(\"deprecation\")\n"
                    "$type$ value = $type$.$for_number$(rawValue);\n"
-                   "if (value == null) {\n"
-                   "  unknownFields.mergeVarintField($number$, rawValue);\n"
+                   "if (value == null) {\n");
+    printer->Indent();
+    PrintMergeUnknownField(descriptor_, StrCat("mergeVarintField(",
+                           descriptor_->number(), ", rawValue)"), printer);
+    printer->Outdent();
+    printer->Print(variables_,
                    "} else {\n"
                    "  $set_has_field_bit_message$\n"
                    "  $name$_ = rawValue;\n"
@@ -370,26 +418,31 @@ void ImmutableEnumOneofFieldGenerator::GenerateMembers(
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ "
-                 "${$set$capitalized_name$$}$($type$ value) {\n"
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  $set_oneof_case_message$;\n"
                  "  $oneof_name$_ = value.getNumber();\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER,
       /* builder */ true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(
+      variables_,
       "  if ($has_oneof_case_message$) {\n"
       "    $clear_oneof_case_message$;\n"
       "    $oneof_name$_ = null;\n"
       "    $on_changed$\n"
-      "  }\n"
-      "  return this;\n"
-      "}\n");
-  printer->Annotate("{", "}", descriptor_);
+      "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableEnumOneofFieldGenerator::GenerateMergingCode(
@@ -404,6 +457,48 @@ void ImmutableEnumOneofFieldGenerator::GenerateMergingCode(
   }
 }
 
+void ImmutableEnumOneofFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$oneof_name$_ = other.$oneof_name$_;\n");
+}
+
+void ImmutableEnumOneofFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($has_oneof_case_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "(java.lang.Integer) $oneof_name$_", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableEnumOneofFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 ("$oneof_name$_ = " +
+                  JsonValueReader(descriptor_, name_resolver_) + ";\n"
+                  "$set_oneof_case_message$;\n")
+                     .c_str());
+}
+
+void ImmutableEnumOneofFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$oneof_name$_ = (($type$) value).getNumber();\n"
+                 "$set_oneof_case_message$;\n"
+                 "$on_changed$\n");
+}
+
+void ImmutableEnumOneofFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($oneof_name$_, other.$oneof_name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableEnumOneofFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (SupportUnknownEnumValue(descriptor_->file())) {
@@ -416,8 +511,12 @@ void ImmutableEnumOneofFieldGenerator::GenerateParsingCode(
                    "int rawValue = input.readEnum();\n"
                    "@SuppressWarnings(\"deprecation\")\n"
                    "$type$ value = $type$.$for_number$(rawValue);\n"
-                   "if (value == null) {\n"
-                   "  unknownFields.mergeVarintField($number$, rawValue);\n"
+                   "if (value == null) {\n");
+    printer->Indent();
+    PrintMergeUnknownField(descriptor_, StrCat("mergeVarintField(",
+                           descriptor_->number(), ", rawValue)"), printer);
+    printer->Outdent();
+    printer->Print(variables_,
                    "} else {\n"
                    "  $set_oneof_case_message$;\n"
                    "  $oneof_name$_ = rawValue;\n"
@@ -475,6 +574,200 @@ void ImmutableEnumOneofFieldGenerator::GenerateHashCode(
 
 // ===================================================================
 
+ImmutableCompactEnumFieldGenerator::ImmutableCompactEnumFieldGenerator(
+    const FieldDescriptor* descriptor, int messageBitIndex, int builderBitIndex,
+    Context* context)
+    : ImmutableEnumFieldGenerator(descriptor, messageBitIndex, builderBitIndex,
+                                  context),
+      value_bit_index_(CompactValueBitIndex(descriptor, messageBitIndex)),
+      width_(CompactBitWidth(descriptor)) {
+  num_bits_ = value_bit_index_ + width_ - messageBitIndex;
+  variables_["read_field"] = GenerateGetBits(value_bit_index_, width_);
+  // compact enums are closed, so they always have a has-bit
+  variables_["clear_has_field_bit_message"] =
+      GenerateClearBit(messageBitIndex) + ";";
+}
+
+ImmutableCompactEnumFieldGenerator::~ImmutableCompactEnumFieldGenerator() {}
+
+int ImmutableCompactEnumFieldGenerator::GetNumBitsForMessage() const {
+  return num_bits_;
+}
+
+int ImmutableCompactEnumFieldGenerator::GetNumBitsForBuilder() const {
+  // keeps the builder bits of the following fields in line with their has-bits
+  return num_bits_;
+}
+
+void ImmutableCompactEnumFieldGenerator::PrintStore(
+    io::Printer* printer, const std::string& value) const {
+  printer->Print(
+      variables_,
+      (GenerateSetBits(value_bit_index_, width_, value) + ";\n").c_str());
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateMembers(
+    io::Printer* printer) const {
+  PrintExtraFieldInfo(variables_, printer);
+  WriteFieldAccessorDocComment(printer, descriptor_, HAZZER);
+  printer->Print(variables_,
+                 "@java.lang.Override $deprecation$public boolean "
+                 "${$has$capitalized_name$$}$() {\n"
+                 "  return $get_has_field_bit_message$;\n"
+                 "}\n");
+  printer->Annotate("{", "}", descriptor_);
+
+  WriteFieldAccessorDocComment(printer, descriptor_, GETTER);
+  printer->Print(variables_,
+                 "@java.lang.Override $deprecation$public $type$ "
+                 "${$get$capitalized_name$$}$() {\n"
+                 "  @SuppressWarnings(\"deprecation\")\n"
+                 "  $type$ result = $type$.$for_number$($read_field$);\n"
+                 "  return result == null ? $unknown$ : result;\n"
+                 "}\n");
+  printer->Annotate("{", "}", descriptor_);
+
+  WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
+  printer->Print(variables_,
+                 "$deprecation$public $classname$ "
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  int valueNumber = value.getNumber();\n"
+                 "  $set_has_field_bit_message$\n"
+                 "  if ($read_field$ != valueNumber) {\n");
+  printer->Indent();
+  printer->Indent();
+  PrintStore(printer, "valueNumber");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(variables_,
+                 "    $on_changed$\n"
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateInitializationCode(
+    io::Printer* printer) const {
+  if (descriptor_->default_value_enum()->number() != 0) {
+    PrintStore(printer, variables_.at("default_number"));
+  }
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateClearCode(
+    io::Printer* printer) const {
+  PrintStore(printer, variables_.at("default_number"));
+  printer->Print(variables_, "$clear_has_field_bit_message$\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateToStringCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "sb.append(\"\\\"$name$\\\": \\\"\").append(java.lang.String.valueOf($read_field$)).append(\"\\\",\\n\");\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  // the value is copied along with the bitfields
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$read_field$", name_resolver_)
+                     .c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  // numbers the enum doesn't know would not fit into the bits, they are
+  // skipped like unknown fields
+  printer->Print(variables_,
+                 ("int rawValue = " +
+                  JsonValueReader(descriptor_, name_resolver_) + ";\n"
+                  "@SuppressWarnings(\"deprecation\")\n"
+                  "$type$ value = $type$.$for_number$(rawValue);\n"
+                  "if (value != null) {\n"
+                  "  $set_has_field_bit_message$\n")
+                     .c_str());
+  printer->Indent();
+  PrintStore(printer, "rawValue");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "set$capitalized_name$(($type$) value);\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (get$capitalized_name$() != other.get$capitalized_name$()) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "int rawValue = input.readEnum();\n"
+                 "@SuppressWarnings(\"deprecation\")\n"
+                 "$type$ value = $type$.$for_number$(rawValue);\n"
+                 "if (value == null) {\n");
+  printer->Indent();
+  PrintMergeUnknownField(descriptor_, StrCat("mergeVarintField(",
+                         descriptor_->number(), ", rawValue)"), printer);
+  printer->Outdent();
+  printer->Print(variables_,
+                 "} else {\n"
+                 "  $set_has_field_bit_message$\n");
+  printer->Indent();
+  PrintStore(printer, "rawValue");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateSerializationCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  output.writeEnum($number$, $read_field$);\n"
+                 "}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateSerializedSizeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  size += com.google.protobuf.CodedOutputStream\n"
+                 "    .computeEnumSize($number$, $read_field$);\n"
+                 "}\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateEqualsCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (get$capitalized_name$() != other.get$capitalized_name$()) return false;\n");
+}
+
+void ImmutableCompactEnumFieldGenerator::GenerateHashCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "hash = (37 * hash) + $constant_name$;\n"
+                 "hash = (53 * hash) + $read_field$;\n");
+}
+
+// ===================================================================
+
 RepeatedImmutableEnumFieldGenerator::RepeatedImmutableEnumFieldGenerator(
     const FieldDescriptor* descriptor, int messageBitIndex, int builderBitIndex,
     Context* context)
@@ -482,6 +775,9 @@ RepeatedImmutableEnumFieldGenerator::RepeatedImmutableEnumFieldGenerator(
   SetEnumVariables(descriptor, messageBitIndex, builderBitIndex,
                    context->GetFieldGeneratorInfo(descriptor), name_resolver_,
                    &variables_);
+  variables_["empty_list"] = "java.util.Collections.emptyList()";
+  variables_["shared_empty_list"] = "java.util.Collections.EMPTY_LIST";
+  variables_["create_list"] = "new java.util.ArrayList<java.lang.Integer>()";
 }
 
 RepeatedImmutableEnumFieldGenerator::~RepeatedImmutableEnumFieldGenerator() {}
@@ -491,7 +787,7 @@ int RepeatedImmutableEnumFieldGenerator::GetNumBitsForMessage() const {
 }
 
 int RepeatedImmutableEnumFieldGenerator::GetNumBitsForBuilder() const {
-  return 1;
+  return 0;
 }
 
 void RepeatedImmutableEnumFieldGenerator::GenerateInterfaceMembers(
@@ -546,6 +842,7 @@ void RepeatedImmutableEnumFieldGenerator::GenerateMembers(
       "            return result == null ? $unknown$ : result;\n"
       "          }\n"
       "        };\n");
+  PrintEnsureRepeatedFieldMutable(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_GETTER);
   printer->Print(
@@ -578,10 +875,10 @@ void RepeatedImmutableEnumFieldGenerator::GenerateMembers(
     printer->Print(variables_,
                    "@java.lang.Override\n"
                    "$deprecation$public java.util.List<java.lang.Integer>\n"
-                   "${$get$capitalized_name$ValueList$}$() {\n"
-                   "  return $name$_;\n"
-                   "}\n");
+                   "${$get$capitalized_name$ValueList$}$() {\n");
     printer->Annotate("{", "}", descriptor_);
+    PrintReturnUnmodifiableList(variables_, printer);
+    printer->Print("}\n");
     WriteFieldEnumValueAccessorDocComment(printer, descriptor_,
                                           LIST_INDEXED_GETTER);
     printer->Print(variables_,
@@ -597,39 +894,48 @@ void RepeatedImmutableEnumFieldGenerator::GenerateMembers(
         /* builder */ true);
     printer->Print(variables_,
                    "$deprecation$public $classname$ "
-                   "${$add$capitalized_name$$}$($type$ value) {\n"
-                   "  $name$_.add(value.getNumber());\n"
-                   "$resetMemoized$"
-                   "  $on_changed$\n"
-                   "  return this;\n"
-                   "}\n");
-
+                   "${$add$capitalized_name$$}$($type$ value) {\n");
     printer->Annotate("{", "}", descriptor_);
+    PrintMutatorPrologue(descriptor_, printer);
+    printer->Print(variables_,
+                   "  ensure$capitalized_name$IsMutable();\n"
+                   "  $name$_.add(value.getNumber());\n");
+    PrintResetMemoizedSize(descriptor_, variables_, printer);
+    printer->Print(variables_, "  $on_changed$\n");
+    PrintMutatorEpilogue(descriptor_, printer);
+    printer->Print("}\n");
     WriteFieldEnumValueAccessorDocComment(printer, descriptor_, LIST_ADDER,
         /* builder */ true);
     printer->Print(variables_,
                    "$deprecation$public $classname$ "
-                   "${$add$capitalized_name$Value$}$(int value) {\n"
-                   "  $name$_.add(value);\n"
-                   "$resetMemoized$"
-                   "  $on_changed$\n"
-                   "  return this;\n"
-                   "}\n");
+                   "${$add$capitalized_name$Value$}$(int value) {\n");
     printer->Annotate("{", "}", descriptor_);
+    PrintMutatorPrologue(descriptor_, printer);
+    printer->Print(variables_,
+                   "  ensure$capitalized_name$IsMutable();\n"
+                   "  $name$_.add(value);\n");
+    PrintResetMemoizedSize(descriptor_, variables_, printer);
+    printer->Print(variables_, "  $on_changed$\n");
+    PrintMutatorEpilogue(descriptor_, printer);
+    printer->Print("}\n");
     WriteFieldEnumValueAccessorDocComment(printer, descriptor_,
                                           LIST_MULTI_ADDER, /* builder */ true);
     printer->Print(
         variables_,
         "$deprecation$public $classname$ ${$addAll$capitalized_name$Value$}$(\n"
-        "    java.lang.Iterable<java.lang.Integer> values) {\n"
+        "    java.lang.Iterable<java.lang.Integer> values) {\n");
+    printer->Annotate("{", "}", descriptor_);
+    PrintMutatorPrologue(descriptor_, printer);
+    printer->Print(
+        variables_,
+        "  ensure$capitalized_name$IsMutable();\n"
         "  for (int value : values) {\n"
         "    $name$_.add(value);\n"
-        "  }\n"
-        "$resetMemoized$"
-        "  $on_changed$\n"
-        "  return this;\n"
-        "}\n");
-    printer->Annotate("{", "}", descriptor_);
+        "  }\n");
+    PrintResetMemoizedSize(descriptor_, variables_, printer);
+    printer->Print(variables_, "  $on_changed$\n");
+    PrintMutatorEpilogue(descriptor_, printer);
+    printer->Print("}\n");
   }
 
   if (descriptor_->is_packed()) {
@@ -639,13 +945,12 @@ void RepeatedImmutableEnumFieldGenerator::GenerateMembers(
 
 void RepeatedImmutableEnumFieldGenerator::GenerateInitializationCode(
     io::Printer* printer) const {
-  printer->Print(variables_, "$name$_ = new java.util.ArrayList<java.lang.Integer>();\n");
+  printer->Print(variables_, "$name$_ = $empty_list$;\n");
 }
 
 void RepeatedImmutableEnumFieldGenerator::GenerateClearCode(
     io::Printer* printer) const {
-  printer->Print(variables_,
-                 "$name$_ = java.util.Collections.emptyList();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
 }
 
 void RepeatedImmutableEnumFieldGenerator::GenerateToStringCode(io::Printer* printer) const {
@@ -672,16 +977,87 @@ void RepeatedImmutableEnumFieldGenerator::GenerateMergingCode(
                  "}\n");
 }
 
+void RepeatedImmutableEnumFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "if (!other.$name$_.isEmpty()) {\n"
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.addAll(other.$name$_);\n"
+                 "}\n");
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateFreezeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$name$_ = java.util.Collections.unmodifiableList($name$_);\n");
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!$name$_.isEmpty()) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n"
+                 "  out.append('[');\n"
+                 "  for (int i = 0; i < $name$_.size(); i++) {\n"
+                 "    if (i > 0) {\n"
+                 "      out.append(',');\n"
+                 "    }\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$name$_.get(i)", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print("  }\n"
+                 "  out.append(']');\n"
+                 "}\n");
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print("in.beginArray();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 ("while (in.hasNextElement()) {\n"
+                  "  ensure$capitalized_name$IsMutable();\n"
+                  "  $name$_.add(" +
+                  JsonValueReader(descriptor_, name_resolver_) + ");\n"
+                  "}\n")
+                     .c_str());
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckListByNumber(descriptor_, variables_.at("type"), printer);
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "ensure$capitalized_name$IsMutable();\n"
+                 "for ($type$ element : (java.util.List<$type$>) value) {\n"
+                 "  $name$_.add(element.getNumber());\n"
+                 "}\n"
+                 "$on_changed$\n");
+}
+
+void RepeatedImmutableEnumFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void RepeatedImmutableEnumFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   // Read and store the enum
   if (SupportUnknownEnumValue(descriptor_->file())) {
     printer->Print(variables_,
                    "int rawValue = input.readEnum();\n"
-                   "if (!$get_mutable_bit_parser$) {\n"
-                   "  $name$_ = new java.util.ArrayList<java.lang.Integer>();\n"
-                   "  $set_mutable_bit_parser$;\n"
-                   "}\n"
+                   "ensure$capitalized_name$IsMutable();\n"
                    "$name$_.add(rawValue);\n");
   } else {
     printer->Print(
@@ -689,13 +1065,15 @@ void RepeatedImmutableEnumFieldGenerator::GenerateParsingCode(
         "int rawValue = input.readEnum();\n"
         "@SuppressWarnings(\"deprecation\")\n"
         "$type$ value = $type$.$for_number$(rawValue);\n"
-        "if (value == null) {\n"
-        "  unknownFields.mergeVarintField($number$, rawValue);\n"
+        "if (value == null) {\n");
+    printer->Indent();
+    PrintMergeUnknownField(descriptor_, StrCat("mergeVarintField(",
+                           descriptor_->number(), ", rawValue)"), printer);
+    printer->Outdent();
+    printer->Print(
+        variables_,
         "} else {\n"
-        "  if (!$get_mutable_bit_parser$) {\n"
-        "    $name$_ = new java.util.ArrayList<java.lang.Integer>();\n"
-        "    $set_mutable_bit_parser$;\n"
-        "  }\n"
+        "  ensure$capitalized_name$IsMutable();\n"
         "  $name$_.add(rawValue);\n"
         "}\n");
   }
@@ -727,7 +1105,7 @@ void RepeatedImmutableEnumFieldGenerator::GenerateSerializationCode(
     io::Printer* printer) const {
   if (descriptor_->is_packed()) {
     printer->Print(variables_,
-                   "if (get$capitalized_name$List().size() > 0) {\n"
+                   "if ($name$_.size() > 0) {\n"
                    "  output.writeUInt32NoTag($tag$);\n"
                    "  output.writeUInt32NoTag($name$MemoizedSerializedSize);\n"
                    "}\n"
@@ -757,7 +1135,7 @@ void RepeatedImmutableEnumFieldGenerator::GenerateSerializedSizeCode(
   printer->Print("size += dataSize;\n");
   if (descriptor_->is_packed()) {
     printer->Print(variables_,
-                   "if (!get$capitalized_name$List().isEmpty()) {"
+                   "if (!$name$_.isEmpty()) {"
                    "  size += $tag_size$;\n"
                    "  size += com.google.protobuf.CodedOutputStream\n"
                    "    .computeUInt32SizeNoTag(dataSize);\n"
@@ -72,6 +72,12 @@ class ImmutableEnumFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
@@ -99,6 +105,11 @@ class ImmutableEnumOneofFieldGenerator : public ImmutableEnumFieldGenerator {
 
   void GenerateMembers(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
@@ -109,6 +120,43 @@ class ImmutableEnumOneofFieldGenerator : public ImmutableEnumFieldGenerator {
   GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutableEnumOneofFieldGenerator);
 };
 
+// A closed enum field of a compact_layout message, its number is stored in a
+// few bits of the shared bitfields.
+class ImmutableCompactEnumFieldGenerator : public ImmutableEnumFieldGenerator {
+ public:
+  ImmutableCompactEnumFieldGenerator(const FieldDescriptor* descriptor,
+                                     int messageBitIndex, int builderBitIndex,
+                                     Context* context);
+  ~ImmutableCompactEnumFieldGenerator();
+
+  int GetNumBitsForMessage() const;
+  int GetNumBitsForBuilder() const;
+  void GenerateMembers(io::Printer* printer) const;
+  void GenerateInitializationCode(io::Printer* printer) const;
+  void GenerateClearCode(io::Printer* printer) const;
+  void GenerateToStringCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
+  void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateSerializationCode(io::Printer* printer) const;
+  void GenerateSerializedSizeCode(io::Printer* printer) const;
+  void GenerateEqualsCode(io::Printer* printer) const;
+  void GenerateHashCode(io::Printer* printer) const;
+
+ private:
+  // Prints the statement storing the int expression value.
+  void PrintStore(io::Printer* printer, const std::string& value) const;
+
+  int value_bit_index_;
+  int width_;
+  int num_bits_;
+
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutableCompactEnumFieldGenerator);
+};
+
 class RepeatedImmutableEnumFieldGenerator : public ImmutableFieldGenerator {
  public:
   explicit RepeatedImmutableEnumFieldGenerator(
@@ -125,6 +173,13 @@ class RepeatedImmutableEnumFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateFreezeCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingCodeFromPacked(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
@@ -43,6 +43,7 @@
 #include <google/protobuf/compiler/java_leo/java_helpers.h>
 #include <google/protobuf/compiler/java_leo/java_map_field.h>
 #include <google/protobuf/compiler/java_leo/java_message_field.h>
+#include <google/protobuf/compiler/java_leo/java_name_resolver.h>
 #include <google/protobuf/compiler/java_leo/java_primitive_field.h>
 #include <google/protobuf/compiler/java_leo/java_string_field.h>
 #include <google/protobuf/io/printer.h>
@@ -102,12 +103,20 @@ ImmutableFieldGenerator* MakeImmutableGenerator(const FieldDescriptor* field,
           return new ImmutableMessageFieldGenerator(field, messageBitIndex,
                                                     builderBitIndex, context);
         case JAVATYPE_ENUM:
+          if (CompactBitWidth(field) > 0) {
+            return new ImmutableCompactEnumFieldGenerator(
+                field, messageBitIndex, builderBitIndex, context);
+          }
           return new ImmutableEnumFieldGenerator(field, messageBitIndex,
                                                  builderBitIndex, context);
         case JAVATYPE_STRING:
           return new ImmutableStringFieldGenerator(field, messageBitIndex,
                                                    builderBitIndex, context);
         default:
+          if (CompactBitWidth(field) > 0) {
+            return new ImmutableCompactBoolFieldGenerator(
+                field, messageBitIndex, builderBitIndex, context);
+          }
           return new ImmutablePrimitiveFieldGenerator(field, messageBitIndex,
                                                       builderBitIndex, context);
       }
@@ -134,6 +143,34 @@ void ImmutableFieldGenerator::GenerateParsingCodeFromPacked(
   ReportUnexpectedPackedFieldsCall(printer);
 }
 
+void ImmutableFieldGenerator::GenerateFreezeCode(
+    io::Printer* printer) const {
+  // noop for immutable values.
+}
+
+void ImmutableFieldGenerator::GenerateParsingPrologueCode(
+    io::Printer* printer) const {
+  // noop for most fields.
+}
+
+void ImmutableFieldGenerator::GenerateMaskedParsingCode(
+    io::Printer* printer) const {
+  GOOGLE_LOG(FATAL) << "GenerateMaskedParsingCode() "
+             << "called on field generator that does not support masks.";
+}
+
+void ImmutableFieldGenerator::GenerateMaskedSerializationCode(
+    io::Printer* printer) const {
+  GOOGLE_LOG(FATAL) << "GenerateMaskedSerializationCode() "
+             << "called on field generator that does not support masks.";
+}
+
+void ImmutableFieldGenerator::GenerateMaskedSerializedSizeCode(
+    io::Printer* printer) const {
+  GOOGLE_LOG(FATAL) << "GenerateMaskedSerializedSizeCode() "
+             << "called on field generator that does not support masks.";
+}
+
 ImmutableFieldLiteGenerator::~ImmutableFieldLiteGenerator() {}
 
 // ===================================================================
@@ -171,8 +208,10 @@ void SetCommonFieldVariables(const FieldDescriptor* descriptor,
   (*variables)["capitalized_name"] = info->capitalized_name;
   (*variables)["disambiguated_reason"] = info->disambiguated_reason;
   (*variables)["constant_name"] = FieldConstantName(descriptor);
+  (*variables)["diff_bit"] = FieldDiffBitName(descriptor);
   (*variables)["number"] = StrCat(descriptor->number());
   (*variables)["kt_dsl_builder"] = "_builder";
+  (*variables)["json_name"] = CEscape(descriptor->json_name());
   // These variables are placeholders to pick out the beginning and ends of
   // identifiers for annotations (when doing so with existing variables would
   // be ambiguous or impossible). They should never be set to anything but the
@@ -196,6 +235,285 @@ void SetCommonOneofVariables(const FieldDescriptor* descriptor,
       info->name + "Case_ == " + StrCat(descriptor->number());
 }
 
+void SetFieldMemoryVariables(const FieldDescriptor* descriptor,
+                             const std::string& storage_type,
+                             bool volatile_by_default,
+                             std::map<std::string, std::string>* variables) {
+  FieldMemorySemantics semantics =
+      GetFieldMemorySemantics(descriptor->containing_type());
+  std::string name = (*variables)["name"] + "_";
+  std::string handle = descriptor->name() + "_HANDLE";
+  ToUpper(&handle);
+
+  (*variables)["storage_type"] = storage_type;
+  (*variables)["var_handle"] = "";
+  (*variables)["field_modifiers"] = "";
+  (*variables)["read_field"] = name;
+  (*variables)["store_prefix"] = name + " = ";
+  (*variables)["store_suffix"] = "";
+  switch (semantics) {
+    case FIELD_MEMORY_DEFAULT:
+      if (volatile_by_default) {
+        (*variables)["field_modifiers"] = "volatile ";
+      }
+      break;
+    case FIELD_MEMORY_VOLATILE:
+      (*variables)["field_modifiers"] = "volatile ";
+      break;
+    case FIELD_MEMORY_RELEASE_ACQUIRE:
+      (*variables)["var_handle"] = handle;
+      (*variables)["read_field"] =
+          "(" + storage_type + ") " + handle + ".getAcquire(this)";
+      (*variables)["store_prefix"] = handle + ".setRelease(this, ";
+      (*variables)["store_suffix"] = ")";
+      break;
+    case FIELD_MEMORY_PLAIN:
+      break;
+  }
+}
+
+void PrintFieldDeclaration(const std::map<std::string, std::string>& variables,
+                           io::Printer* printer) {
+  printer->Print(variables,
+                 "private $field_modifiers$$storage_type$ $name$_;\n");
+  if (!variables.find("var_handle")->second.empty()) {
+    printer->Print(
+        variables,
+        "private static final java.lang.invoke.VarHandle $var_handle$ =\n"
+        "    de.leohilbert.proto.FieldHandles.find(\n"
+        "        java.lang.invoke.MethodHandles.lookup(), \"$name$_\", "
+        "$storage_type$.class);\n");
+  }
+}
+
+std::string JsonValueWriter(const FieldDescriptor* field,
+                            const std::string& value,
+                            ClassNameResolver* name_resolver) {
+  std::string writer = "de.leohilbert.proto.JsonWriter.";
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_SINT32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      return writer + "writeInt(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_FIXED32:
+      return writer + "writeUnsignedInt(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_INT64:
+    case FieldDescriptor::TYPE_SINT64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      return writer + "writeQuotedLong(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_UINT64:
+    case FieldDescriptor::TYPE_FIXED64:
+      return writer + "writeQuotedUnsignedLong(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_FLOAT:
+      return writer + "writeFloat(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_DOUBLE:
+      return writer + "writeDouble(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_BOOL:
+      return writer + "writeBool(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_STRING:
+      return writer + "writeString(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_BYTES:
+      return writer + "writeBytes(out, " + value + ");\n";
+    case FieldDescriptor::TYPE_ENUM:
+      if (field->enum_type()->full_name() == "google.protobuf.NullValue") {
+        return "out.append(\"null\");\n";
+      }
+      return writer + "writeEnum(out, " + value + ", " +
+             name_resolver->GetImmutableClassName(field->enum_type()) +
+             "::forNumber);\n";
+    case FieldDescriptor::TYPE_MESSAGE:
+    case FieldDescriptor::TYPE_GROUP:
+      return value + ".writeJson(out);\n";
+  }
+  GOOGLE_LOG(FATAL) << "Can't get here.";
+  return "";
+}
+
+std::string JsonMapKeyWriter(const FieldDescriptor* key,
+                             const std::string& value,
+                             const std::string& first) {
+  std::string writer = first + " = de.leohilbert.proto.JsonWriter.";
+  std::string args = "(out, " + first + ", " + value;
+  switch (key->type()) {
+    case FieldDescriptor::TYPE_STRING:
+      return writer + "name" + args + ");\n";
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_FIXED32:
+      return writer + "key" + args + " & 0xFFFFFFFFL);\n";
+    case FieldDescriptor::TYPE_UINT64:
+    case FieldDescriptor::TYPE_FIXED64:
+      return writer + "unsignedKey" + args + ");\n";
+    default:
+      // signed integers and bool
+      return writer + "key" + args + ");\n";
+  }
+}
+
+std::string JsonValueReader(const FieldDescriptor* field,
+                            ClassNameResolver* name_resolver) {
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_SINT32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      return "in.readInt()";
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_FIXED32:
+      return "in.readUnsignedInt()";
+    case FieldDescriptor::TYPE_INT64:
+    case FieldDescriptor::TYPE_SINT64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      return "in.readLong()";
+    case FieldDescriptor::TYPE_UINT64:
+    case FieldDescriptor::TYPE_FIXED64:
+      return "in.readUnsignedLong()";
+    case FieldDescriptor::TYPE_FLOAT:
+      return "in.readFloat()";
+    case FieldDescriptor::TYPE_DOUBLE:
+      return "in.readDouble()";
+    case FieldDescriptor::TYPE_BOOL:
+      return "in.readBool()";
+    case FieldDescriptor::TYPE_STRING:
+      return "in.readString()";
+    case FieldDescriptor::TYPE_BYTES:
+      return "in.readBytes()";
+    case FieldDescriptor::TYPE_ENUM:
+      return "in.readEnum(" +
+             name_resolver->GetImmutableClassName(field->enum_type()) +
+             "::forName)";
+    case FieldDescriptor::TYPE_MESSAGE:
+    case FieldDescriptor::TYPE_GROUP:
+      break;
+  }
+  GOOGLE_LOG(FATAL) << "Messages are read with updateFromJson.";
+  return "";
+}
+
+std::string JsonMapKeyReader(const FieldDescriptor* key,
+                             const std::string& name) {
+  switch (key->type()) {
+    case FieldDescriptor::TYPE_STRING:
+      return name;
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_FIXED32:
+      return "in.unsignedIntKey(" + name + ")";
+    case FieldDescriptor::TYPE_INT64:
+    case FieldDescriptor::TYPE_SINT64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      return "in.longKey(" + name + ")";
+    case FieldDescriptor::TYPE_UINT64:
+    case FieldDescriptor::TYPE_FIXED64:
+      return "in.unsignedLongKey(" + name + ")";
+    case FieldDescriptor::TYPE_BOOL:
+      return "in.boolKey(" + name + ")";
+    default:
+      // signed 32 bit integers
+      return "in.intKey(" + name + ")";
+  }
+}
+
+void PrintMergeUnknownField(const FieldDescriptor* field,
+                            const std::string& merge, io::Printer* printer) {
+  if (DiscardUnknownFields(field->containing_type())) {
+    printer->Print("// discard_unknown_fields\n");
+    return;
+  }
+  printer->Print(
+      "if (unknownFields == null) {\n"
+      "  unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();\n"
+      "}\n"
+      "unknownFields.$merge$;\n",
+      "merge", merge);
+}
+
+void PrintClearRepeatedField(const FieldDescriptor* field,
+                             const std::map<std::string, std::string>& variables,
+                             io::Printer* printer) {
+  const int threshold = RepeatedTrimThreshold(field->containing_type());
+  // the shared empty list is immutable, so only non-empty lists are cleared
+  if (threshold < 0) {
+    printer->Print(variables,
+                   "if (!$name$_.isEmpty()) {\n"
+                   "  $name$_.clear();\n"
+                   "}\n");
+  } else if (threshold == 0) {
+    printer->Print(variables, "$name$_ = $empty_list$;\n");
+  } else {
+    // a list that held more elements than the threshold is dropped, so a
+    // single spike does not stay allocated for the lifetime of the message
+    std::map<std::string, std::string> vars(variables);
+    vars["trim_threshold"] = StrCat(threshold);
+    printer->Print(vars,
+                   "if ($name$_.size() > $trim_threshold$) {\n"
+                   "  $name$_ = $empty_list$;\n"
+                   "} else if (!$name$_.isEmpty()) {\n"
+                   "  $name$_.clear();\n"
+                   "}\n");
+  }
+}
+
+void PrintEnsureRepeatedFieldMutable(
+    const std::map<std::string, std::string>& variables, io::Printer* printer) {
+  printer->Print(variables,
+                 "private void ensure$capitalized_name$IsMutable() {\n"
+                 "  if ($name$_ == $shared_empty_list$) {\n"
+                 "    $name$_ = $create_list$;\n"
+                 "  }\n"
+                 "}\n");
+}
+
+void PrintReturnUnmodifiableList(
+    const std::map<std::string, std::string>& variables, io::Printer* printer) {
+  printer->Print(variables,
+                 "  return $name$_ == $shared_empty_list$ ? $name$_\n"
+                 "      : java.util.Collections.unmodifiableList($name$_);\n");
+}
+
+void PrintMutatorPrologue(const FieldDescriptor* field, io::Printer* printer) {
+  // the templates indent their statements themselves
+  printer->Indent();
+  printer->Print("beforeMessageUpdate();\n");
+  PrintBeginWrite(printer, field->containing_type());
+  printer->Outdent();
+}
+
+void PrintMutatorEpilogue(const FieldDescriptor* field, io::Printer* printer) {
+  printer->Indent();
+  PrintEndWrite(printer, field->containing_type());
+  printer->Print("return this;\n");
+  printer->Outdent();
+}
+
+void PrintResetMemoizedSize(const FieldDescriptor* field,
+                            const std::map<std::string, std::string>& variables,
+                            io::Printer* printer) {
+  if (field->is_packed()) {
+    printer->Print(variables, "  $name$MemoizedSerializedSize = -1;\n");
+  }
+}
+
+void PrintCheckByNumber(const FieldDescriptor* field, const std::string& type,
+                        bool nullable, io::Printer* printer) {
+  printer->Print(
+      "de.leohilbert.proto.FieldValues.check(value, $class$, $nullable$,\n"
+      "    \"$field$\");\n",
+      "class", ClassLiteral(type), "nullable", nullable ? "true" : "false",
+      "field", field->full_name());
+}
+
+void PrintCheckListByNumber(const FieldDescriptor* field,
+                            const std::string& element_type,
+                            io::Printer* printer) {
+  printer->Print(
+      "value = de.leohilbert.proto.FieldValues.checkList(value, $class$,\n"
+      "    \"$field$\");\n",
+      "class", ClassLiteral(element_type), "field", field->full_name());
+}
+
+std::string ClassLiteral(const std::string& type) {
+  return type.substr(0, type.find('<')) + ".class";
+}
+
 void PrintExtraFieldInfo(const std::map<std::string, std::string>& variables,
                          io::Printer* printer) {
   const std::map<std::string, std::string>::const_iterator it =
@@ -75,13 +75,34 @@ class ImmutableFieldGenerator {
   virtual void GenerateClearCode(io::Printer* printer) const = 0;
   virtual void GenerateToStringCode(io::Printer* printer) const = 0;
   virtual void GenerateMergingCode(io::Printer* printer) const = 0;
+  virtual void GenerateCopyCode(io::Printer* printer) const = 0;
+  // Printed in freezeFrom after the field was copied into the snapshot.
+  virtual void GenerateFreezeCode(io::Printer* printer) const;
+  virtual void GenerateJsonCode(io::Printer* printer) const = 0;
+  virtual void GenerateJsonParsingCode(io::Printer* printer) const = 0;
+  // Printed in setFieldByNumber before anything is written, rejects values
+  // of the wrong type.
+  virtual void GenerateCheckByNumberCode(io::Printer* printer) const = 0;
+  // Printed in setFieldByNumber after the checks, stores like the setter and
+  // notifies the change.
+  virtual void GenerateSetByNumberCode(io::Printer* printer) const = 0;
   virtual void GenerateParsingCode(io::Printer* printer) const = 0;
   virtual void GenerateParsingCodeFromPacked(io::Printer* printer) const;
+  // Printed in updateFrom before the message is cleared.
+  virtual void GenerateParsingPrologueCode(io::Printer* printer) const;
+  // Parses the message of the field in updateFrom(input, mask) with the
+  // FieldMask "nested" for its fields, see HasNestedFieldMask.
+  virtual void GenerateMaskedParsingCode(io::Printer* printer) const;
   virtual void GenerateParsingDoneCode(io::Printer* printer) const = 0;
   virtual void GenerateSerializationCode(io::Printer* printer) const = 0;
   virtual void GenerateSerializedSizeCode(io::Printer* printer) const = 0;
+  // Write and size the message of the field in writeTo(output, mask) and
+  // getSerializedSize(mask) with the FieldMask "nested" for its fields.
+  virtual void GenerateMaskedSerializationCode(io::Printer* printer) const;
+  virtual void GenerateMaskedSerializedSizeCode(io::Printer* printer) const;
 
   virtual void GenerateEqualsCode(io::Printer* printer) const = 0;
+  virtual void GenerateDiffCode(io::Printer* printer) const = 0;
   virtual void GenerateHashCode(io::Printer* printer) const = 0;
 
   virtual std::string GetBoxedType() const = 0;
@@ -172,6 +193,94 @@ void SetCommonOneofVariables(const FieldDescriptor* descriptor,
                              const OneofGeneratorInfo* info,
                              std::map<std::string, std::string>* variables);
 
+// Set the variables controlling how a singular field is stored and accessed,
+// depending on the field_memory option of its message:
+//   $field_modifiers$ - "volatile " or empty
+//   $read_field$      - expression reading the field in getters
+//   $store_prefix$ / $store_suffix$ - wrap the value written in setters
+void SetFieldMemoryVariables(const FieldDescriptor* descriptor,
+                             const std::string& storage_type,
+                             bool volatile_by_default,
+                             std::map<std::string, std::string>* variables);
+
+// Print the declaration of a singular field (and its VarHandle if needed).
+void PrintFieldDeclaration(const std::map<std::string, std::string>& variables,
+                           io::Printer* printer);
+
+// Returns the statement writing value, the proto (not javatype) value of
+// field, as JSON to the Appendable "out".
+std::string JsonValueWriter(const FieldDescriptor* field,
+                            const std::string& value,
+                            ClassNameResolver* name_resolver);
+
+// Returns the statement writing the map key value as JSON member name,
+// updating the boolean local named first.
+std::string JsonMapKeyWriter(const FieldDescriptor* key,
+                             const std::string& value,
+                             const std::string& first);
+
+// Returns the expression reading a value of the non-message field from the
+// JsonReader "in". Like JsonValueWriter it yields the proto value.
+std::string JsonValueReader(const FieldDescriptor* field,
+                            ClassNameResolver* name_resolver);
+
+// Returns the expression converting the JSON member name to a map key.
+std::string JsonMapKeyReader(const FieldDescriptor* key,
+                             const std::string& name);
+
+// Print the statement keeping an unknown value of a closed enum in the
+// unknownFields builder of updateFrom, e.g. merge = "mergeVarintField(1, v)".
+// The builder is created on demand. Prints nothing if the message discards
+// unknown fields.
+void PrintMergeUnknownField(const FieldDescriptor* field,
+                            const std::string& merge, io::Printer* printer);
+
+// Print the statement emptying the repeated field $name$_ in place, so the
+// next update reuses its backing array. Depending on RepeatedTrimThreshold the
+// shared $empty_list$ is assigned instead.
+void PrintClearRepeatedField(const FieldDescriptor* field,
+                             const std::map<std::string, std::string>& variables,
+                             io::Printer* printer);
+
+// Print ensure$capitalized_name$IsMutable(), which replaces the shared
+// $empty_list$ a repeated field starts with by a $create_list$. It compares
+// against $shared_empty_list$, $empty_list$ may not be usable with ==.
+void PrintEnsureRepeatedFieldMutable(
+    const std::map<std::string, std::string>& variables, io::Printer* printer);
+
+// Print the return statement of a list getter. Lists are only changed through
+// the adders and setters, which notify, so the getter returns an unmodifiable
+// view. The $shared_empty_list$ is immutable already and returned as is.
+void PrintReturnUnmodifiableList(
+    const std::map<std::string, std::string>& variables, io::Printer* printer);
+
+// Print the start and the end of the body of a setter, adder or clearer,
+// around the statements the accessor templates print with their usual two
+// space indent. The start rejects frozen snapshots before anything is
+// written, both bracket the write for seqlock messages (see PrintBeginWrite),
+// the end returns this.
+void PrintMutatorPrologue(const FieldDescriptor* field, io::Printer* printer);
+void PrintMutatorEpilogue(const FieldDescriptor* field, io::Printer* printer);
+
+// Print the check of the value of setFieldByNumber for a singular field, see
+// de.leohilbert.proto.FieldValues. Null is accepted if the setter accepts it.
+void PrintCheckByNumber(const FieldDescriptor* field, const std::string& type,
+                        bool nullable, io::Printer* printer);
+
+// Print the check of the value of setFieldByNumber for a repeated field, the
+// value is replaced by a copy of the list.
+void PrintCheckListByNumber(const FieldDescriptor* field,
+                            const std::string& element_type,
+                            io::Printer* printer);
+
+// The class literal of a possibly generic type.
+std::string ClassLiteral(const std::string& type);
+
+// Packed repeated fields memoize their payload size, mutators reset it.
+void PrintResetMemoizedSize(const FieldDescriptor* field,
+                            const std::map<std::string, std::string>& variables,
+                            io::Printer* printer);
+
 // Print useful comments before a field's accessors.
 void PrintExtraFieldInfo(const std::map<std::string, std::string>& variables,
                          io::Printer* printer);
@@ -44,8 +44,11 @@
 #include <google/protobuf/compiler/java_leo/java_helpers.h>
 #include <google/protobuf/compiler/java_leo/java_message.h>
 #include <google/protobuf/compiler/java_leo/java_name_resolver.h>
+#include <google/protobuf/compiler/java_leo/java_off_heap.h>
 #include <google/protobuf/compiler/java_leo/java_service.h>
 #include <google/protobuf/compiler/java_leo/java_shared_code_generator.h>
+#include <google/protobuf/compiler/java_leo/java_table.h>
+#include <google/protobuf/compiler/java_leo/java_view.h>
 #include <google/protobuf/compiler/code_generator.h>
 #include <google/protobuf/descriptor.pb.h>
 #include <google/protobuf/io/printer.h>
@@ -179,6 +182,170 @@ void MaybeRestartJavaMethod(io::Printer* printer, int* bytecode_estimate,
     *bytecode_estimate = 0;
   }
 }
+bool ValidateFieldMemoryOption(const Descriptor* descriptor,
+                               std::string* error) {
+  FieldMemorySemantics semantics;
+  if (!ParseFieldMemorySemantics(GetFieldMemoryOption(descriptor),
+                                 &semantics)) {
+    error->assign(descriptor->full_name());
+    error->append(": Unknown field_memory \"");
+    error->append(GetFieldMemoryOption(descriptor));
+    error->append(
+        "\". Expected one of \"plain\", \"volatile\" or "
+        "\"release_acquire\".");
+    return false;
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateFieldMemoryOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Lean messages extend GeneratedMessageLean, which has neither MapFields nor
+// extension support.
+bool ValidateLeanMessage(const Descriptor* descriptor, std::string* error) {
+  if (descriptor->extension_range_count() > 0) {
+    error->assign(descriptor->full_name());
+    error->append(": lean messages can not have extension ranges.");
+    return false;
+  }
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    if (IsMapField(descriptor->field(i))) {
+      error->assign(descriptor->field(i)->full_name());
+      error->append(": lean messages do not support map fields.");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (IsMapEntry(descriptor->nested_type(i))) continue;
+    if (!ValidateLeanMessage(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The intern table decodes UTF-8, it can not produce any other type.
+bool ValidateInternOption(const Descriptor* descriptor, std::string* error) {
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (InternStrings(field) && GetJavaType(field) != JAVATYPE_STRING) {
+      error->assign(field->full_name());
+      error->append(": intern is only supported for string fields without a javatype.");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateInternOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ValidateInPlaceConverterOption(const Descriptor* descriptor,
+                                    std::string* error) {
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (!UseInPlaceConverter(field)) {
+      continue;
+    }
+    if (GetCustomJavaType(field).empty() ||
+        field->type() != FieldDescriptor::TYPE_MESSAGE ||
+        field->is_repeated() || field->containing_oneof() != nullptr) {
+      error->assign(field->full_name());
+      error->append(
+          ": inplace_converter is only supported for singular message fields "
+          "with a javatype, outside of oneofs.");
+      return false;
+    }
+    if (UseStreamConverter(field) || !BuiltinCodecClassName(field).empty()) {
+      error->assign(field->full_name());
+      error->append(
+          ": inplace_converter can not be combined with a stream converter "
+          "or a built-in codec.");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateInPlaceConverterOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// write() writes a tag per value, which packed fields don't have.
+bool ValidateStreamConverterOption(const Descriptor* descriptor,
+                                   std::string* error) {
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (!UseStreamConverter(field)) {
+      continue;
+    }
+    if (GetCustomJavaType(field).empty()) {
+      error->assign(field->full_name());
+      error->append(": stream_converter requires a javatype.");
+      return false;
+    }
+    if (field->is_packed()) {
+      error->assign(field->full_name());
+      error->append(
+          ": stream_converter is not supported for packed fields, use "
+          "[packed = false].");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateStreamConverterOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ValidateBuiltinCodecOption(const Descriptor* descriptor,
+                                std::string* error) {
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (UseBuiltinCodec(field) &&
+        BuiltinCodecClassName(field).empty()) {
+      error->assign(field->full_name());
+      error->append(
+          ": builtin_codec requires the javatype java.util.UUID on a string, "
+          "java.time.Instant on a google.protobuf.Timestamp or "
+          "java.time.Duration on a google.protobuf.Duration field.");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateBuiltinCodecOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ValidateCopyConverterOption(const Descriptor* descriptor,
+                                 std::string* error) {
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (UseCopyConverter(field) && GetCustomJavaType(field).empty()) {
+      error->assign(field->full_name());
+      error->append(": copy_converter requires a javatype.");
+      return false;
+    }
+  }
+  for (int i = 0; i < descriptor->nested_type_count(); i++) {
+    if (!ValidateCopyConverterOption(descriptor->nested_type(i), error)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 FileGenerator::FileGenerator(const FileDescriptor* file, const Options& options,
@@ -249,6 +416,37 @@ bool FileGenerator::Validate(std::string* error) {
            "https://github.com/protocolbuffers/protobuf/blob/master/java/"
            "lite.md";
   }
+
+  // !!!! Leo !!!! reject typos in the field_memory options
+  for (int i = 0; i < file_->message_type_count(); i++) {
+    if (!ValidateFieldMemoryOption(file_->message_type(i), error)) {
+      return false;
+    }
+  }
+  for (int i = 0; i < file_->message_type_count() && IsLean(file_); i++) {
+    if (!ValidateLeanMessage(file_->message_type(i), error)) {
+      return false;
+    }
+  }
+  for (int i = 0; i < file_->message_type_count(); i++) {
+    if (!ValidateInternOption(file_->message_type(i), error)) {
+      return false;
+    }
+  }
+  for (int i = 0; i < file_->message_type_count(); i++) {
+    if (!ValidateStreamConverterOption(file_->message_type(i), error)) {
+      return false;
+    }
+    if (!ValidateInPlaceConverterOption(file_->message_type(i), error)) {
+      return false;
+    }
+    if (!ValidateCopyConverterOption(file_->message_type(i), error)) {
+      return false;
+    }
+    if (!ValidateBuiltinCodecOption(file_->message_type(i), error)) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -321,6 +519,18 @@ void FileGenerator::Generate(io::Printer* printer) {
     for (int i = 0; i < file_->message_type_count(); i++) {
       message_generators_[i]->GenerateInterface(printer);
       message_generators_[i]->Generate(printer);
+      if (immutable_api_ && UseTable(file_->message_type(i))) {
+        TableGenerator(file_->message_type(i), context_.get())
+            .Generate(printer);
+      }
+      if (immutable_api_ && UseView(file_->message_type(i))) {
+        ViewGenerator(file_->message_type(i), context_.get())
+            .Generate(printer);
+      }
+      if (immutable_api_ && UseOffHeap(file_->message_type(i))) {
+        OffHeapGenerator(file_->message_type(i), context_.get())
+            .Generate(printer);
+      }
     }
     if (HasGenericServices(file_, context_->EnforceLite())) {
       for (int i = 0; i < file_->service_count(); i++) {
@@ -340,10 +550,14 @@ void FileGenerator::Generate(io::Printer* printer) {
   // Static variables. We'd like them to be final if possible, but due to
   // the JVM's 64k size limit on static blocks, we have to initialize some
   // of them in methods; thus they cannot be final.
+  // With lazy_descriptors the messages keep them in their own holder classes,
+  // lean messages have none.
   int static_block_bytecode_estimate = 0;
-  for (int i = 0; i < file_->message_type_count(); i++) {
-    message_generators_[i]->GenerateStaticVariables(
-        printer, &static_block_bytecode_estimate);
+  if (!UseLazyDescriptors(file_) && !IsLean(file_)) {
+    for (int i = 0; i < file_->message_type_count(); i++) {
+      message_generators_[i]->GenerateStaticVariables(
+          printer, &static_block_bytecode_estimate);
+    }
   }
 
   printer->Print("\n");
@@ -402,7 +616,9 @@ void FileGenerator::GenerateDescriptorInitializationCodeForImmutable(
   int bytecode_estimate = 0;
   int method_num = 0;
 
-  for (int i = 0; i < file_->message_type_count(); i++) {
+  for (int i = 0; i < file_->message_type_count() &&
+                  !UseLazyDescriptors(file_) && !IsLean(file_);
+       i++) {
     bytecode_estimate +=
         message_generators_[i]->GenerateStaticVariableInitializers(printer);
     MaybeRestartJavaMethod(
@@ -647,6 +863,27 @@ void FileGenerator::GenerateSiblings(
           package_dir, java_package_, file_->message_type(i), context,
           file_list, options_.annotate_code, annotation_list, "",
           message_generators_[i].get(), &MessageGenerator::Generate);
+      if (immutable_api_ && UseTable(file_->message_type(i))) {
+        TableGenerator generator(file_->message_type(i), context_.get());
+        GenerateSibling<TableGenerator>(
+            package_dir, java_package_, file_->message_type(i), context,
+            file_list, options_.annotate_code, annotation_list, "Table",
+            &generator, &TableGenerator::Generate);
+      }
+      if (immutable_api_ && UseView(file_->message_type(i))) {
+        ViewGenerator generator(file_->message_type(i), context_.get());
+        GenerateSibling<ViewGenerator>(
+            package_dir, java_package_, file_->message_type(i), context,
+            file_list, options_.annotate_code, annotation_list, "View",
+            &generator, &ViewGenerator::Generate);
+      }
+      if (immutable_api_ && UseOffHeap(file_->message_type(i))) {
+        OffHeapGenerator generator(file_->message_type(i), context_.get());
+        GenerateSibling<OffHeapGenerator>(
+            package_dir, java_package_, file_->message_type(i), context,
+            file_list, options_.annotate_code, annotation_list, "OffHeap",
+            &generator, &OffHeapGenerator::Generate);
+      }
     }
     if (HasGenericServices(file_, context_->EnforceLite())) {
       for (int i = 0; i < file_->service_count(); i++) {
@@ -114,6 +114,50 @@ std::string FieldName(const FieldDescriptor* field) {
   return field_name;
 }
 
+// javatypes with a built-in codec in de.leohilbert.proto. The message-backed
+// ones are also what unbox_well_known_types maps the message to.
+struct BuiltinCodec {
+  const char* java_type;
+  const char* message_type;  // nullptr for string fields
+  const char* codec;
+};
+
+const BuiltinCodec kBuiltinCodecs[] = {
+    {"java.util.UUID", nullptr, "de.leohilbert.proto.UuidCodec"},
+    {"java.time.Instant", "google.protobuf.Timestamp",
+     "de.leohilbert.proto.InstantCodec"},
+    {"java.time.Duration", "google.protobuf.Duration",
+     "de.leohilbert.proto.DurationCodec"},
+    {"java.lang.Integer", "google.protobuf.Int32Value",
+     "de.leohilbert.proto.WrapperCodecs.Int32Value"},
+    {"java.lang.Integer", "google.protobuf.UInt32Value",
+     "de.leohilbert.proto.WrapperCodecs.UInt32Value"},
+    {"java.lang.Long", "google.protobuf.Int64Value",
+     "de.leohilbert.proto.WrapperCodecs.Int64Value"},
+    {"java.lang.Long", "google.protobuf.UInt64Value",
+     "de.leohilbert.proto.WrapperCodecs.UInt64Value"},
+    {"java.lang.Float", "google.protobuf.FloatValue",
+     "de.leohilbert.proto.WrapperCodecs.FloatValue"},
+    {"java.lang.Double", "google.protobuf.DoubleValue",
+     "de.leohilbert.proto.WrapperCodecs.DoubleValue"},
+    {"java.lang.Boolean", "google.protobuf.BoolValue",
+     "de.leohilbert.proto.WrapperCodecs.BoolValue"},
+    {"java.lang.String", "google.protobuf.StringValue",
+     "de.leohilbert.proto.WrapperCodecs.StringValue"},
+    {"com.google.protobuf.ByteString", "google.protobuf.BytesValue",
+     "de.leohilbert.proto.WrapperCodecs.BytesValue"},
+};
+
+// Returns the entry for a message type, or nullptr.
+const BuiltinCodec* FindBuiltinCodec(const Descriptor* message_type) {
+  for (const BuiltinCodec& codec : kBuiltinCodecs) {
+    if (codec.message_type != nullptr &&
+        message_type->full_name() == codec.message_type) {
+      return &codec;
+    }
+  }
+  return nullptr;
+}
 
 }  // namespace
 
@@ -317,12 +361,303 @@ std::string FieldConstantName(const FieldDescriptor* field) {
   return name;
 }
 
+std::string FieldDiffBitName(const FieldDescriptor* field) {
+  std::string name = field->name() + "_DIFF_BIT";
+  ToUpper(&name);
+  return name;
+}
+
 FieldDescriptor::Type GetType(const FieldDescriptor* field) {
   return field->type();
 }
 
 std::string GetCustomJavaType(const FieldDescriptor* field) {
-  return field->options().GetExtension(leo::proto::javatype);
+  const std::string& javatype =
+      field->options().GetExtension(leo::proto::javatype);
+  if (!javatype.empty() || field->type() != FieldDescriptor::TYPE_MESSAGE ||
+      field->is_extension() || IsMapEntry(field->containing_type()) ||
+      !UnboxWellKnownTypes(field->containing_type())) {
+    return javatype;
+  }
+  const BuiltinCodec* codec = FindBuiltinCodec(field->message_type());
+  return codec == nullptr ? "" : codec->java_type;
+}
+
+bool InternStrings(const FieldDescriptor* field) {
+  return field->options().GetExtension(leo::proto::intern);
+}
+
+bool UseStreamConverter(const FieldDescriptor* field) {
+  return field->options().GetExtension(leo::proto::stream_converter);
+}
+
+bool UseInPlaceConverter(const FieldDescriptor* field) {
+  return field->options().GetExtension(leo::proto::inplace_converter);
+}
+
+bool UseCopyConverter(const FieldDescriptor* field) {
+  return field->options().GetExtension(leo::proto::copy_converter);
+}
+
+bool UseBuiltinCodec(const FieldDescriptor* field) {
+  return field->options().GetExtension(leo::proto::builtin_codec);
+}
+
+std::string ConverterClassName(const std::string& custom_type) {
+  std::string name(custom_type);
+  std::transform(name.begin(), name.end(), name.begin(), toupper);
+  std::replace(name.begin(), name.end(), '.', '_');
+  return "de.leohilbert.protoconverter.ProtoConverter_" + name;
+}
+
+std::string BuiltinCodecClassName(const FieldDescriptor* field) {
+  // a converter named by an explicit javatype takes precedence, unboxed well
+  // known types have no converter and always use the codec
+  if (!field->options().GetExtension(leo::proto::javatype).empty() &&
+      !UseBuiltinCodec(field)) {
+    return "";
+  }
+  const std::string custom_type = GetCustomJavaType(field);
+  if (field->type() == FieldDescriptor::TYPE_STRING) {
+    const BuiltinCodec& uuid = kBuiltinCodecs[0];
+    return custom_type == uuid.java_type ? uuid.codec : "";
+  }
+  if (field->type() != FieldDescriptor::TYPE_MESSAGE) {
+    return "";
+  }
+  const BuiltinCodec* codec = FindBuiltinCodec(field->message_type());
+  return codec != nullptr && custom_type == codec->java_type ? codec->codec
+                                                             : "";
+}
+
+bool ParseFieldMemorySemantics(const std::string& value,
+                               FieldMemorySemantics* result) {
+  if (value.empty()) {
+    *result = FIELD_MEMORY_DEFAULT;
+  } else if (value == "plain") {
+    *result = FIELD_MEMORY_PLAIN;
+  } else if (value == "volatile") {
+    *result = FIELD_MEMORY_VOLATILE;
+  } else if (value == "release_acquire") {
+    *result = FIELD_MEMORY_RELEASE_ACQUIRE;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::string GetFieldMemoryOption(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_field_memory)) {
+    return descriptor->options().GetExtension(leo::proto::msg_field_memory);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::field_memory);
+}
+
+FieldMemorySemantics GetFieldMemorySemantics(const Descriptor* descriptor) {
+  FieldMemorySemantics result = FIELD_MEMORY_DEFAULT;
+  // invalid values are rejected by FileGenerator::Validate
+  ParseFieldMemorySemantics(GetFieldMemoryOption(descriptor), &result);
+  return result;
+}
+
+bool UseSeqLock(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_seqlock)) {
+    return descriptor->options().GetExtension(leo::proto::msg_seqlock);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::seqlock);
+}
+
+void PrintBeginWrite(io::Printer* printer, const Descriptor* descriptor) {
+  if (!UseSeqLock(descriptor)) {
+    return;
+  }
+  printer->Print(
+      "boolean writing = beginWrite();\n"
+      "try {\n");
+  printer->Indent();
+}
+
+void PrintEndWrite(io::Printer* printer, const Descriptor* descriptor) {
+  if (!UseSeqLock(descriptor)) {
+    return;
+  }
+  printer->Outdent();
+  printer->Print(
+      "} finally {\n"
+      "  if (writing) {\n"
+      "    endWrite();\n"
+      "  }\n"
+      "}\n");
+}
+
+bool DiscardUnknownFields(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(
+          leo::proto::msg_discard_unknown_fields)) {
+    return descriptor->options().GetExtension(
+        leo::proto::msg_discard_unknown_fields);
+  }
+  return descriptor->file()->options().GetExtension(
+      leo::proto::discard_unknown_fields);
+}
+
+bool UnboxWellKnownTypes(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(
+          leo::proto::msg_unbox_well_known_types)) {
+    return descriptor->options().GetExtension(
+        leo::proto::msg_unbox_well_known_types);
+  }
+  return descriptor->file()->options().GetExtension(
+      leo::proto::unbox_well_known_types);
+}
+
+bool UseCompactLayout(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_compact_layout)) {
+    return descriptor->options().GetExtension(leo::proto::msg_compact_layout);
+  }
+  return descriptor->file()->options().GetExtension(
+      leo::proto::compact_layout);
+}
+
+int CompactBitWidth(const FieldDescriptor* field) {
+  if (field->is_repeated() || field->is_extension() || IsRealOneof(field) ||
+      !UseCompactLayout(field->containing_type())) {
+    return 0;
+  }
+  // fields that asked for volatile or release / acquire access keep it
+  FieldMemorySemantics semantics =
+      GetFieldMemorySemantics(field->containing_type());
+  if (semantics == FIELD_MEMORY_VOLATILE ||
+      semantics == FIELD_MEMORY_RELEASE_ACQUIRE) {
+    return 0;
+  }
+  switch (GetJavaType(field)) {
+    case JAVATYPE_BOOLEAN:
+      return 1;
+    case JAVATYPE_ENUM: {
+      // open enums have to keep numbers they don't know
+      if (SupportUnknownEnumValue(field->file())) {
+        return 0;
+      }
+      const EnumDescriptor* enum_type = field->enum_type();
+      int max_number = 0;
+      for (int i = 0; i < enum_type->value_count(); i++) {
+        int number = enum_type->value(i)->number();
+        if (number < 0 || number > 255) {
+          return 0;
+        }
+        max_number = std::max(max_number, number);
+      }
+      int width = 1;
+      while ((1 << width) <= max_number) {
+        width++;
+      }
+      return width;
+    }
+    default:
+      return 0;
+  }
+}
+
+bool UseTable(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_table)) {
+    return descriptor->options().GetExtension(leo::proto::msg_table);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::table);
+}
+
+bool IsTableColumn(const FieldDescriptor* field) {
+  if (field->is_repeated() || field->is_extension() || IsRealOneof(field)) {
+    return false;
+  }
+  switch (GetJavaType(field)) {
+    case JAVATYPE_MESSAGE:
+    case JAVATYPE_CUSTOM:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool UseOffHeap(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_off_heap)) {
+    return descriptor->options().GetExtension(leo::proto::msg_off_heap);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::off_heap);
+}
+
+bool UseView(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_view)) {
+    return descriptor->options().GetExtension(leo::proto::msg_view);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::view);
+}
+
+bool IsViewField(const FieldDescriptor* field) {
+  if (field->is_repeated() || field->is_extension() ||
+      GetType(field) == FieldDescriptor::TYPE_GROUP) {
+    return false;
+  }
+  switch (GetJavaType(field)) {
+    case JAVATYPE_MESSAGE:
+      return UseView(field->message_type());
+    case JAVATYPE_CUSTOM:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool UseFieldMasks(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(leo::proto::msg_field_masks)) {
+    return descriptor->options().GetExtension(leo::proto::msg_field_masks);
+  }
+  return descriptor->file()->options().GetExtension(leo::proto::field_masks);
+}
+
+bool HasNestedFieldMask(const FieldDescriptor* field) {
+  if (field->is_extension() || GetJavaType(field) != JAVATYPE_MESSAGE ||
+      GetType(field) == FieldDescriptor::TYPE_GROUP ||
+      IsMapEntry(field->message_type())) {
+    return false;
+  }
+  return UseFieldMasks(field->message_type());
+}
+
+int CompactValueBitIndex(const FieldDescriptor* field, int messageBitIndex) {
+  int index = messageBitIndex + (SupportFieldPresence(field) ? 1 : 0);
+  if (index % 32 + CompactBitWidth(field) > 32) {
+    index += 32 - index % 32;
+  }
+  return index;
+}
+
+int RepeatedTrimThreshold(const Descriptor* descriptor) {
+  if (descriptor->options().HasExtension(
+          leo::proto::msg_repeated_trim_threshold)) {
+    return descriptor->options().GetExtension(
+        leo::proto::msg_repeated_trim_threshold);
+  }
+  if (descriptor->file()->options().HasExtension(
+          leo::proto::repeated_trim_threshold)) {
+    return descriptor->file()->options().GetExtension(
+        leo::proto::repeated_trim_threshold);
+  }
+  return 1024;
+}
+
+bool UseLazyDescriptors(const FileDescriptor* file) {
+  return file->options().GetExtension(leo::proto::lazy_descriptors);
+}
+
+bool IsLean(const FileDescriptor* file) {
+  return file->options().GetExtension(leo::proto::lean);
+}
+
+std::string GeneratedMessageBaseClass(const FileDescriptor* file) {
+  if (IsLean(file)) {
+    return "com.google.protobuf.GeneratedMessageLean";
+  }
+  return "com.google.protobuf.GeneratedMessage" + GeneratedCodeVersionSuffix();
 }
 
 JavaType GetJavaType(const FieldDescriptor* field) {
@@ -448,11 +783,38 @@ std::string GetOneofStoredType(const FieldDescriptor* field) {
       return "java.lang.Integer";
     case JAVATYPE_MESSAGE:
       return ClassName(field->message_type());
+    case JAVATYPE_CUSTOM:
+      return GetCustomJavaType(field);
     default:
       return BoxedPrimitiveTypeName(javaType);
   }
 }
 
+bool UsesOneofBits(const FieldDescriptor* field) {
+  if (!IsRealOneof(field)) {
+    return false;
+  }
+  switch (GetJavaType(field)) {
+    case JAVATYPE_INT:
+    case JAVATYPE_LONG:
+    case JAVATYPE_FLOAT:
+    case JAVATYPE_DOUBLE:
+    case JAVATYPE_BOOLEAN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool HasOneofBits(const OneofDescriptor* oneof) {
+  for (int i = 0; i < oneof->field_count(); i++) {
+    if (UsesOneofBits(oneof->field(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 const char* FieldTypeName(FieldDescriptor::Type field_type) {
   switch (field_type) {
     case FieldDescriptor::TYPE_INT32:
@@ -569,6 +931,22 @@ std::string DefaultValue(const FieldDescriptor* field, bool immutable,
   return "";
 }
 
+std::string ProtoStringDefaultValue(const FieldDescriptor* field) {
+  const std::string& value = field->default_value_string();
+  if (field->type() == FieldDescriptor::TYPE_BYTES) {
+    if (value.empty()) {
+      return "com.google.protobuf.ByteString.EMPTY";
+    }
+    return "com.google.protobuf.Internal.bytesDefaultValue(\"" +
+           CEscape(value) + "\")";
+  }
+  if (AllAscii(value)) {
+    return "\"" + CEscape(value) + "\"";
+  }
+  return "com.google.protobuf.Internal.stringDefaultValue(\"" +
+         CEscape(value) + "\")";
+}
+
 bool IsDefaultValueJavaDefault(const FieldDescriptor* field) {
   // Switch on CppType since we need to know which default_value_* method
   // of FieldDescriptor to call.
@@ -686,6 +1064,68 @@ std::string GenerateSetBitMutableLocal(int bitIndex) {
   return GenerateSetBitInternal("mutable_", bitIndex);
 }
 
+namespace {
+
+std::string HexMask(uint32 mask) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string result = "0x";
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    result += kDigits[(mask >> shift) & 0xf];
+  }
+  return result;
+}
+
+}  // namespace
+
+std::string GenerateGetBits(int bitIndex, int width) {
+  int shift = bitIndex % 32;
+  GOOGLE_CHECK_LE(shift + width, 32);
+  std::string result = GetBitFieldNameForBit(bitIndex);
+  if (shift != 0) {
+    result = "(" + result + " >>> " + StrCat(shift) + ")";
+  }
+  if (shift + width < 32) {
+    result += " & " + HexMask((uint32(1) << width) - 1);
+  }
+  return "(" + result + ")";
+}
+
+std::string GenerateSetBits(int bitIndex, int width, const std::string& value) {
+  int shift = bitIndex % 32;
+  GOOGLE_CHECK_LE(shift + width, 32);
+  std::string varName = GetBitFieldNameForBit(bitIndex);
+  uint32 mask = static_cast<uint32>(((uint64(1) << width) - 1) << shift);
+  std::string cleared = varName + " = (" + varName + " & ~" + HexMask(mask) + ")";
+  // constants, e.g. the default value, are shifted here
+  if (!value.empty() &&
+      value.find_first_not_of("0123456789") == std::string::npos) {
+    uint32 bits = static_cast<uint32>(std::stoul(value));
+    return bits == 0 ? cleared : cleared + " | " + HexMask(bits << shift);
+  }
+  std::string shifted = value;
+  if (value.find_first_not_of("abcdefghijklmnopqrstuvwxyz"
+                              "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_") !=
+      std::string::npos) {
+    shifted = "(" + value + ")";
+  }
+  if (shift != 0) {
+    shifted = "(" + shifted + " << " + StrCat(shift) + ")";
+  }
+  return cleared + " | " + shifted;
+}
+
+std::string GenerateStoreBit(int bitIndex, const std::string& value) {
+  if (value == "true") {
+    return GenerateSetBit(bitIndex);
+  } else if (value == "false") {
+    return GenerateClearBit(bitIndex);
+  }
+  std::string varName = GetBitFieldNameForBit(bitIndex);
+  std::string mask = bit_masks[bitIndex % 32];
+  return varName + " = (" + varName + " & ~" + mask + ") | (" + value +
+         " ? " + mask + " : 0)";
+}
+
 bool IsReferenceType(JavaType type) {
   switch (type) {
     case JAVATYPE_INT:
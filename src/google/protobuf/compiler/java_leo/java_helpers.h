@@ -153,6 +153,13 @@ inline bool IsDescriptorProto(const Descriptor* descriptor) {
 // fields.
 std::string GetOneofStoredType(const FieldDescriptor* field);
 
+// Whether this oneof member is numeric or bool and stored as raw bits in the
+// long $oneof_name$Bits_ slot instead of boxed in $oneof_name$_.
+bool UsesOneofBits(const FieldDescriptor* field);
+
+// Whether any member of the oneof uses the bits slot.
+bool HasOneofBits(const OneofDescriptor* oneof);
+
 
 // Whether we should generate multiple java files for messages.
 inline bool MultipleJavaFiles(const FileDescriptor* descriptor,
@@ -200,6 +207,10 @@ void MaybePrintGeneratedAnnotation(Context* context, io::Printer* printer,
 // number constant.
 std::string FieldConstantName(const FieldDescriptor* field);
 
+// Get the unqualified name of the constant holding the field's bit in the
+// mask returned by diffMask().
+std::string FieldDiffBitName(const FieldDescriptor* field);
+
 // Returns the type of the FieldDescriptor.
 // This does nothing interesting for the open source release, but is used for
 // hacks that improve compatibility with version 1 protocol buffers at Google.
@@ -220,6 +231,128 @@ enum JavaType {
 
 std::string GetCustomJavaType(const FieldDescriptor* field);
 
+// Whether the intern option is set for this field.
+bool InternStrings(const FieldDescriptor* field);
+
+// Whether the stream_converter option is set for this field, i.e. its javatype
+// converter also provides read, write and size.
+bool UseStreamConverter(const FieldDescriptor* field);
+
+// Whether the inplace_converter option is set for this field, i.e. its javatype
+// converter provides mergeInto(existing, proto).
+bool UseInPlaceConverter(const FieldDescriptor* field);
+
+// Whether the copy_converter option is set for this field, i.e. its javatype
+// converter provides copy(T). Otherwise copyFrom shares the value.
+bool UseCopyConverter(const FieldDescriptor* field);
+
+// Whether the builtin_codec option is set for this field, i.e. its explicit
+// javatype is read and written by a runtime codec instead of its converter.
+bool UseBuiltinCodec(const FieldDescriptor* field);
+
+// Fully qualified name of the converter class for a javatype, e.g.
+// de.leohilbert.protoconverter.ProtoConverter_JAVA_UTIL_UUID.
+std::string ConverterClassName(const std::string& custom_type);
+
+// Fully qualified name of the runtime codec that reads and writes the javatype
+// of this field straight from the wire, e.g. de.leohilbert.proto.UuidCodec for
+// a java.util.UUID string or de.leohilbert.proto.InstantCodec for a
+// java.time.Instant Timestamp. Empty if the field goes through its converter,
+// which is the case for an explicit javatype without the builtin_codec option.
+std::string BuiltinCodecClassName(const FieldDescriptor* field);
+
+// Memory semantics of the singular fields of a message, configured with the
+// field_memory / msg_field_memory options.
+enum FieldMemorySemantics {
+  FIELD_MEMORY_DEFAULT,  // only strings are volatile
+  FIELD_MEMORY_PLAIN,
+  FIELD_MEMORY_VOLATILE,
+  FIELD_MEMORY_RELEASE_ACQUIRE
+};
+
+// Returns false if value is not a known field_memory option value.
+bool ParseFieldMemorySemantics(const std::string& value,
+                               FieldMemorySemantics* result);
+std::string GetFieldMemoryOption(const Descriptor* descriptor);
+FieldMemorySemantics GetFieldMemorySemantics(const Descriptor* descriptor);
+
+// Whether the seqlock / msg_seqlock option is set for this message.
+bool UseSeqLock(const Descriptor* descriptor);
+
+// For seqlock messages, print "boolean writing = beginWrite();" and open a
+// try block (indenting), which PrintEndWrite closes with a finally block
+// calling endWrite(). A write that throws thereby still releases the lock,
+// and a write nested in another one leaves the lock to the outer one. Both
+// print nothing for other messages.
+void PrintBeginWrite(io::Printer* printer, const Descriptor* descriptor);
+void PrintEndWrite(io::Printer* printer, const Descriptor* descriptor);
+
+// Whether the discard_unknown_fields / msg_discard_unknown_fields option is set
+// for this message.
+bool DiscardUnknownFields(const Descriptor* descriptor);
+
+// Whether the unbox_well_known_types / msg_unbox_well_known_types option is set
+// for this message, i.e. its Timestamp, Duration and wrapper fields get an
+// implicit javatype.
+bool UnboxWellKnownTypes(const Descriptor* descriptor);
+
+// The repeated_trim_threshold / msg_repeated_trim_threshold option for this
+// message, 1024 if neither is set.
+int RepeatedTrimThreshold(const Descriptor* descriptor);
+
+// Whether the compact_layout / msg_compact_layout option is set for this
+// message.
+bool UseCompactLayout(const Descriptor* descriptor);
+
+// The number of bits the value of a singular bool or small closed enum field
+// takes in the shared bitfields of a compact_layout message, 0 if the field is
+// stored in a java field of its own.
+int CompactBitWidth(const FieldDescriptor* field);
+
+// Whether the table / msg_table option is set for this message, which
+// generates a <Message>Table companion.
+bool UseTable(const Descriptor* descriptor);
+
+// Whether the table of the field's message stores it in a column, which is
+// the case for singular scalar, enum, string and bytes fields. The records of
+// off_heap messages store the same fields.
+bool IsTableColumn(const FieldDescriptor* field);
+
+// Whether the off_heap / msg_off_heap option is set for this message, which
+// generates a <Message>OffHeap record.
+bool UseOffHeap(const Descriptor* descriptor);
+
+// Whether the view / msg_view option is set for this message, which generates
+// a read-only <Message>View.
+bool UseView(const Descriptor* descriptor);
+
+// Whether the view of the field's message has a getter for it. Repeated and
+// javatype fields are left out, message fields need a view of their type.
+bool IsViewField(const FieldDescriptor* field);
+
+// Whether the field_masks / msg_field_masks option is set for this message,
+// which generates compileMask(paths) and the masked updateFrom, writeTo and
+// getSerializedSize.
+bool UseFieldMasks(const Descriptor* descriptor);
+
+// Whether a FieldMask can select fields inside this field, which needs a
+// message field (no group, map or javatype) of a type with field masks.
+bool HasNestedFieldMask(const FieldDescriptor* field);
+
+// The first bit of a compact field's value. It follows the field's has-bit,
+// unless the value would then cross into the next bitfield.
+int CompactValueBitIndex(const FieldDescriptor* field, int messageBitIndex);
+
+// Whether the lazy_descriptors option is set for this file.
+bool UseLazyDescriptors(const FileDescriptor* file);
+
+// Whether the lean option is set for this file.
+bool IsLean(const FileDescriptor* file);
+
+// The runtime class the messages of this file extend and whose static
+// helpers (writeString, parseWithIOException, ...) they call.
+std::string GeneratedMessageBaseClass(const FileDescriptor* file);
+
 JavaType GetJavaType(const FieldDescriptor* field);
 
 const char* PrimitiveTypeName(JavaType type);
@@ -245,6 +378,11 @@ inline std::string ImmutableDefaultValue(const FieldDescriptor* field,
 bool IsDefaultValueJavaDefault(const FieldDescriptor* field);
 bool IsByteStringWithCustomDefaultValue(const FieldDescriptor* field);
 
+// The proto default of a string or bytes field: "" and ByteString.EMPTY unless
+// a proto2 default is declared. Messages keep absent strings as null, views,
+// tables and off-heap records read them like the wire format defines them.
+std::string ProtoStringDefaultValue(const FieldDescriptor* field);
+
 // Does this message class have descriptor and reflection methods?
 inline bool HasDescriptorMethods(const Descriptor* descriptor,
                                  bool enforce_lite) {
@@ -314,6 +452,21 @@ std::string GenerateGetBitMutableLocal(int bitIndex);
 // Example: "mutable_bitField1_ = (mutable_bitField1_ | 0x04)"
 std::string GenerateSetBitMutableLocal(int bitIndex);
 
+// Generates the java code for the expression that reads width bits of the
+// shared bitfields, starting at the given bit index, as an unsigned int.
+// Example: "((bitField1_ >>> 4) & 0x7)"
+std::string GenerateGetBits(int bitIndex, int width);
+
+// Generates the java code for the expression that stores the int value in
+// width bits of the shared bitfields, starting at the given bit index.
+// Example: "bitField1_ = (bitField1_ & ~0x00000070) | ((value) << 4)"
+std::string GenerateSetBits(int bitIndex, int width, const std::string& value);
+
+// Generates the java code for the expression that stores the boolean value in
+// the bit of the shared bitfields for the given bit index.
+// Example: "bitField1_ = (bitField1_ & ~0x00000004) | (value ? 0x00000004 : 0)"
+std::string GenerateStoreBit(int bitIndex, const std::string& value);
+
 // Returns whether the JavaType is a reference type.
 bool IsReferenceType(JavaType type);
 
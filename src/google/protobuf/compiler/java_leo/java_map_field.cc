@@ -148,9 +148,18 @@ void SetMessageVariables(const FieldDescriptor* descriptor, int messageBitIndex,
   (*variables)["default_entry"] =
       (*variables)["capitalized_name"] + "DefaultEntryHolder.defaultEntry";
   (*variables)["map_field_parameter"] = (*variables)["default_entry"];
-  (*variables)["descriptor"] =
-      name_resolver->GetImmutableClassName(descriptor->file()) + ".internal_" +
-      UniqueFileScopeIdentifier(descriptor->message_type()) + "_descriptor, ";
+  if (UseLazyDescriptors(descriptor->file())) {
+    // map entries have no class of their own, so they are looked up through
+    // the holder of the containing message
+    (*variables)["descriptor"] =
+        "DescriptorHolder.descriptor.getNestedTypes().get(" +
+        StrCat(descriptor->message_type()->index()) + "), ";
+  } else {
+    (*variables)["descriptor"] =
+        name_resolver->GetImmutableClassName(descriptor->file()) +
+        ".internal_" + UniqueFileScopeIdentifier(descriptor->message_type()) +
+        "_descriptor, ";
+  }
   (*variables)["ver"] = GeneratedCodeVersionSuffix();
 }
 
@@ -519,6 +528,131 @@ void ImmutableMapFieldGenerator::GenerateMergingCode(
                  "    other.internalGet$capitalized_name$());\n");
 }
 
+void ImmutableMapFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  if (GetJavaType(ValueField(descriptor_)) == JAVATYPE_MESSAGE) {
+    printer->Print(
+        variables_,
+        "if (other.$name$_ == null) {\n"
+        "  $name$_ = null;\n"
+        "} else {\n"
+        "  $name$_ = com.google.protobuf.MapField.newMapField(\n"
+        "      $map_field_parameter$);\n"
+        "  for (java.util.Map.Entry<$type_parameters$> entry\n"
+        "       : other.$name$_.getMap().entrySet()) {\n"
+        "    $name$_.getMutableMap().put(entry.getKey(), entry.getValue().deepCopy());\n"
+        "  }\n"
+        "}\n");
+  } else {
+    printer->Print(variables_,
+                   "$name$_ = other.$name$_ == null ? null : other.$name$_.copy();\n");
+  }
+}
+
+void ImmutableMapFieldGenerator::GenerateFreezeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($name$_ != null) {\n"
+                 "  $name$_.makeImmutable();\n"
+                 "}\n");
+}
+
+void ImmutableMapFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!internalGet$capitalized_name$().getMap().isEmpty()) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n"
+                 "  out.append('{');\n"
+                 "  boolean firstEntry = true;\n"
+                 "  for (java.util.Map.Entry<$type_parameters$> entry\n"
+                 "       : internalGet$capitalized_name$().getMap().entrySet()) {\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Print(
+      JsonMapKeyWriter(KeyField(descriptor_), "entry.getKey()", "firstEntry")
+          .c_str());
+  printer->Print(variables_,
+                 JsonValueWriter(ValueField(descriptor_), "entry.getValue()",
+                                 name_resolver_).c_str());
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print("  }\n"
+                 "  out.append('}');\n"
+                 "}\n");
+}
+
+void ImmutableMapFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "in.beginObject();\n"
+                 "$name$_ = com.google.protobuf.MapField.newMapField(\n"
+                 "    $map_field_parameter$);\n"
+                 "while (in.hasNextMember()) {\n");
+  printer->Indent();
+  printer->Print(
+      variables_,
+      ("$boxed_key_type$ key = " +
+       JsonMapKeyReader(KeyField(descriptor_), "in.nextName()") + ";\n")
+          .c_str());
+  if (GetJavaType(ValueField(descriptor_)) == JAVATYPE_MESSAGE) {
+    printer->Print(variables_,
+                   "$value_type$ value = new $value_type$();\n"
+                   "value.updateFromJson(in);\n");
+  } else {
+    printer->Print(
+        variables_,
+        ("$boxed_value_type$ value = " +
+         JsonValueReader(ValueField(descriptor_), name_resolver_) + ";\n")
+            .c_str());
+  }
+  printer->Print(variables_, "$name$_.getMutableMap().put(key, value);\n");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableMapFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  const bool enum_value = GetJavaType(ValueField(descriptor_)) == JAVATYPE_ENUM;
+  printer->Print(
+      "de.leohilbert.proto.FieldValues.checkMap(value, $key_class$,\n"
+      "    $value_class$, \"$field$\");\n",
+      "key_class", ClassLiteral(variables_.at("boxed_key_type")),
+      "value_class",
+      ClassLiteral(variables_.at(enum_value ? "value_enum_type"
+                                            : "boxed_value_type")),
+      "field", descriptor_->full_name());
+}
+
+void ImmutableMapFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$name$_ = com.google.protobuf.MapField.newMapField(\n"
+                 "    $map_field_parameter$);\n");
+  if (GetJavaType(ValueField(descriptor_)) == JAVATYPE_ENUM) {
+    // enum values are stored as numbers
+    printer->Print(
+        variables_,
+        "for (java.util.Map.Entry<$boxed_key_type$, $value_enum_type$> entry\n"
+        "     : ((java.util.Map<$boxed_key_type$, $value_enum_type$>) value).entrySet()) {\n"
+        "  $name$_.getMutableMap().put(entry.getKey(), entry.getValue().getNumber());\n"
+        "}\n");
+  } else {
+    printer->Print(variables_,
+                   "$name$_.getMutableMap().putAll(\n"
+                   "    (java.util.Map<$type_parameters$>) value);\n");
+  }
+  printer->Print(variables_, "$on_changed$\n");
+}
+
+void ImmutableMapFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!internalGet$capitalized_name$().equals(\n"
+                 "    other.internalGet$capitalized_name$())) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableMapFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   printer->Print(variables_,
@@ -536,8 +670,13 @@ void ImmutableMapFieldGenerator::GenerateParsingCode(
         "$name$__ = $default_entry$.getParserForType().parseFrom(bytes);\n");
     printer->Print(
         variables_,
-        "if ($value_enum_type$.forNumber($name$__.getValue()) == null) {\n"
-        "  unknownFields.mergeLengthDelimitedField($number$, bytes);\n"
+        "if ($value_enum_type$.forNumber($name$__.getValue()) == null) {\n");
+    printer->Indent();
+    PrintMergeUnknownField(descriptor_, StrCat("mergeLengthDelimitedField(",
+                           descriptor_->number(), ", bytes)"), printer);
+    printer->Outdent();
+    printer->Print(
+        variables_,
         "} else {\n"
         "  $name$_.getMutableMap().put(\n"
         "      $name$__.getKey(), $name$__.getValue());\n"
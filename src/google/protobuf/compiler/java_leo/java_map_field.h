@@ -54,6 +54,13 @@ class ImmutableMapFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateFreezeCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
@@ -45,6 +45,9 @@
 #include <google/protobuf/compiler/java_leo/java_extension.h>
 #include <google/protobuf/compiler/java_leo/java_helpers.h>
 #include <google/protobuf/compiler/java_leo/java_name_resolver.h>
+#include <google/protobuf/compiler/java_leo/java_off_heap.h>
+#include <google/protobuf/compiler/java_leo/java_table.h>
+#include <google/protobuf/compiler/java_leo/java_view.h>
 #include <google/protobuf/io/printer.h>
 #include <google/protobuf/wire_format.h>
 #include <google/protobuf/stubs/strutil.h>
@@ -220,6 +223,14 @@ int ImmutableMessageGenerator::GenerateFieldAccessorTableInitializer(
       "    new java.lang.String[] { ",
       "identifier", UniqueFileScopeIdentifier(descriptor_), "ver",
       GeneratedCodeVersionSuffix());
+  bytecode_estimate += GenerateFieldAccessorNames(printer);
+  printer->Print("});\n");
+  return bytecode_estimate;
+}
+
+int ImmutableMessageGenerator::GenerateFieldAccessorNames(
+    io::Printer* printer) {
+  int bytecode_estimate = 0;
   for (int i = 0; i < descriptor_->field_count(); i++) {
     const FieldDescriptor* field = descriptor_->field(i);
     const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
@@ -233,10 +244,48 @@ int ImmutableMessageGenerator::GenerateFieldAccessorTableInitializer(
     bytecode_estimate += 6;
     printer->Print("\"$oneof_name$\", ", "oneof_name", info->capitalized_name);
   }
-  printer->Print("});\n");
   return bytecode_estimate;
 }
 
+void ImmutableMessageGenerator::GenerateDescriptorHolder(
+    io::Printer* printer) {
+  // Nothing but getDescriptor() and internalGetFieldAccessorTable() touches
+  // the holder, so loading the message class does not build any descriptor.
+  std::map<std::string, std::string> vars;
+  vars["index"] = StrCat(descriptor_->index());
+  vars["fileclass"] = name_resolver_->GetImmutableClassName(descriptor_->file());
+  vars["ver"] = GeneratedCodeVersionSuffix();
+  printer->Print(vars,
+                 "private static final class DescriptorHolder {\n"
+                 "  static final com.google.protobuf.Descriptors.Descriptor\n"
+                 "    descriptor =\n");
+  if (descriptor_->containing_type() == NULL) {
+    printer->Print(vars,
+                   "      $fileclass$.getDescriptor().getMessageTypes().get("
+                   "$index$);\n");
+  } else {
+    vars["parent"] =
+        name_resolver_->GetImmutableClassName(descriptor_->containing_type());
+    printer->Print(
+        vars,
+        "      $parent$.DescriptorHolder.descriptor.getNestedTypes().get("
+        "$index$);\n");
+  }
+  printer->Print(
+      vars,
+      "  static final\n"
+      "    com.google.protobuf.GeneratedMessage$ver$.FieldAccessorTable\n"
+      "      fieldAccessorTable = new\n"
+      "        com.google.protobuf.GeneratedMessage$ver$.FieldAccessorTable(\n"
+      "          descriptor,\n"
+      "          new java.lang.String[] { ");
+  GenerateFieldAccessorNames(printer);
+  printer->Print(
+      "});\n"
+      "}\n"
+      "\n");
+}
+
 // ===================================================================
 
 void ImmutableMessageGenerator::GenerateInterface(io::Printer* printer) {
@@ -257,11 +306,13 @@ void ImmutableMessageGenerator::GenerateInterface(io::Printer* printer) {
     printer->Print(
         "$deprecation$public interface ${$$classname$Interface$}$<SELF> extends\n"
         "    $extra_interfaces$\n"
-        "    com.google.protobuf.MessageOrBuilder {\n",
+        "    com.google.protobuf.$or_builder$ {\n",
         "deprecation",
         descriptor_->options().deprecated() ? "@java.lang.Deprecated " : "",
         "extra_interfaces", ExtraMessageOrBuilderInterfaces(descriptor_),
-        "classname", descriptor_->name(), "{", "", "}", "");
+        "classname", descriptor_->name(), "{", "", "}", "", "or_builder",
+        IsLean(descriptor_->file()) ? "MessageLiteOrBuilder"
+                                    : "MessageOrBuilder");
   }
   printer->Annotate("{", "}", descriptor_);
 
@@ -335,6 +386,8 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
     printer->Annotate("classname", descriptor_);
     if (customSuperclass) {
       printer->Print(variables, "    $classname$Custom");
+    } else if (IsLean(descriptor_->file())) {
+      printer->Print(variables, "    com.google.protobuf.GeneratedMessageLean");
     } else {
       printer->Print(variables, "    de.leohilbert.proto.GeneratedMessageLeo");
     }
@@ -355,14 +408,16 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
       "}\n"
       "\n");
 
-  printer->Print(variables,
-                 "@java.lang.Override\n"
-                 "@SuppressWarnings({\"unused\"})\n"
-                 "protected java.lang.Object newInstance(\n"
-                 "    UnusedPrivateParameter unused) {\n"
-                 "  return new $classname$();\n"
-                 "}\n"
-                 "\n");
+  if (!IsLean(descriptor_->file())) {
+    printer->Print(variables,
+                   "@java.lang.Override\n"
+                   "@SuppressWarnings({\"unused\"})\n"
+                   "protected java.lang.Object newInstance(\n"
+                   "    UnusedPrivateParameter unused) {\n"
+                   "  return new $classname$();\n"
+                   "}\n"
+                   "\n");
+  }
 
   printer->Print(
       "@java.lang.Override\n"
@@ -376,9 +431,15 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
   }
 
   // !!!! Leo !!!! Splitting up Constructor and Proto-parsing
-  GenerateUpdateFromMethod(printer);
+  GenerateUpdateFromMethod(printer, false);
+  if (UseFieldMasks(descriptor_)) {
+    GenerateFieldMaskMethods(printer);
+    GenerateUpdateFromMethod(printer, true);
+  }
 
-  GenerateDescriptorMethods(printer);
+  if (!IsLean(descriptor_->file())) {
+    GenerateDescriptorMethods(printer);
+  }
 
   // Nested types
   for (int i = 0; i < descriptor_->enum_type_count(); i++) {
@@ -392,6 +453,16 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
                                                context_);
     messageGenerator.GenerateInterface(printer);
     messageGenerator.Generate(printer);
+    if (UseTable(descriptor_->nested_type(i))) {
+      TableGenerator(descriptor_->nested_type(i), context_).Generate(printer);
+    }
+    if (UseView(descriptor_->nested_type(i))) {
+      ViewGenerator(descriptor_->nested_type(i), context_).Generate(printer);
+    }
+    if (UseOffHeap(descriptor_->nested_type(i))) {
+      OffHeapGenerator(descriptor_->nested_type(i), context_)
+          .Generate(printer);
+    }
   }
 
   // Integers for bit fields.
@@ -417,6 +488,10 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
     printer->Print(vars,
                    "private int $oneof_name$Case_ = 0;\n"
                    "private java.lang.Object $oneof_name$_;\n");
+    if (HasOneofBits(oneof)) {
+      // numeric and bool members, so setting them does not box
+      printer->Print(vars, "private long $oneof_name$Bits_;\n");
+    }
     // OneofCase enum
     printer->Print(
         vars,
@@ -495,11 +570,23 @@ void ImmutableMessageGenerator::Generate(io::Printer* printer) {
   if (context_->HasGeneratedMethods(descriptor_)) {
     GenerateIsInitialized(printer);
     GenerateMessageSerializationMethods(printer);
+    if (UseFieldMasks(descriptor_)) {
+      GenerateMaskedSerializationMethods(printer);
+    }
     GenerateEqualsAndHashCode(printer);
+    GenerateDiffMethods(printer);
   }
 
   GenerateClearMethod(printer);
+  GenerateCopyFromMethod(printer);
+  GenerateFreezeMethods(printer);
+  if (UseSeqLock(descriptor_)) {
+    GenerateSeqLockMethods(printer);
+  }
+  GenerateFieldByNumberMethods(printer);
   GenerateToStringMethod(printer);
+  GenerateJsonMethods(printer);
+  GenerateJsonParsingMethods(printer);
 
   GenerateParseFromMethods(printer);
 
@@ -669,6 +756,88 @@ void ImmutableMessageGenerator::GenerateMessageSerializationMethods(
       "\n");
 }
 
+// Only the fields selected by the mask are written, unknown fields and
+// extensions are left out.
+void ImmutableMessageGenerator::GenerateMaskedSerializationMethods(
+    io::Printer* printer) {
+  std::unique_ptr<const FieldDescriptor* []> sorted_fields(
+      SortFieldsByNumber(descriptor_));
+
+  printer->Print(
+      "/**\n"
+      " * Writes only the fields selected by {@code mask}, unknown fields are "
+      "left out.\n"
+      " *\n"
+      " * @param mask compiled once by {@link #compileMask(java.lang.String...)}"
+      "\n"
+      " */\n"
+      "public void writeTo(com.google.protobuf.CodedOutputStream output,\n"
+      "                    de.leohilbert.proto.FieldMask mask)\n"
+      "                    throws java.io.IOException {\n");
+  printer->Indent();
+  if (HasPackedFields(descriptor_)) {
+    // memoizes the sizes of the selected packed fields
+    printer->Print("getSerializedSize(mask);\n");
+  }
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    PrintMaskedFieldCode(printer, sorted_fields[i], true);
+  }
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n"
+      "/**\n"
+      " * The number of bytes {@link #writeTo(com.google.protobuf.CodedOutputStream, "
+      "de.leohilbert.proto.FieldMask)}\n"
+      " * writes with the same mask.\n"
+      " */\n"
+      "public int getSerializedSize(de.leohilbert.proto.FieldMask mask) {\n");
+  printer->Indent();
+  printer->Print("int size = 0;\n");
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    PrintMaskedFieldCode(printer, sorted_fields[i], false);
+  }
+  printer->Print("return size;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
+void ImmutableMessageGenerator::PrintMaskedFieldCode(
+    io::Printer* printer, const FieldDescriptor* field, bool write) {
+  const ImmutableFieldGenerator& generator = field_generators_.get(field);
+  printer->Print("if (mask.contains($index$)) {\n", "index",
+                 StrCat(field->index()));
+  printer->Indent();
+  if (HasNestedFieldMask(field)) {
+    printer->Print(
+        "de.leohilbert.proto.FieldMask nested = mask.nested($index$);\n"
+        "if (nested != null) {\n",
+        "index", StrCat(field->index()));
+    printer->Indent();
+    if (write) {
+      generator.GenerateMaskedSerializationCode(printer);
+    } else {
+      generator.GenerateMaskedSerializedSizeCode(printer);
+    }
+    printer->Outdent();
+    printer->Print("} else {\n");
+    printer->Indent();
+  }
+  if (write) {
+    generator.GenerateSerializationCode(printer);
+  } else {
+    generator.GenerateSerializedSizeCode(printer);
+  }
+  if (HasNestedFieldMask(field)) {
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
 void ImmutableMessageGenerator::GenerateParseFromMethods(io::Printer* printer) {
   // Note:  These are separate from GenerateMessageSerializationMethods()
   //   because they need to be generated even for messages that are optimized
@@ -708,46 +877,46 @@ void ImmutableMessageGenerator::GenerateParseFromMethods(io::Printer* printer) {
       "}\n"
       "public static $classname$ parseFrom(java.io.InputStream input)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseWithIOException(PARSER, input);\n"
       "}\n"
       "public static $classname$ parseFrom(\n"
       "    java.io.InputStream input,\n"
       "    com.google.protobuf.ExtensionRegistryLite extensionRegistry)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseWithIOException(PARSER, input, extensionRegistry);\n"
       "}\n"
       "public static $classname$ parseDelimitedFrom(java.io.InputStream "
       "input)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseDelimitedWithIOException(PARSER, input);\n"
       "}\n"
       "public static $classname$ parseDelimitedFrom(\n"
       "    java.io.InputStream input,\n"
       "    com.google.protobuf.ExtensionRegistryLite extensionRegistry)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseDelimitedWithIOException(PARSER, input, "
       "extensionRegistry);\n"
       "}\n"
       "public static $classname$ parseFrom(\n"
       "    com.google.protobuf.CodedInputStream input)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseWithIOException(PARSER, input);\n"
       "}\n"
       "public static $classname$ parseFrom(\n"
       "    com.google.protobuf.CodedInputStream input,\n"
       "    com.google.protobuf.ExtensionRegistryLite extensionRegistry)\n"
       "    throws java.io.IOException {\n"
-      "  return com.google.protobuf.GeneratedMessage$ver$\n"
+      "  return $base$\n"
       "      .parseWithIOException(PARSER, input, extensionRegistry);\n"
       "}\n"
       "\n",
-      "classname", name_resolver_->GetImmutableClassName(descriptor_), "ver",
-      GeneratedCodeVersionSuffix());
+      "classname", name_resolver_->GetImmutableClassName(descriptor_), "base",
+      GeneratedMessageBaseClass(descriptor_->file()));
 }
 
 void ImmutableMessageGenerator::GenerateSerializeOneField(
@@ -765,15 +934,22 @@ void ImmutableMessageGenerator::GenerateSerializeOneExtensionRange(
 
 void ImmutableMessageGenerator::GenerateDescriptorMethods(
     io::Printer* printer) {
+  const bool lazy = UseLazyDescriptors(descriptor_->file());
+  if (lazy) {
+    GenerateDescriptorHolder(printer);
+  }
   if (!descriptor_->options().no_standard_descriptor_accessor()) {
     printer->Print(
         "public static final com.google.protobuf.Descriptors.Descriptor\n"
         "    getDescriptor() {\n"
-        "  return $fileclass$.internal_$identifier$_descriptor;\n"
+        "  return $descriptor$;\n"
         "}\n"
         "\n",
-        "fileclass", name_resolver_->GetImmutableClassName(descriptor_->file()),
-        "identifier", UniqueFileScopeIdentifier(descriptor_));
+        "descriptor",
+        lazy ? "DescriptorHolder.descriptor"
+             : name_resolver_->GetImmutableClassName(descriptor_->file()) +
+                   ".internal_" + UniqueFileScopeIdentifier(descriptor_) +
+                   "_descriptor");
   }
   std::vector<const FieldDescriptor*> map_fields;
   for (int i = 0; i < descriptor_->field_count(); i++) {
@@ -815,15 +991,18 @@ void ImmutableMessageGenerator::GenerateDescriptorMethods(
       "@java.lang.Override\n"
       "protected com.google.protobuf.GeneratedMessage$ver$.FieldAccessorTable\n"
       "    internalGetFieldAccessorTable() {\n"
-      "  return $fileclass$.internal_$identifier$_fieldAccessorTable\n"
+      "  return $table$\n"
       "      .ensureFieldAccessorsInitialized(\n"
       "          $classname$.class);\n"
       "}\n"
       "\n",
       "classname", name_resolver_->GetImmutableClassName(descriptor_),
-      "fileclass", name_resolver_->GetImmutableClassName(descriptor_->file()),
-      "identifier", UniqueFileScopeIdentifier(descriptor_), "ver",
-      GeneratedCodeVersionSuffix());
+      "table",
+      lazy ? "DescriptorHolder.fieldAccessorTable"
+           : name_resolver_->GetImmutableClassName(descriptor_->file()) +
+                 ".internal_" + UniqueFileScopeIdentifier(descriptor_) +
+                 "_fieldAccessorTable",
+      "ver", GeneratedCodeVersionSuffix());
 }
 
 // ===================================================================
@@ -1044,7 +1223,12 @@ void ImmutableMessageGenerator::GenerateEqualsAndHashCode(
       "int hash = 41;\n");
 
   // If we output a getDescriptor() method, use that as it is more efficient.
-  if (descriptor_->options().no_standard_descriptor_accessor()) {
+  // With lazy descriptors hashing must not build the descriptor and lean
+  // messages have none, so the full name stands in for it.
+  if (UseLazyDescriptors(descriptor_->file()) || IsLean(descriptor_->file())) {
+    printer->Print("hash = (19 * hash) + \"$full_name$\".hashCode();\n",
+                   "full_name", descriptor_->full_name());
+  } else if (descriptor_->options().no_standard_descriptor_accessor()) {
     printer->Print("hash = (19 * hash) + getDescriptorForType().hashCode();\n");
   } else {
     printer->Print("hash = (19 * hash) + getDescriptor().hashCode();\n");
@@ -1103,6 +1287,167 @@ void ImmutableMessageGenerator::GenerateEqualsAndHashCode(
       "\n");
 }
 
+void ImmutableMessageGenerator::GenerateDiffMethods(io::Printer* printer) {
+  std::map<std::string, std::string> vars;
+  vars["classname"] = name_resolver_->GetImmutableClassName(descriptor_);
+  // one long per 64 fields, the bit of a field is its index in the message
+  int words = (descriptor_->field_count() + 63) / 64;
+
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    printer->Print("public static final long $diff_bit$ = 1L << $shift$;\n",
+                   "diff_bit", FieldDiffBitName(descriptor_->field(i)),
+                   "shift", StrCat(i % 64));
+  }
+  printer->Print("\n");
+
+  printer->Print(
+      vars,
+      "/**\n"
+      " * Returns a mask with the {@code *_DIFF_BIT} of every field that is not\n"
+      " * equal in {@code other}.\n"
+      " */\n"
+      "public long diffMask($classname$ other) {\n");
+  if (words > 1) {
+    printer->Print(
+        "  return diffMask(other, 0);\n"
+        "}\n"
+        "\n");
+    printer->Print(
+        vars,
+        "/**\n"
+        " * Same as {@link #diffMask($classname$)} for the fields 64 * word to\n"
+        " * 64 * word + 63.\n"
+        " */\n"
+        "public long diffMask($classname$ other, int word) {\n");
+  }
+  printer->Indent();
+  printer->Print("long mask = 0L;\n");
+  if (words > 1) {
+    printer->Print("switch (word) {\n");
+    printer->Indent();
+  }
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    if (words > 1 && i % 64 == 0) {
+      if (i > 0) {
+        printer->Print("  break;\n");
+      }
+      printer->Print("case $word$:\n", "word", StrCat(i / 64));
+    }
+    if (words > 1) {
+      printer->Indent();
+    }
+    const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
+    if (IsRealOneof(field)) {
+      printer->Print(
+          "if (($oneof_name$Case_ == $number$) != (other.$oneof_name$Case_ == $number$)) {\n"
+          "  mask |= $diff_bit$;\n"
+          "} else if ($oneof_name$Case_ == $number$) {\n",
+          "oneof_name",
+          context_->GetOneofGeneratorInfo(field->containing_oneof())->name,
+          "number", StrCat(field->number()), "diff_bit",
+          FieldDiffBitName(field));
+      printer->Indent();
+      field_generators_.get(field).GenerateDiffCode(printer);
+      printer->Outdent();
+      printer->Print("}\n");
+    } else if (CheckHasBitsForEqualsAndHashCode(field)) {
+      printer->Print(
+          "if (has$name$() != other.has$name$()) {\n"
+          "  mask |= $diff_bit$;\n"
+          "} else if (has$name$()) {\n",
+          "name", info->capitalized_name, "diff_bit", FieldDiffBitName(field));
+      printer->Indent();
+      field_generators_.get(field).GenerateDiffCode(printer);
+      printer->Outdent();
+      printer->Print("}\n");
+    } else {
+      field_generators_.get(field).GenerateDiffCode(printer);
+    }
+    if (words > 1) {
+      printer->Outdent();
+    }
+  }
+  if (words > 1) {
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+  printer->Print("return mask;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+
+  printer->Print(
+      vars,
+      "/**\n"
+      " * Returns the paths of all fields that are not equal in {@code other}.\n"
+      " * Nested messages are compared recursively, e.g. \"phones[0].number\".\n"
+      " */\n"
+      "public java.util.List<java.lang.String> diffPaths($classname$ other) {\n"
+      "  java.util.List<java.lang.String> paths = new java.util.ArrayList<>();\n"
+      "  diffPaths(other, \"\", paths);\n"
+      "  return paths;\n"
+      "}\n"
+      "\n"
+      "public void diffPaths($classname$ other, java.lang.String prefix,\n"
+      "    java.util.List<java.lang.String> paths) {\n");
+  printer->Indent();
+  if (words > 1) {
+    for (int w = 0; w < words; w++) {
+      printer->Print("long mask$word$ = diffMask(other, $word$);\n", "word",
+                     StrCat(w));
+    }
+  } else {
+    printer->Print(
+        "long mask = diffMask(other);\n"
+        "if (mask == 0L) {\n"
+        "  return;\n"
+        "}\n");
+  }
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    std::map<std::string, std::string> field_vars;
+    field_vars["mask"] = words > 1 ? "mask" + StrCat(i / 64) : "mask";
+    field_vars["diff_bit"] = FieldDiffBitName(field);
+    field_vars["name"] = context_->GetFieldGeneratorInfo(field)->name;
+    field_vars["path"] = field->name();
+    printer->Print(field_vars, "if (($mask$ & $diff_bit$) != 0L) {\n");
+    printer->Indent();
+    if (GetJavaType(field) == JAVATYPE_MESSAGE && !IsMapField(field) &&
+        !IsRealOneof(field)) {
+      if (field->is_repeated()) {
+        printer->Print(
+            field_vars,
+            "if ($name$_.size() == other.$name$_.size()) {\n"
+            "  for (int i = 0; i < $name$_.size(); i++) {\n"
+            "    $name$_.get(i).diffPaths(other.$name$_.get(i),\n"
+            "        prefix + \"$path$[\" + i + \"].\", paths);\n"
+            "  }\n"
+            "} else {\n"
+            "  paths.add(prefix + \"$path$\");\n"
+            "}\n");
+      } else {
+        printer->Print(
+            field_vars,
+            "if ($name$_ != null && other.$name$_ != null) {\n"
+            "  $name$_.diffPaths(other.$name$_, prefix + \"$path$.\", paths);\n"
+            "} else {\n"
+            "  paths.add(prefix + \"$path$\");\n"
+            "}\n");
+      }
+    } else {
+      printer->Print(field_vars, "paths.add(prefix + \"$path$\");\n");
+    }
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
 // ===================================================================
 
 void ImmutableMessageGenerator::GenerateExtensionRegistrationCode(
@@ -1138,24 +1483,65 @@ void ImmutableMessageGenerator::GenerateParsingConstructor(
 }
 
 // ===================================================================
-void ImmutableMessageGenerator::GenerateUpdateFromMethod(
-    io::Printer* printer) {
+namespace {
+
+void PrintMaskCheck(io::Printer* printer, const FieldDescriptor* field) {
+  printer->Print(
+      "if (!mask.contains($index$)) {\n"
+      "  input.skipField(tag);\n"
+      "  break;\n"
+      "}\n",
+      "index", StrCat(field->index()));
+}
+
+}  // namespace
+
+// With a mask, fields the mask does not select are skipped without being
+// decoded and unknown fields are dropped.
+void ImmutableMessageGenerator::GenerateUpdateFromMethod(io::Printer* printer,
+                                                         bool masked) {
   std::unique_ptr<const FieldDescriptor* []> sorted_fields(
       SortFieldsByNumber(descriptor_));
 
-  printer->Print(
-      "public void updateFrom(\n"
-      "    com.google.protobuf.CodedInputStream input,\n"
-      "    com.google.protobuf.ExtensionRegistryLite extensionRegistry)\n"
-      "    throws com.google.protobuf.InvalidProtocolBufferException {\n",
-      "classname", descriptor_->name());
-  printer->Indent();
+  if (masked) {
+    printer->Print(
+        "/**\n"
+        " * Like {@link #updateFrom(com.google.protobuf.CodedInputStream, "
+        "com.google.protobuf.ExtensionRegistryLite)},\n"
+        " * but only the fields selected by {@code mask} are read, all others "
+        "are skipped\n"
+        " * and keep their default. Unknown fields are dropped.\n"
+        " *\n"
+        " * @param mask compiled once by {@link #compileMask(java.lang.String...)}"
+        "\n"
+        " */\n"
+        "public void updateFrom(\n"
+        "    com.google.protobuf.CodedInputStream input,\n"
+        "    de.leohilbert.proto.FieldMask mask)\n"
+        "    throws com.google.protobuf.InvalidProtocolBufferException {\n");
+    printer->Indent();
+    printer->Print(
+        "com.google.protobuf.ExtensionRegistryLite extensionRegistry =\n"
+        "    com.google.protobuf.ExtensionRegistryLite.getEmptyRegistry();\n"
+        "beforeMessageUpdate();\n");
+  } else {
+    printer->Print(
+        "public void updateFrom(\n"
+        "    com.google.protobuf.CodedInputStream input,\n"
+        "    com.google.protobuf.ExtensionRegistryLite extensionRegistry)\n"
+        "    throws com.google.protobuf.InvalidProtocolBufferException {\n");
+    printer->Indent();
 
-  // Initialize all fields to default.
-  printer->Print(
-      "if (extensionRegistry == null) {\n"
-      "  throw new java.lang.NullPointerException();\n"
-      "}\n");
+    // Initialize all fields to default.
+    printer->Print(
+        "if (extensionRegistry == null) {\n"
+        "  throw new java.lang.NullPointerException();\n"
+        "}\n"
+        "beforeMessageUpdate();\n");
+  }
+  if (UseSeqLock(descriptor_)) {
+    printer->Print("boolean writing = beginWrite();\n");
+  }
 
   // Use builder bits to track mutable repeated fields.
   int totalBuilderBits = 0;
@@ -1170,9 +1556,18 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
                    GetBitFieldName(i));
   }
 
-  printer->Print(
-      "com.google.protobuf.UnknownFieldSet.Builder unknownFields =\n"
-      "    com.google.protobuf.UnknownFieldSet.newBuilder();\n");
+  // The builder is only created for the first unknown field, most messages
+  // never see one.
+  const bool discard_unknown = masked || DiscardUnknownFields(descriptor_);
+  if (!discard_unknown) {
+    printer->Print(
+        "com.google.protobuf.UnknownFieldSet.Builder unknownFields = null;\n");
+  }
+
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    field_generators_.get(descriptor_->field(i))
+        .GenerateParsingPrologueCode(printer);
+  }
 
   printer->Print("try {\n");
   printer->Indent();
@@ -1205,6 +1600,20 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
                    StrCat(static_cast<int32>(tag)));
     printer->Indent();
 
+    if (masked) {
+      PrintMaskCheck(printer, field);
+    }
+    if (masked && HasNestedFieldMask(field)) {
+      printer->Print(
+          "de.leohilbert.proto.FieldMask nested = mask.nested($index$);\n"
+          "if (nested != null) {\n",
+          "index", StrCat(field->index()));
+      printer->Indent();
+      field_generators_.get(field).GenerateMaskedParsingCode(printer);
+      printer->Print("break;\n");
+      printer->Outdent();
+      printer->Print("}\n");
+    }
     field_generators_.get(field).GenerateParsingCode(printer);
 
     printer->Outdent();
@@ -1221,6 +1630,9 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
                      StrCat(static_cast<int32>(packed_tag)));
       printer->Indent();
 
+      if (masked) {
+        PrintMaskCheck(printer, field);
+      }
       field_generators_.get(field).GenerateParsingCodeFromPacked(printer);
 
       printer->Outdent();
@@ -1230,14 +1642,27 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
     }
   }
 
-  printer->Print(
-      "default: {\n"
-      "  if (!parseUnknownField(\n"
-      "      input, unknownFields, extensionRegistry, tag)) {\n"
-      "    done = true;\n"  // it's an endgroup tag
-      "  }\n"
-      "  break;\n"
-      "}\n");
+  if (discard_unknown) {
+    printer->Print(
+        "default: {\n"
+        "  if (!input.skipField(tag)) {\n"
+        "    done = true;\n"  // it's an endgroup tag
+        "  }\n"
+        "  break;\n"
+        "}\n");
+  } else {
+    printer->Print(
+        "default: {\n"
+        "  if (unknownFields == null) {\n"
+        "    unknownFields = com.google.protobuf.UnknownFieldSet.newBuilder();\n"
+        "  }\n"
+        "  if (!parseUnknownField(\n"
+        "      input, unknownFields, extensionRegistry, tag)) {\n"
+        "    done = true;\n"  // it's an endgroup tag
+        "  }\n"
+        "  break;\n"
+        "}\n");
+  }
 
   printer->Outdent();
   printer->Outdent();
@@ -1246,6 +1671,10 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
       "}\n");  // while (!done)
 
   printer->Outdent();
+  if (GetFieldMemorySemantics(descriptor_) == FIELD_MEMORY_RELEASE_ACQUIRE) {
+    // parsed fields are stored plainly, publish them in one go
+    printer->Print("  java.lang.invoke.VarHandle.releaseFence();\n");
+  }
   printer->Print(
       "  afterMessageUpdate();\n"
       "} catch (com.google.protobuf.InvalidProtocolBufferException e) {\n"
@@ -1263,10 +1692,25 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
   }
 
   // Make unknown fields immutable.
-  printer->Print("this.unknownFields = unknownFields.build();\n");
+  if (discard_unknown) {
+    printer->Print(
+        "this.unknownFields = "
+        "com.google.protobuf.UnknownFieldSet.getDefaultInstance();\n");
+  } else {
+    printer->Print(
+        "this.unknownFields = unknownFields == null\n"
+        "    ? com.google.protobuf.UnknownFieldSet.getDefaultInstance()\n"
+        "    : unknownFields.build();\n");
+  }
 
   // Make extensions immutable.
   printer->Print("makeExtensionsImmutable();\n");
+  if (UseSeqLock(descriptor_)) {
+    printer->Print(
+        "if (writing) {\n"
+        "  endWrite();\n"
+        "}\n");
+  }
 
   printer->Outdent();
   printer->Outdent();
@@ -1275,6 +1719,82 @@ void ImmutableMessageGenerator::GenerateUpdateFromMethod(
       "}\n");
 }
 
+// ===================================================================
+void ImmutableMessageGenerator::GenerateFieldMaskMethods(io::Printer* printer) {
+  printer->Print(
+      "\n"
+      "/**\n"
+      " * Compiles field paths like {@code \"name\"} or {@code \"inner.name\"} "
+      "into a mask for\n"
+      " * {@link #updateFrom(com.google.protobuf.CodedInputStream, "
+      "de.leohilbert.proto.FieldMask)}.\n"
+      " * Compile a mask once and reuse it for every message.\n"
+      " *\n"
+      " * @throws java.lang.IllegalArgumentException for a path that names no "
+      "field\n"
+      " */\n"
+      "public static de.leohilbert.proto.FieldMask compileMask("
+      "java.lang.String... paths) {\n"
+      "  de.leohilbert.proto.FieldMask mask = "
+      "new de.leohilbert.proto.FieldMask($field_count$);\n"
+      "  for (java.lang.String path : paths) {\n"
+      "    compileMaskPath(mask, path);\n"
+      "  }\n"
+      "  return mask;\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Adds a path of this message to {@code mask}, see "
+      "{@link #compileMask(java.lang.String...)}.\n"
+      " */\n"
+      "public static void compileMaskPath(\n"
+      "    de.leohilbert.proto.FieldMask mask, java.lang.String path) {\n"
+      "  int dot = path.indexOf('.');\n"
+      "  switch (dot < 0 ? path : path.substring(0, dot)) {\n",
+      "field_count", StrCat(descriptor_->field_count()));
+  printer->Indent();
+  printer->Indent();
+
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    std::map<std::string, std::string> vars;
+    vars["name"] = field->name();
+    vars["index"] = StrCat(field->index());
+    printer->Print(vars, "case \"$name$\":\n");
+    if (HasNestedFieldMask(field)) {
+      vars["type"] = name_resolver_->GetImmutableClassName(field->message_type());
+      vars["field_count"] = StrCat(field->message_type()->field_count());
+      printer->Print(
+          vars,
+          "  if (dot < 0) {\n"
+          "    mask.add($index$);\n"
+          "  } else {\n"
+          "    $type$.compileMaskPath(\n"
+          "        mask.addNested($index$, $field_count$), "
+          "path.substring(dot + 1));\n"
+          "  }\n"
+          "  return;\n");
+    } else {
+      printer->Print(vars,
+                     "  if (dot < 0) {\n"
+                     "    mask.add($index$);\n"
+                     "    return;\n"
+                     "  }\n"
+                     "  break;\n");
+    }
+  }
+
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "  }\n"
+      "  throw new java.lang.IllegalArgumentException(\n"
+      "      \"no field \" + path + \" in $full_name$\");\n"
+      "}\n"
+      "\n",
+      "full_name", descriptor_->full_name());
+}
+
 // ===================================================================
 void ImmutableMessageGenerator::GenerateParser(io::Printer* printer) {
   printer->Print(
@@ -1401,6 +1921,8 @@ void ImmutableMessageGenerator::GenerateClearMethod(io::Printer* printer) {
       "public void clear() {\n");
 
   printer->Indent();
+  printer->Print("beforeMessageUpdate();\n");
+  PrintBeginWrite(printer, descriptor_);
 
   for (int i = 0; i < descriptor_->field_count(); i++) {
     if (!descriptor_->field(i)->containing_oneof()) {
@@ -1414,7 +1936,12 @@ void ImmutableMessageGenerator::GenerateClearMethod(io::Printer* printer) {
         "$oneof_name$Case_ = 0;\n"
         "$oneof_name$_ = null;\n",
         "oneof_name", context_->GetOneofGeneratorInfo(oneof)->name);
+    if (HasOneofBits(oneof)) {
+      printer->Print("$oneof_name$Bits_ = 0L;\n", "oneof_name",
+                     context_->GetOneofGeneratorInfo(oneof)->name);
+    }
   }
+  PrintEndWrite(printer, descriptor_);
 
   printer->Outdent();
 
@@ -1423,6 +1950,462 @@ void ImmutableMessageGenerator::GenerateClearMethod(io::Printer* printer) {
       "\n");
 }
 
+void ImmutableMessageGenerator::GenerateCopyFromMethod(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Copies all fields of {@code other} into this message without a\n"
+      " * serialization round-trip. Nested messages and repeated fields are\n"
+      " * deep-copied, immutable values are shared.\n"
+      " */\n"
+      "public $classname$ copyFrom($classname$ other) {\n",
+      "classname", name_resolver_->GetImmutableClassName(descriptor_));
+  printer->Indent();
+  // the repeated fields are cleared before the elements of other are added
+  printer->Print(
+      "if (other == this) {\n"
+      "  return this;\n"
+      "}\n"
+      "beforeMessageUpdate();\n");
+  PrintBeginWrite(printer, descriptor_);
+
+  int totalBits = 0;
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    totalBits +=
+        field_generators_.get(descriptor_->field(i)).GetNumBitsForMessage();
+  }
+  int totalInts = (totalBits + 31) / 32;
+  for (int i = 0; i < totalInts; i++) {
+    printer->Print("$bit_field_name$ = other.$bit_field_name$;\n",
+                   "bit_field_name", GetBitFieldName(i));
+  }
+
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    if (!IsRealOneof(descriptor_->field(i))) {
+      field_generators_.get(descriptor_->field(i)).GenerateCopyCode(printer);
+    }
+  }
+
+  for (auto oneof : oneofs_) {
+    printer->Print("switch (other.$oneof_name$Case_) {\n", "oneof_name",
+                   context_->GetOneofGeneratorInfo(oneof)->name);
+    printer->Indent();
+    for (int j = 0; j < (oneof)->field_count(); j++) {
+      const FieldDescriptor* field = (oneof)->field(j);
+      printer->Print("case $field_number$:\n", "field_number",
+                     StrCat(field->number()));
+      printer->Indent();
+      field_generators_.get(field).GenerateCopyCode(printer);
+      printer->Print("break;\n");
+      printer->Outdent();
+    }
+    printer->Print(
+        "default:\n"
+        "  $oneof_name$_ = null;\n",
+        "oneof_name", context_->GetOneofGeneratorInfo(oneof)->name);
+    printer->Outdent();
+    printer->Print(
+        "}\n"
+        "$oneof_name$Case_ = other.$oneof_name$Case_;\n",
+        "oneof_name", context_->GetOneofGeneratorInfo(oneof)->name);
+  }
+
+  // UnknownFieldSet is immutable
+  printer->Print("this.unknownFields = other.unknownFields;\n");
+  if (GetFieldMemorySemantics(descriptor_) == FIELD_MEMORY_RELEASE_ACQUIRE) {
+    printer->Print("java.lang.invoke.VarHandle.releaseFence();\n");
+  }
+  // 0 is no field number, it stands for the whole message
+  printer->Print("onChanged(0);\n");
+  PrintEndWrite(printer, descriptor_);
+  printer->Print(
+      "afterMessageUpdate();\n"
+      "return this;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n"
+      "public $classname$ deepCopy() {\n"
+      "  return new $classname$().copyFrom(this);\n"
+      "}\n"
+      "\n",
+      "classname", name_resolver_->GetImmutableClassName(descriptor_));
+}
+
+
+namespace {
+// Nested messages are frozen recursively by freeze(), everything else is
+// copied into the snapshot by freezeFrom().
+bool IsFrozenRecursively(const FieldDescriptor* field) {
+  return GetJavaType(field) == JAVATYPE_MESSAGE && !IsMapField(field);
+}
+
+bool HasFrozenRecursively(const OneofDescriptor* oneof) {
+  for (int i = 0; i < oneof->field_count(); i++) {
+    if (IsFrozenRecursively(oneof->field(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+void ImmutableMessageGenerator::GenerateFreezeMethods(io::Printer* printer) {
+  std::map<std::string, std::string> vars;
+  vars["classname"] = name_resolver_->GetImmutableClassName(descriptor_);
+  printer->Print(
+      vars,
+      "/**\n"
+      " * Returns an immutable snapshot of this message. Nested messages that\n"
+      " * did not change since the last freeze() are shared with the previous\n"
+      " * snapshot. Changes that bypass the setters, e.g. through lists returned\n"
+      " * by getters or inside javatype values, are not tracked.\n"
+      " */\n"
+      "public $classname$ freeze() {\n"
+      "  if (isFrozen()) {\n"
+      "    return this;\n"
+      "  }\n"
+      "  $classname$ previous = ($classname$) frozenSnapshot;\n");
+  printer->Indent();
+
+  // freeze the children first, the previous snapshot can be reused if all of
+  // them are unchanged
+  std::vector<std::pair<std::string, std::string> > frozen_children;
+  bool has_message_map = false;
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    if (IsMapField(field) &&
+        GetJavaType(field->message_type()->field(1)) == JAVATYPE_MESSAGE) {
+      has_message_map = true;
+    }
+    if (IsRealOneof(field) || !IsFrozenRecursively(field)) {
+      continue;
+    }
+    const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
+    std::map<std::string, std::string> field_vars;
+    field_vars["name"] = info->name;
+    field_vars["capitalized_name"] = info->capitalized_name;
+    field_vars["type"] =
+        name_resolver_->GetImmutableClassName(field->message_type());
+    if (field->is_repeated()) {
+      printer->Print(
+          field_vars,
+          "java.util.List<$type$> frozen$capitalized_name$ =\n"
+          "    de.leohilbert.proto.Snapshots.freezeList($name$_,\n"
+          "        previous == null ? null : previous.$name$_,\n"
+          "        $type$::freeze);\n");
+    } else {
+      printer->Print(
+          field_vars,
+          "$type$ frozen$capitalized_name$ =\n"
+          "    $name$_ == null ? null : $name$_.freeze();\n");
+    }
+    frozen_children.push_back(
+        std::make_pair(info->name, info->capitalized_name));
+  }
+  for (auto oneof : oneofs_) {
+    if (!HasFrozenRecursively(oneof)) {
+      continue;
+    }
+    const OneofGeneratorInfo* info = context_->GetOneofGeneratorInfo(oneof);
+    printer->Print("java.lang.Object frozen$capitalized_name$ = $name$_;\n",
+                   "name", info->name, "capitalized_name",
+                   info->capitalized_name);
+    for (int j = 0; j < oneof->field_count(); j++) {
+      const FieldDescriptor* field = oneof->field(j);
+      if (!IsFrozenRecursively(field)) {
+        continue;
+      }
+      printer->Print(
+          "if ($name$Case_ == $number$) {\n"
+          "  frozen$capitalized_name$ = (($type$) $name$_).freeze();\n"
+          "}\n",
+          "name", info->name, "capitalized_name", info->capitalized_name,
+          "number", StrCat(field->number()), "type",
+          name_resolver_->GetImmutableClassName(field->message_type()));
+    }
+    frozen_children.push_back(
+        std::make_pair(info->name, info->capitalized_name));
+  }
+
+  // message values of maps are only copied, so a snapshot containing them
+  // can not be reused
+  if (!has_message_map) {
+    printer->Print("if (previous != null");
+    for (const auto& child : frozen_children) {
+      printer->Print("\n    && frozen$capitalized_name$ == previous.$name$_",
+                     "name", child.first, "capitalized_name", child.second);
+    }
+    printer->Print(
+        ") {\n"
+        "  return previous;\n"
+        "}\n");
+  }
+
+  printer->Print(vars,
+                 "$classname$ snapshot = new $classname$();\n"
+                 "snapshot.freezeFrom(this);\n");
+  for (const auto& child : frozen_children) {
+    printer->Print("snapshot.$name$_ = frozen$capitalized_name$;\n", "name",
+                   child.first, "capitalized_name", child.second);
+  }
+  printer->Print(
+      "snapshot.markFrozen();\n"
+      "frozenSnapshot = snapshot;\n"
+      "return snapshot;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+
+  printer->Print(vars, "private void freezeFrom($classname$ other) {\n");
+  printer->Indent();
+  int totalBits = 0;
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    totalBits +=
+        field_generators_.get(descriptor_->field(i)).GetNumBitsForMessage();
+  }
+  int totalInts = (totalBits + 31) / 32;
+  for (int i = 0; i < totalInts; i++) {
+    printer->Print("$bit_field_name$ = other.$bit_field_name$;\n",
+                   "bit_field_name", GetBitFieldName(i));
+  }
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    if (!IsRealOneof(field) && !IsFrozenRecursively(field)) {
+      field_generators_.get(field).GenerateCopyCode(printer);
+      field_generators_.get(field).GenerateFreezeCode(printer);
+    }
+  }
+  for (auto oneof : oneofs_) {
+    const OneofGeneratorInfo* info = context_->GetOneofGeneratorInfo(oneof);
+    if (!HasFrozenRecursively(oneof)) {
+      printer->Print("switch (other.$oneof_name$Case_) {\n", "oneof_name",
+                     info->name);
+      printer->Indent();
+      for (int j = 0; j < oneof->field_count(); j++) {
+        const FieldDescriptor* field = oneof->field(j);
+        printer->Print("case $field_number$:\n", "field_number",
+                       StrCat(field->number()));
+        printer->Indent();
+        field_generators_.get(field).GenerateCopyCode(printer);
+        printer->Print("break;\n");
+        printer->Outdent();
+      }
+      printer->Outdent();
+      printer->Print("}\n");
+    } else if (HasOneofBits(oneof)) {
+      printer->Print("$oneof_name$Bits_ = other.$oneof_name$Bits_;\n",
+                     "oneof_name", info->name);
+    }
+    printer->Print("$oneof_name$Case_ = other.$oneof_name$Case_;\n",
+                   "oneof_name", info->name);
+  }
+  printer->Print("this.unknownFields = other.unknownFields;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
+
+void ImmutableMessageGenerator::GenerateSeqLockMethods(io::Printer* printer) {
+  // Single writer seqlock: the counter is odd while a write is in progress.
+  // Nested writes (e.g. the clear() in updateFrom) keep the outer bracket.
+  printer->Print(
+      "private long seqlock;\n"
+      "private static final java.lang.invoke.VarHandle SEQLOCK =\n"
+      "    de.leohilbert.proto.FieldHandles.find(\n"
+      "        java.lang.invoke.MethodHandles.lookup(), \"seqlock\", long.class);\n"
+      "\n"
+      "private boolean beginWrite() {\n"
+      "  long seq = seqlock;\n"
+      "  if ((seq & 1L) != 0L) {\n"
+      "    return false;\n"
+      "  }\n"
+      "  SEQLOCK.setOpaque(this, seq + 1L);\n"
+      "  java.lang.invoke.VarHandle.storeStoreFence();\n"
+      "  return true;\n"
+      "}\n"
+      "\n"
+      "private $classname$ endWrite() {\n"
+      "  long seq = seqlock;\n"
+      "  if ((seq & 1L) != 0L) {\n"
+      "    SEQLOCK.setRelease(this, seq + 1L);\n"
+      "  }\n"
+      "  return this;\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Runs {@code reader} until it saw this message without a concurrent\n"
+      " * write. The reader may run several times, so it should only read.\n"
+      " */\n"
+      "public void readConsistent(\n"
+      "    java.util.function.Consumer<? super $classname$> reader) {\n"
+      "  while (!tryRead(reader)) {\n"
+      "    java.lang.Thread.onSpinWait();\n"
+      "  }\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Runs {@code reader} once. Returns false if this message was written\n"
+      " * meanwhile, in which case everything it read has to be discarded.\n"
+      " */\n"
+      "public boolean tryRead(\n"
+      "    java.util.function.Consumer<? super $classname$> reader) {\n"
+      "  long seq = (long) SEQLOCK.getAcquire(this);\n"
+      "  if ((seq & 1L) != 0L) {\n"
+      "    return false;\n"
+      "  }\n"
+      "  try {\n"
+      "    reader.accept(this);\n"
+      "  } catch (java.lang.RuntimeException e) {\n"
+      "    // torn reads may throw, e.g. while a list is resized\n"
+      "    java.lang.invoke.VarHandle.loadLoadFence();\n"
+      "    if ((long) SEQLOCK.getOpaque(this) != seq) {\n"
+      "      return false;\n"
+      "    }\n"
+      "    throw e;\n"
+      "  }\n"
+      "  java.lang.invoke.VarHandle.loadLoadFence();\n"
+      "  return (long) SEQLOCK.getOpaque(this) == seq;\n"
+      "}\n"
+      "\n",
+      "classname", name_resolver_->GetImmutableClassName(descriptor_));
+}
+
+void ImmutableMessageGenerator::GenerateFieldByNumberMethods(
+    io::Printer* printer) {
+  std::unique_ptr<const FieldDescriptor*[]> sorted_fields(
+      SortFieldsByNumber(descriptor_));
+
+  printer->Print(
+      "@java.lang.Override\n"
+      "public java.lang.Object getFieldByNumber(int number) {\n"
+      "  switch (number) {\n");
+  printer->Indent();
+  printer->Indent();
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = sorted_fields[i];
+    printer->Print(
+        "case $number$: return get$capitalized_name$$suffix$();\n", "number",
+        StrCat(field->number()), "capitalized_name",
+        context_->GetFieldGeneratorInfo(field)->capitalized_name, "suffix",
+        IsMapField(field) ? "Map" : field->is_repeated() ? "List" : "");
+  }
+  printer->Print("default: return super.getFieldByNumber(number);\n");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "  }\n"
+      "}\n"
+      "\n"
+      "@java.lang.Override\n"
+      "@SuppressWarnings(\"unchecked\")\n"
+      "public void setFieldByNumber(int number, java.lang.Object value) {\n");
+  printer->Indent();
+  if (descriptor_->field_count() == 0) {
+    printer->Print("super.setFieldByNumber(number, value);\n");
+    printer->Outdent();
+    printer->Print(
+        "}\n"
+        "\n");
+    return;
+  }
+  // unknown numbers and values of the wrong type are rejected before the
+  // snapshot and the seqlock are touched
+  printer->Print("switch (number) {\n");
+  printer->Indent();
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = sorted_fields[i];
+    printer->Print("case $number$:\n", "number", StrCat(field->number()));
+    printer->Indent();
+    field_generators_.get(field).GenerateCheckByNumberCode(printer);
+    printer->Print("break;\n");
+    printer->Outdent();
+  }
+  printer->Print(
+      "default:\n"
+      "  super.setFieldByNumber(number, value);\n"
+      "  return;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "beforeMessageUpdate();\n");
+  PrintBeginWrite(printer, descriptor_);
+  printer->Print("switch (number) {\n");
+  printer->Indent();
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = sorted_fields[i];
+    printer->Print("case $number$:\n", "number", StrCat(field->number()));
+    printer->Indent();
+    field_generators_.get(field).GenerateSetByNumberCode(printer);
+    printer->Print("break;\n");
+    printer->Outdent();
+  }
+  printer->Outdent();
+  printer->Print("}\n");
+  if (GetFieldMemorySemantics(descriptor_) == FIELD_MEMORY_RELEASE_ACQUIRE) {
+    printer->Print("java.lang.invoke.VarHandle.releaseFence();\n");
+  }
+  PrintEndWrite(printer, descriptor_);
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+
+  // unboxed variants for the singular primitive fields, they go through the
+  // regular setters
+  const JavaType kPrimitiveTypes[] = {JAVATYPE_INT, JAVATYPE_LONG,
+                                      JAVATYPE_FLOAT, JAVATYPE_DOUBLE,
+                                      JAVATYPE_BOOLEAN};
+  for (JavaType type : kPrimitiveTypes) {
+    std::vector<const FieldDescriptor*> fields;
+    for (int i = 0; i < descriptor_->field_count(); i++) {
+      const FieldDescriptor* field = sorted_fields[i];
+      if (!field->is_repeated() && GetJavaType(field) == type) {
+        fields.push_back(field);
+      }
+    }
+    if (fields.empty()) {
+      continue;
+    }
+    std::map<std::string, std::string> vars;
+    vars["type"] = PrimitiveTypeName(type);
+    vars["capitalized_type"] = UnderscoresToCamelCase(vars["type"], true);
+    printer->Print(vars,
+                   "@java.lang.Override\n"
+                   "public $type$ get$capitalized_type$FieldByNumber(int number) {\n"
+                   "  switch (number) {\n");
+    for (const FieldDescriptor* field : fields) {
+      printer->Print("    case $number$: return get$capitalized_name$();\n",
+                     "number", StrCat(field->number()), "capitalized_name",
+                     context_->GetFieldGeneratorInfo(field)->capitalized_name);
+    }
+    printer->Print(vars,
+                   "    default: return super.get$capitalized_type$FieldByNumber(number);\n"
+                   "  }\n"
+                   "}\n"
+                   "\n"
+                   "@java.lang.Override\n"
+                   "public void set$capitalized_type$FieldByNumber(int number, $type$ value) {\n"
+                   "  switch (number) {\n");
+    for (const FieldDescriptor* field : fields) {
+      printer->Print(
+          "    case $number$:\n"
+          "      set$capitalized_name$(value);\n"
+          "      break;\n",
+          "number", StrCat(field->number()), "capitalized_name",
+          context_->GetFieldGeneratorInfo(field)->capitalized_name);
+    }
+    printer->Print(vars,
+                   "    default:\n"
+                   "      super.set$capitalized_type$FieldByNumber(number, value);\n"
+                   "  }\n"
+                   "}\n"
+                   "\n");
+  }
+}
+
 void ImmutableMessageGenerator::GenerateToStringMethod(io::Printer* printer) {
   printer->Print(
       "@java.lang.Override\n"
@@ -1454,6 +2437,304 @@ void ImmutableMessageGenerator::GenerateToStringMethod(io::Printer* printer) {
       "\n");
 }
 
+void ImmutableMessageGenerator::GenerateJsonMethods(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Writes this message as proto3 JSON without reflection. Fields are\n"
+      " * written by the same presence rules as the binary format.\n"
+      " */\n"
+      "public void writeJson(java.lang.Appendable out) throws java.io.IOException {\n");
+  printer->Indent();
+
+  const std::string& full_name = descriptor_->full_name();
+  const std::string writer = "de.leohilbert.proto.JsonWriter.";
+  if (full_name == "google.protobuf.Timestamp") {
+    printer->Print("$writer$writeTimestamp(out, seconds_, nanos_);\n",
+                   "writer", writer);
+  } else if (full_name == "google.protobuf.Duration") {
+    printer->Print("$writer$writeDuration(out, seconds_, nanos_);\n",
+                   "writer", writer);
+  } else if (full_name == "google.protobuf.FieldMask") {
+    printer->Print("$writer$writeFieldMask(out, paths_);\n", "writer", writer);
+  } else if (IsWrappersProtoFile(descriptor_->file())) {
+    printer->Print(JsonValueWriter(descriptor_->field(0), "value_",
+                                   name_resolver_).c_str());
+  } else if (full_name == "google.protobuf.Struct") {
+    printer->Print(
+        "out.append('{');\n"
+        "boolean first = true;\n"
+        "for (java.util.Map.Entry<java.lang.String, $value$> entry\n"
+        "     : internalGetFields().getMap().entrySet()) {\n"
+        "  first = $writer$name(out, first, entry.getKey());\n"
+        "  entry.getValue().writeJson(out);\n"
+        "}\n"
+        "out.append('}');\n",
+        "writer", writer, "value",
+        name_resolver_->GetImmutableClassName(
+            descriptor_->field(0)->message_type()->field(1)->message_type()));
+  } else if (full_name == "google.protobuf.ListValue") {
+    printer->Print(
+        "out.append('[');\n"
+        "for (int i = 0; i < values_.size(); i++) {\n"
+        "  if (i > 0) {\n"
+        "    out.append(',');\n"
+        "  }\n"
+        "  values_.get(i).writeJson(out);\n"
+        "}\n"
+        "out.append(']');\n");
+  } else if (full_name == "google.protobuf.Value") {
+    // a Value is written as the bare JSON value held by its "kind" oneof
+    printer->Print("switch (kindCase_) {\n");
+    printer->Indent();
+    for (int i = 0; i < descriptor_->field_count(); i++) {
+      const FieldDescriptor* field = descriptor_->field(i);
+      std::string type;
+      switch (GetJavaType(field)) {
+        case JAVATYPE_MESSAGE:
+          type = name_resolver_->GetImmutableClassName(field->message_type());
+          break;
+        case JAVATYPE_ENUM:
+          type = "java.lang.Integer";
+          break;
+        default:
+          type = BoxedPrimitiveTypeName(GetJavaType(field));
+      }
+      printer->Print("case $number$:\n", "number", StrCat(field->number()));
+      printer->Indent();
+      printer->Print(
+          JsonValueWriter(field, "((" + type + ") kind_)", name_resolver_)
+              .c_str());
+      printer->Print("break;\n");
+      printer->Outdent();
+    }
+    printer->Print(
+        "default:\n"
+        "  out.append(\"null\");\n");
+    printer->Outdent();
+    printer->Print("}\n");
+  } else if (full_name == "google.protobuf.Any") {
+    // without a type registry the packed message can't be expanded, so its
+    // bytes are written next to the type url
+    printer->Print(
+        "out.append('{');\n"
+        "$writer$name(out, true, \"@type\");\n"
+        "$writer$writeString(out, typeUrl_);\n"
+        "$writer$name(out, false, \"value\");\n"
+        "$writer$writeBytes(out, value_);\n"
+        "out.append('}');\n",
+        "writer", writer);
+  } else {
+    printer->Print(
+        "out.append('{');\n"
+        "boolean first = true;\n");
+    for (int i = 0; i < descriptor_->field_count(); i++) {
+      field_generators_.get(descriptor_->field(i)).GenerateJsonCode(printer);
+    }
+    printer->Print("out.append('}');\n");
+  }
+
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n"
+      "public java.lang.String toJson() {\n"
+      "  java.lang.StringBuilder sb = new java.lang.StringBuilder();\n"
+      "  try {\n"
+      "    writeJson(sb);\n"
+      "  } catch (java.io.IOException e) {\n"
+      "    throw new java.lang.RuntimeException(\n"
+      "        \"Writing to a StringBuilder threw an IOException (should never happen).\", e);\n"
+      "  }\n"
+      "  return sb.toString();\n"
+      "}\n"
+      "\n");
+}
+
+void ImmutableMessageGenerator::GenerateJsonParsingMethods(
+    io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Reads proto3 JSON into this message. Like updateFrom, all fields not\n"
+      " * contained in the JSON are reset to their defaults.\n"
+      " */\n"
+      "public void updateFromJson(java.io.Reader reader) throws java.io.IOException {\n"
+      "  updateFromJson(new de.leohilbert.proto.JsonReader(reader));\n"
+      "}\n"
+      "\n"
+      "public void updateFromJson(de.leohilbert.proto.JsonReader in) throws java.io.IOException {\n"
+      "  beforeMessageUpdate();\n");
+  printer->Indent();
+  PrintBeginWrite(printer, descriptor_);
+  printer->Print("clear();\n");
+
+  const std::string& full_name = descriptor_->full_name();
+  if (full_name == "google.protobuf.Timestamp") {
+    printer->Print(
+        "seconds_ = in.readTimestamp();\n"
+        "nanos_ = in.lastNanos();\n");
+  } else if (full_name == "google.protobuf.Duration") {
+    printer->Print(
+        "seconds_ = in.readDuration();\n"
+        "nanos_ = in.lastNanos();\n");
+  } else if (full_name == "google.protobuf.FieldMask") {
+    printer->Print("paths_ = in.readFieldMask();\n");
+  } else if (IsWrappersProtoFile(descriptor_->file())) {
+    printer->Print(
+        ("value_ = " + JsonValueReader(descriptor_->field(0), name_resolver_) +
+         ";\n")
+            .c_str());
+  } else if (full_name == "google.protobuf.Value") {
+    // the kind is decided by the next JSON token
+    printer->Print("switch (in.peek()) {\n");
+    printer->Indent();
+    for (int i = 0; i < descriptor_->field_count(); i++) {
+      const FieldDescriptor* field = descriptor_->field(i);
+      std::map<std::string, std::string> vars;
+      vars["number"] = StrCat(field->number());
+      switch (GetJavaType(field)) {
+        case JAVATYPE_ENUM:
+          printer->Print(vars,
+                         "case 'n':\n"
+                         "  in.nextNull();\n"
+                         "  kind_ = 0;\n");
+          break;
+        case JAVATYPE_DOUBLE:
+          printer->Print(vars,
+                         "default:\n"
+                         "  kind_ = in.readDouble();\n");
+          break;
+        case JAVATYPE_STRING:
+          printer->Print(vars,
+                         "case '\"':\n"
+                         "  kind_ = in.readString();\n");
+          break;
+        case JAVATYPE_BOOLEAN:
+          printer->Print(vars,
+                         "case 't':\n"
+                         "case 'f':\n"
+                         "  kind_ = in.readBool();\n");
+          break;
+        default:
+          vars["type"] =
+              name_resolver_->GetImmutableClassName(field->message_type());
+          vars["open"] =
+              field->message_type()->name() == "Struct" ? "{" : "[";
+          printer->Print(vars,
+                         "case '$open$': {\n"
+                         "  $type$ message = new $type$();\n"
+                         "  message.updateFromJson(in);\n"
+                         "  kind_ = message;\n"
+                         "  kindCase_ = $number$;\n"
+                         "  break;\n"
+                         "}\n");
+          continue;
+      }
+      printer->Print(vars,
+                     "  kindCase_ = $number$;\n"
+                     "  break;\n");
+    }
+    printer->Outdent();
+    printer->Print("}\n");
+  } else if (full_name == "google.protobuf.Struct") {
+    printer->Print(
+        "in.beginObject();\n"
+        "while (in.hasNextMember()) {\n"
+        "  java.lang.String key = in.nextName();\n"
+        "  $value$ value = new $value$();\n"
+        "  value.updateFromJson(in);\n"
+        "  internalGetMutableFields().getMutableMap().put(key, value);\n"
+        "}\n",
+        "value",
+        name_resolver_->GetImmutableClassName(
+            descriptor_->field(0)->message_type()->field(1)->message_type()));
+  } else if (full_name == "google.protobuf.ListValue") {
+    printer->Print(
+        "in.beginArray();\n"
+        "values_ = new java.util.ArrayList<$value$>();\n"
+        "while (in.hasNextElement()) {\n"
+        "  $value$ value = new $value$();\n"
+        "  value.updateFromJson(in);\n"
+        "  values_.add(value);\n"
+        "}\n",
+        "value",
+        name_resolver_->GetImmutableClassName(
+            descriptor_->field(0)->message_type()));
+  } else if (full_name == "google.protobuf.Any") {
+    // the counterpart of the {"@type", "value"} object written by writeJson
+    printer->Print(
+        "in.beginObject();\n"
+        "while (in.hasNextMember()) {\n"
+        "  switch (in.nextName()) {\n"
+        "    case \"@type\":\n"
+        "      typeUrl_ = in.readString();\n"
+        "      break;\n"
+        "    case \"value\":\n"
+        "      value_ = in.readBytes();\n"
+        "      break;\n"
+        "    default:\n"
+        "      in.skipValue();\n"
+        "  }\n"
+        "}\n");
+  } else {
+    printer->Print(
+        "in.beginObject();\n"
+        "while (in.hasNextMember()) {\n"
+        "  switch (in.nextName()) {\n");
+    printer->Indent();
+    printer->Indent();
+    for (int i = 0; i < descriptor_->field_count(); i++) {
+      const FieldDescriptor* field = descriptor_->field(i);
+      // parsers have to accept the json_name and the original field name
+      printer->Print("case \"$name$\":\n", "name", CEscape(field->json_name()));
+      if (field->json_name() != field->name()) {
+        printer->Print("case \"$name$\":\n", "name", field->name());
+      }
+      printer->Indent();
+      if (GetJavaType(field) == JAVATYPE_MESSAGE && !field->is_repeated() &&
+          field->message_type()->full_name() == "google.protobuf.Value") {
+        // for a Value null is a value of its own
+        printer->Print("{\n");
+        printer->Indent();
+        field_generators_.get(field).GenerateJsonParsingCode(printer);
+        printer->Print("break;\n");
+        printer->Outdent();
+        printer->Print("}\n");
+      } else {
+        // null stands for the default value
+        printer->Print("if (!in.nextNull()) {\n");
+        printer->Indent();
+        field_generators_.get(field).GenerateJsonParsingCode(printer);
+        printer->Outdent();
+        printer->Print(
+            "}\n"
+            "break;\n");
+      }
+      printer->Outdent();
+    }
+    printer->Print(
+        "default:\n"
+        "  in.skipValue();\n");
+    printer->Outdent();
+    printer->Outdent();
+    printer->Print(
+        "  }\n"
+        "}\n");
+  }
+
+  if (GetFieldMemorySemantics(descriptor_) == FIELD_MEMORY_RELEASE_ACQUIRE) {
+    printer->Print("java.lang.invoke.VarHandle.releaseFence();\n");
+  }
+  // like copyFrom, the whole message was replaced
+  printer->Print(
+      "onChanged(0);\n"
+      "afterMessageUpdate();\n");
+  PrintEndWrite(printer, descriptor_);
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
 }  // namespace java
 }  // namespace compiler
 }  // namespace protobuf
@@ -113,6 +113,10 @@ class ImmutableMessageGenerator : public MessageGenerator {
 
   // Returns an estimate of the number of bytes the printed code will compile to
   int GenerateFieldAccessorTableInitializer(io::Printer* printer);
+  // Prints the quoted accessor names passed to the FieldAccessorTable.
+  int GenerateFieldAccessorNames(io::Printer* printer);
+  // Used by the lazy_descriptors option instead of the outer class statics.
+  void GenerateDescriptorHolder(io::Printer* printer);
 
   void GenerateMessageSerializationMethods(io::Printer* printer);
   void GenerateParseFromMethods(io::Printer* printer);
@@ -125,9 +129,17 @@ class ImmutableMessageGenerator : public MessageGenerator {
   void GenerateDescriptorMethods(io::Printer* printer);
   void GenerateInitializers(io::Printer* printer);
   void GenerateEqualsAndHashCode(io::Printer* printer);
+  void GenerateDiffMethods(io::Printer* printer);
   void GenerateParser(io::Printer* printer);
   void GenerateParsingConstructor(io::Printer* printer);
-  void GenerateUpdateFromMethod(io::Printer* printer);
+  // Generates updateFrom(input, extensionRegistry), or with masked
+  // updateFrom(input, mask) of the field_masks option.
+  void GenerateUpdateFromMethod(io::Printer* printer, bool masked);
+  void GenerateFieldMaskMethods(io::Printer* printer);
+  void GenerateMaskedSerializationMethods(io::Printer* printer);
+  // The serialization (write) or size code of a field guarded by the mask.
+  void PrintMaskedFieldCode(io::Printer* printer, const FieldDescriptor* field,
+                            bool write);
   void GenerateAnyMethods(io::Printer* printer);
 
   Context* context_;
@@ -136,7 +148,13 @@ class ImmutableMessageGenerator : public MessageGenerator {
 
   GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutableMessageGenerator);
   void GenerateClearMethod(io::Printer* printer);
+  void GenerateCopyFromMethod(io::Printer* printer);
+  void GenerateFreezeMethods(io::Printer* printer);
+  void GenerateSeqLockMethods(io::Printer* printer);
+  void GenerateFieldByNumberMethods(io::Printer* printer);
   void GenerateToStringMethod(io::Printer* printer);
+  void GenerateJsonMethods(io::Printer* printer);
+  void GenerateJsonParsingMethods(io::Printer* printer);
 };
 
 }  // namespace java
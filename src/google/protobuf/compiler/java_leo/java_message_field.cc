@@ -114,6 +114,30 @@ void SetMessageVariables(const FieldDescriptor* descriptor, int messageBitIndex,
       GenerateSetBitToLocal(messageBitIndex);
 }
 
+// Writes the message "value" with the FieldMask "nested", the length prefix is
+// its size under the same mask.
+void PrintMaskedMessageWrite(io::Printer* printer,
+                             std::map<std::string, std::string> variables,
+                             const std::string& value) {
+  variables["value"] = value;
+  printer->Print(variables,
+                 "output.writeTag($number$,\n"
+                 "    com.google.protobuf.WireFormat.WIRETYPE_LENGTH_DELIMITED);\n"
+                 "output.writeUInt32NoTag($value$.getSerializedSize(nested));\n"
+                 "$value$.writeTo(output, nested);\n");
+}
+
+void PrintMaskedMessageSize(io::Printer* printer,
+                            std::map<std::string, std::string> variables,
+                            const std::string& value) {
+  variables["value"] = value;
+  printer->Print(variables,
+                 "int length = $value$.getSerializedSize(nested);\n"
+                 "size += com.google.protobuf.CodedOutputStream.computeTagSize($number$)\n"
+                 "    + com.google.protobuf.CodedOutputStream.computeUInt32SizeNoTag(length)\n"
+                 "    + length;\n");
+}
+
 }  // namespace
 
 // ===================================================================
@@ -125,6 +149,7 @@ ImmutableMessageFieldGenerator::ImmutableMessageFieldGenerator(
   SetMessageVariables(descriptor, messageBitIndex, builderBitIndex,
                       context->GetFieldGeneratorInfo(descriptor),
                       name_resolver_, &variables_);
+  SetFieldMemoryVariables(descriptor, variables_["type"], false, &variables_);
 }
 
 ImmutableMessageFieldGenerator::~ImmutableMessageFieldGenerator() {}
@@ -155,7 +180,7 @@ void ImmutableMessageFieldGenerator::GenerateInterfaceMembers(
 
 void ImmutableMessageFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
-  printer->Print(variables_, "private $type$ $name$_;\n");
+  PrintFieldDeclaration(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
 
   if (HasHasbit(descriptor_)) {
@@ -172,7 +197,7 @@ void ImmutableMessageFieldGenerator::GenerateMembers(
         variables_,
         "@java.lang.Override\n"
         "$deprecation$public $type$ ${$get$capitalized_name$$}$() {\n"
-        "  return $name$_;\n"
+        "  return $read_field$;\n"
         "}\n");
     printer->Annotate("{", "}", descriptor_);
 
@@ -182,7 +207,7 @@ void ImmutableMessageFieldGenerator::GenerateMembers(
         //"@java.lang.Override\n"
         "$deprecation$public $type$Interface "
         "${$get$capitalized_name$Interface$}$() {\n"
-        "  return $name$_;\n"
+        "  return $read_field$;\n"
         "}\n");
     printer->Annotate("{", "}", descriptor_);
   } else {
@@ -191,7 +216,7 @@ void ImmutableMessageFieldGenerator::GenerateMembers(
         variables_,
         "@java.lang.Override\n"
         "$deprecation$public boolean ${$has$capitalized_name$$}$() {\n"
-        "  return $name$_ != null;\n"
+        "  return $read_field$ != null;\n"
         "}\n");
     printer->Annotate("{", "}", descriptor_);
     WriteFieldAccessorDocComment(printer, descriptor_, GETTER);
@@ -199,7 +224,7 @@ void ImmutableMessageFieldGenerator::GenerateMembers(
         variables_,
         "@java.lang.Override\n"
         "$deprecation$public $type$ ${$get$capitalized_name$$}$() {\n"
-        "  return $name$_;\n"
+        "  return $read_field$;\n"
         "}\n");
     printer->Annotate("{", "}", descriptor_);
 
@@ -209,22 +234,28 @@ void ImmutableMessageFieldGenerator::GenerateMembers(
   WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
   printer->Print(variables_,
                  "$deprecation$public $classname$ "
-                 "${$set$capitalized_name$$}$($type$ value) {\n"
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  if (!java.util.Objects.equals(value, $name$_)) {\n"
-                 "    $name$_ = value;\n"
+                 "    $store_prefix$value$store_suffix$;\n"
                  "    $on_changed$\n"
-                 "  }\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 
   // Field.Builder clearField()
   WriteFieldDocComment(printer, descriptor_);
-  printer->Print(variables_, "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
-      "  $name$_ = null;\n"
-      "  $on_changed$\n"
-      "  return this;\n"
-      "}\n");
+  printer->Print(variables_,
+                 "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  $store_prefix$null$store_suffix$;\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableMessageFieldGenerator::PrintNestedBuilderCondition(
@@ -277,6 +308,53 @@ void ImmutableMessageFieldGenerator::GenerateMergingCode(
                  "}\n");
 }
 
+void ImmutableMessageFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$store_prefix$other.$name$_ == null ? null : "
+                 "other.$name$_.deepCopy()$store_suffix$;\n");
+}
+
+void ImmutableMessageFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "get$capitalized_name$()", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableMessageFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$type$ message = new $type$();\n"
+                 "message.updateFromJson(in);\n"
+                 "$set_has_field_bit_message$\n"
+                 "$store_prefix$message$store_suffix$;\n");
+}
+
+void ImmutableMessageFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckByNumber(descriptor_, variables_.at("type"), true, printer);
+}
+
+void ImmutableMessageFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  // the setter stores with the field memory semantics and notifies
+  printer->Print(variables_, "set$capitalized_name$(($type$) value);\n");
+}
+
+void ImmutableMessageFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableMessageFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (GetType(descriptor_) == FieldDescriptor::TYPE_GROUP) {
@@ -290,6 +368,17 @@ void ImmutableMessageFieldGenerator::GenerateParsingCode(
   }
 }
 
+void ImmutableMessageFieldGenerator::GenerateMaskedParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$type$ value = new $type$();\n"
+                 "int oldLimit = input.pushLimit(input.readRawVarint32());\n"
+                 "value.updateFrom(input, nested);\n"
+                 "input.checkLastTagWas(0);\n"
+                 "input.popLimit(oldLimit);\n"
+                 "$name$_ = value;\n");
+}
+
 void ImmutableMessageFieldGenerator::GenerateParsingDoneCode(
     io::Printer* printer) const {
   // noop for messages.
@@ -314,6 +403,26 @@ void ImmutableMessageFieldGenerator::GenerateSerializedSizeCode(
       "}\n");
 }
 
+void ImmutableMessageFieldGenerator::GenerateMaskedSerializationCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "if ($is_field_present_message$) {\n");
+  printer->Indent();
+  PrintMaskedMessageWrite(printer, variables_,
+                          "get" + variables_.at("capitalized_name") + "()");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableMessageFieldGenerator::GenerateMaskedSerializedSizeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "if ($is_field_present_message$) {\n");
+  printer->Indent();
+  PrintMaskedMessageSize(printer, variables_,
+                         "get" + variables_.at("capitalized_name") + "()");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
 void ImmutableMessageFieldGenerator::GenerateEqualsCode(
     io::Printer* printer) const {
   printer->Print(variables_,
@@ -370,11 +479,14 @@ void ImmutableMessageOneofFieldGenerator::GenerateMembers(
   // Field.Builder setField(Field value)
   WriteFieldDocComment(printer, descriptor_);
   printer->Print(variables_,
-      "$deprecation$public $classname$ ${$set$capitalized_name$$}$($type$ value) {\n"
-      "$oneof_name$_ = value;\n"
-      "$on_changed$\n"
-      "return this;\n"
-      "}\n");
+      "$deprecation$public $classname$ ${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+      "  $oneof_name$_ = value;\n"
+      "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableMessageOneofFieldGenerator::GenerateMergingCode(
@@ -383,6 +495,49 @@ void ImmutableMessageOneofFieldGenerator::GenerateMergingCode(
                  "merge$capitalized_name$(other.get$capitalized_name$());\n");
 }
 
+void ImmutableMessageOneofFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$oneof_name$_ = (($type$) other.$oneof_name$_).deepCopy();\n");
+}
+
+void ImmutableMessageOneofFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($has_oneof_case_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "(($type$) $oneof_name$_)", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableMessageOneofFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$type$ message = new $type$();\n"
+                 "message.updateFromJson(in);\n"
+                 "$oneof_name$_ = message;\n"
+                 "$set_oneof_case_message$;\n");
+}
+
+void ImmutableMessageOneofFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$oneof_name$_ = ($type$) value;\n"
+                 "$set_oneof_case_message$;\n"
+                 "$on_changed$\n");
+}
+
+void ImmutableMessageOneofFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($oneof_name$_, other.$oneof_name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableMessageOneofFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (GetType(descriptor_) == FieldDescriptor::TYPE_GROUP) {
@@ -399,6 +554,18 @@ void ImmutableMessageOneofFieldGenerator::GenerateParsingCode(
   printer->Print(variables_, "$set_oneof_case_message$;\n");
 }
 
+void ImmutableMessageOneofFieldGenerator::GenerateMaskedParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$type$ value = new $type$();\n"
+                 "int oldLimit = input.pushLimit(input.readRawVarint32());\n"
+                 "value.updateFrom(input, nested);\n"
+                 "input.checkLastTagWas(0);\n"
+                 "input.popLimit(oldLimit);\n"
+                 "$oneof_name$_ = value;\n"
+                 "$set_oneof_case_message$;\n");
+}
+
 void ImmutableMessageOneofFieldGenerator::GenerateSerializationCode(
     io::Printer* printer) const {
   printer->Print(
@@ -418,6 +585,28 @@ void ImmutableMessageOneofFieldGenerator::GenerateSerializedSizeCode(
       "}\n");
 }
 
+void ImmutableMessageOneofFieldGenerator::GenerateMaskedSerializationCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "if ($has_oneof_case_message$) {\n");
+  printer->Indent();
+  PrintMaskedMessageWrite(
+      printer, variables_,
+      "((" + variables_.at("type") + ") " + variables_.at("oneof_name") + "_)");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableMessageOneofFieldGenerator::GenerateMaskedSerializedSizeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "if ($has_oneof_case_message$) {\n");
+  printer->Indent();
+  PrintMaskedMessageSize(
+      printer, variables_,
+      "((" + variables_.at("type") + ") " + variables_.at("oneof_name") + "_)");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
 // ===================================================================
 
 RepeatedImmutableMessageFieldGenerator::RepeatedImmutableMessageFieldGenerator(
@@ -427,6 +616,9 @@ RepeatedImmutableMessageFieldGenerator::RepeatedImmutableMessageFieldGenerator(
   SetMessageVariables(descriptor, messageBitIndex, builderBitIndex,
                       context->GetFieldGeneratorInfo(descriptor),
                       name_resolver_, &variables_);
+  variables_["empty_list"] = "java.util.Collections.emptyList()";
+  variables_["shared_empty_list"] = "java.util.Collections.EMPTY_LIST";
+  variables_["create_list"] = "new java.util.ArrayList<" + variables_["type"] + ">()";
 }
 
 RepeatedImmutableMessageFieldGenerator::
@@ -437,7 +629,7 @@ int RepeatedImmutableMessageFieldGenerator::GetNumBitsForMessage() const {
 }
 
 int RepeatedImmutableMessageFieldGenerator::GetNumBitsForBuilder() const {
-  return 1;
+  return 0;
 }
 
 void RepeatedImmutableMessageFieldGenerator::GenerateInterfaceMembers(
@@ -473,24 +665,25 @@ void RepeatedImmutableMessageFieldGenerator::GenerateInterfaceMembers(
 void RepeatedImmutableMessageFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
   printer->Print(variables_, "private java.util.List<$type$> $name$_;\n");
+  PrintEnsureRepeatedFieldMutable(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
   WriteFieldDocComment(printer, descriptor_);
   printer->Print(variables_,
                  "@java.lang.Override\n"
                  "$deprecation$public java.util.List<$type$> "
-                 "${$get$capitalized_name$List$}$() {\n"
-                 "  return $name$_;\n"  // note:  unmodifiable list
-                 "}\n");
+                 "${$get$capitalized_name$List$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintReturnUnmodifiableList(variables_, printer);
+  printer->Print("}\n");
   WriteFieldDocComment(printer, descriptor_);
   printer->Print(
       variables_,
       //"@java.lang.Override\n"
       "$deprecation$public java.util.List<? extends $type$Interface> \n"
-      "    ${$get$capitalized_name$InterfaceList$}$() {\n"
-      "  return $name$_;\n"
-      "}\n");
+      "    ${$get$capitalized_name$InterfaceList$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintReturnUnmodifiableList(variables_, printer);
+  printer->Print("}\n");
   WriteFieldDocComment(printer, descriptor_);
   printer->Print(
       variables_,
@@ -513,39 +706,51 @@ void RepeatedImmutableMessageFieldGenerator::GenerateMembers(
   printer->Print(variables_,
                  "@java.lang.Override\n"
                  "$deprecation$public $classname$ ${$set$capitalized_name$$}$(\n"
-                 "    int index, $type$ value) {\n"
-                 "  $name$_.set(index, value);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    int index, $type$ value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.set(index, value);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_ADDER, true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$add$capitalized_name$$}$(\n"
-                 "    $type$ value) {\n"
-                 "  $name$_.add(value);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    $type$ value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.add(value);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_MULTI_ADDER, true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$addAll$capitalized_name$$}$(\n"
-                 "    java.util.Collection<$type$> values) {\n"
-                 "  $name$_.addAll(values);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    java.util.Collection<$type$> values) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.addAll(values);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER, true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
-      "  $name$_ = new java.util.ArrayList<$type$>($name$_);\n"
-      "  $on_changed$\n"
-      "  return this;\n"
-      "}\n");
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Indent();
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Outdent();
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void RepeatedImmutableMessageFieldGenerator::PrintNestedBuilderCondition(
@@ -580,13 +785,12 @@ void RepeatedImmutableMessageFieldGenerator::PrintNestedBuilderFunction(
 
 void RepeatedImmutableMessageFieldGenerator::GenerateInitializationCode(
     io::Printer* printer) const {
-  printer->Print(variables_, "$name$_ = new java.util.ArrayList<$type$>();\n");
+  printer->Print(variables_, "$name$_ = $empty_list$;\n");
 }
 
 void RepeatedImmutableMessageFieldGenerator::GenerateClearCode(
     io::Printer* printer) const {
-  printer->Print(variables_,
-                              "$name$_ = java.util.Collections.emptyList();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
 }
 
 void RepeatedImmutableMessageFieldGenerator::GenerateToStringCode(io::Printer* printer) const {
@@ -629,14 +833,80 @@ void RepeatedImmutableMessageFieldGenerator::GenerateMergingCode(
       "}\n");
 }
 
-void RepeatedImmutableMessageFieldGenerator::GenerateParsingCode(
+void RepeatedImmutableMessageFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  // the list is sized to the source, since the elements are added one by one
+  printer->Print(variables_,
+                 "if (!other.$name$_.isEmpty()) {\n"
+                 "  if ($name$_ == $shared_empty_list$) {\n"
+                 "    $name$_ = new java.util.ArrayList<$type$>(other.$name$_.size());\n"
+                 "  }\n"
+                 "  for (int i = 0; i < other.$name$_.size(); i++) {\n"
+                 "    $name$_.add(other.$name$_.get(i).deepCopy());\n"
+                 "  }\n"
+                 "}\n");
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!$name$_.isEmpty()) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n"
+                 "  out.append('[');\n"
+                 "  for (int i = 0; i < $name$_.size(); i++) {\n"
+                 "    if (i > 0) {\n"
+                 "      out.append(',');\n"
+                 "    }\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$name$_.get(i)", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print("  }\n"
+                 "  out.append(']');\n"
+                 "}\n");
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print("in.beginArray();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "while (in.hasNextElement()) {\n"
+                 "  $type$ message = new $type$();\n"
+                 "  message.updateFromJson(in);\n"
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.add(message);\n"
+                 "}\n");
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckListByNumber(descriptor_, variables_.at("type"), printer);
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "ensure$capitalized_name$IsMutable();\n"
+                 "$name$_.addAll((java.util.Collection<$type$>) value);\n"
+                 "$on_changed$\n");
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateDiffCode(
     io::Printer* printer) const {
   printer->Print(variables_,
-                 "if (!$get_mutable_bit_parser$) {\n"
-                 "  $name$_ = new java.util.ArrayList<$type$>();\n"
-                 "  $set_mutable_bit_parser$;\n"
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
                  "}\n");
+}
 
+void RepeatedImmutableMessageFieldGenerator::GenerateParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "ensure$capitalized_name$IsMutable();\n");
   if (GetType(descriptor_) == FieldDescriptor::TYPE_GROUP) {
     printer->Print(
         variables_,
@@ -650,6 +920,18 @@ void RepeatedImmutableMessageFieldGenerator::GenerateParsingCode(
   }
 }
 
+void RepeatedImmutableMessageFieldGenerator::GenerateMaskedParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$type$ value = new $type$();\n"
+                 "int oldLimit = input.pushLimit(input.readRawVarint32());\n"
+                 "value.updateFrom(input, nested);\n"
+                 "input.checkLastTagWas(0);\n"
+                 "input.popLimit(oldLimit);\n"
+                 "ensure$capitalized_name$IsMutable();\n"
+                 "$name$_.add(value);\n");
+}
+
 void RepeatedImmutableMessageFieldGenerator::GenerateParsingDoneCode(
     io::Printer* printer) const {
 }
@@ -672,12 +954,32 @@ void RepeatedImmutableMessageFieldGenerator::GenerateSerializedSizeCode(
       "}\n");
 }
 
+void RepeatedImmutableMessageFieldGenerator::GenerateMaskedSerializationCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "for (int i = 0; i < $name$_.size(); i++) {\n");
+  printer->Indent();
+  PrintMaskedMessageWrite(printer, variables_,
+                          variables_.at("name") + "_.get(i)");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void RepeatedImmutableMessageFieldGenerator::GenerateMaskedSerializedSizeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "for (int i = 0; i < $name$_.size(); i++) {\n");
+  printer->Indent();
+  PrintMaskedMessageSize(printer, variables_,
+                         variables_.at("name") + "_.get(i)");
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
 void RepeatedImmutableMessageFieldGenerator::GenerateEqualsCode(
     io::Printer* printer) const {
   printer->Print(
       variables_,
-      "if (!java.util.Objects.equals(get$capitalized_name$List(),\n"
-      "    other.get$capitalized_name$List())) return false;\n");
+      "if (!java.util.Objects.equals($name$_,\n"
+      "    other.$name$_)) return false;\n");
 }
 
 void RepeatedImmutableMessageFieldGenerator::GenerateHashCode(
@@ -686,7 +988,7 @@ void RepeatedImmutableMessageFieldGenerator::GenerateHashCode(
       variables_,
       "if (get$capitalized_name$Count() > 0) {\n"
       "  hash = (37 * hash) + $constant_name$;\n"
-      "  hash = (53 * hash) + java.util.Objects.hashCode(get$capitalized_name$List());\n"
+      "  hash = (53 * hash) + java.util.Objects.hashCode($name$_);\n"
       "}\n");
 }
 
@@ -73,10 +73,19 @@ class ImmutableMessageFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateMaskedParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
+  void GenerateMaskedSerializationCode(io::Printer* printer) const;
+  void GenerateMaskedSerializedSizeCode(io::Printer* printer) const;
   void GenerateEqualsCode(io::Printer* printer) const;
   void GenerateHashCode(io::Printer* printer) const;
 
@@ -110,9 +119,17 @@ class ImmutableMessageOneofFieldGenerator
 
   void GenerateMembers(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateMaskedParsingCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
+  void GenerateMaskedSerializationCode(io::Printer* printer) const;
+  void GenerateMaskedSerializedSizeCode(io::Printer* printer) const;
 
  private:
   GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutableMessageOneofFieldGenerator);
@@ -134,10 +151,19 @@ class RepeatedImmutableMessageFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateMaskedParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
+  void GenerateMaskedSerializationCode(io::Printer* printer) const;
+  void GenerateMaskedSerializedSizeCode(io::Printer* printer) const;
   void GenerateEqualsCode(io::Printer* printer) const;
   void GenerateHashCode(io::Printer* printer) const;
 
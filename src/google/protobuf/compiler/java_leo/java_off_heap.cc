@@ -0,0 +1,596 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <google/protobuf/compiler/java_leo/java_off_heap.h>
+
+#include <algorithm>
+#include <memory>
+
+#include <google/protobuf/compiler/java_leo/java_context.h>
+#include <google/protobuf/compiler/java_leo/java_field.h>
+#include <google/protobuf/compiler/java_leo/java_helpers.h>
+#include <google/protobuf/compiler/java_leo/java_name_resolver.h>
+#include <google/protobuf/io/printer.h>
+#include <google/protobuf/wire_format.h>
+#include <google/protobuf/stubs/strutil.h>
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+
+namespace {
+
+bool IsBlob(const FieldDescriptor* field) {
+  return GetJavaType(field) == JAVATYPE_STRING ||
+         GetJavaType(field) == JAVATYPE_BYTES;
+}
+
+// the number of bytes the field takes in a record
+int RecordWidth(const FieldDescriptor* field) {
+  switch (GetJavaType(field)) {
+    case JAVATYPE_LONG:
+    case JAVATYPE_DOUBLE:
+    case JAVATYPE_STRING:
+    case JAVATYPE_BYTES:
+      return 8;
+    case JAVATYPE_BOOLEAN:
+      return 1;
+    default:
+      return 4;
+  }
+}
+
+// the suffix of the OffHeapArena get / put methods for the field
+const char* ArenaType(const FieldDescriptor* field) {
+  switch (GetJavaType(field)) {
+    case JAVATYPE_LONG:
+      return "Long";
+    case JAVATYPE_FLOAT:
+      return "Float";
+    case JAVATYPE_DOUBLE:
+      return "Double";
+    case JAVATYPE_BOOLEAN:
+      return "Boolean";
+    default:
+      return "Int";
+  }
+}
+
+std::string PresenceMask(int bit) {
+  return StrCat("0x", strings::Hex(uint32(1) << (bit % 32), strings::ZERO_PAD_8));
+}
+
+}  // namespace
+
+OffHeapGenerator::OffHeapGenerator(const Descriptor* descriptor,
+                                   Context* context)
+    : descriptor_(descriptor),
+      context_(context),
+      name_resolver_(context->GetNameResolver()),
+      presence_bit_count_(0) {
+  std::unique_ptr<const FieldDescriptor*[]> sorted_fields(
+      SortFieldsByNumber(descriptor_));
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = sorted_fields[i];
+    if (!IsTableColumn(field)) {
+      continue;
+    }
+    fields_.push_back(field);
+    // like in the message, fields without presence are present while they
+    // differ from the default, i.e. strings and bytes while they are not empty
+    presence_bits_[field] =
+        SupportFieldPresence(field) ? presence_bit_count_++ : -1;
+  }
+
+  int offset = (presence_bit_count_ + 31) / 32 * 4;
+  for (int width : {8, 4, 1}) {
+    for (const FieldDescriptor* field : fields_) {
+      if (RecordWidth(field) == width) {
+        offset = (offset + width - 1) / width * width;
+        offsets_[field] = offset;
+        offset += width;
+      }
+    }
+  }
+  record_size_ = std::max(8, (offset + 7) / 8 * 8);
+}
+
+OffHeapGenerator::~OffHeapGenerator() {}
+
+std::map<std::string, std::string> OffHeapGenerator::FieldVariables(
+    const FieldDescriptor* field) const {
+  std::map<std::string, std::string> vars;
+  const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
+  vars["name"] = info->name;
+  vars["capitalized_name"] = info->capitalized_name;
+  vars["number"] = StrCat(field->number());
+  vars["tag"] =
+      StrCat(static_cast<int32>(internal::WireFormat::MakeTag(field)));
+  vars["capitalized_type"] = GetCapitalizedType(field, /* immutable = */ true);
+  vars["arena_type"] = ArenaType(field);
+  int offset = offsets_.at(field);
+  vars["at"] = offset == 0 ? "offset_" : StrCat("offset_ + ", offset);
+  vars["length_at"] = StrCat("offset_ + ", offset + 4);
+
+  JavaType type = GetJavaType(field);
+  switch (type) {
+    case JAVATYPE_ENUM:
+      vars["type"] = name_resolver_->GetImmutableClassName(field->enum_type());
+      vars["default"] = StrCat(field->default_value_enum()->number());
+      break;
+    case JAVATYPE_STRING:
+    case JAVATYPE_BYTES:
+      vars["type"] = BoxedPrimitiveTypeName(type);
+      vars["default"] = ProtoStringDefaultValue(field);
+      break;
+    default:
+      vars["type"] = PrimitiveTypeName(type);
+      vars["default"] = ImmutableDefaultValue(field, name_resolver_);
+      break;
+  }
+  if (type == JAVATYPE_STRING) {
+    vars["read"] = CheckUtf8(field) ? "input.readStringRequireUtf8()"
+                                    : "input.readString()";
+  } else {
+    vars["read"] = "input.read" + vars["capitalized_type"] + "()";
+  }
+
+  int bit = presence_bits_.at(field);
+  if (bit >= 0) {
+    std::string bits = StrCat("offset_ + ", bit / 32 * 4);
+    if (bit < 32) {
+      bits = "offset_";
+    }
+    vars["is_present"] =
+        "(arena_.getInt(" + bits + ") & " + PresenceMask(bit) + ") != 0";
+    vars["set_has"] = "arena_.putInt(" + bits + ", arena_.getInt(" + bits +
+                      ") | " + PresenceMask(bit) + ")";
+    vars["clear_has"] = "arena_.putInt(" + bits + ", arena_.getInt(" + bits +
+                        ") & ~" + PresenceMask(bit) + ")";
+  } else if (IsBlob(field)) {
+    vars["is_present"] = "arena_.getInt(" + vars["length_at"] + ") != 0";
+  } else {
+    vars["is_present"] = "arena_.get" + vars["arena_type"] + "(" +
+                         vars["at"] + ") != " + vars["default"];
+  }
+  return vars;
+}
+
+void OffHeapGenerator::Generate(io::Printer* printer) {
+  std::map<std::string, std::string> vars;
+  vars["classname"] = descriptor_->name();
+  vars["message"] = name_resolver_->GetImmutableClassName(descriptor_);
+  vars["size"] = StrCat(record_size_);
+  // a sibling file holds the record of a top-level message, otherwise it is
+  // nested like the message interface
+  vars["static"] = descriptor_->containing_type() == NULL &&
+                           MultipleJavaFiles(descriptor_->file(), true)
+                       ? ""
+                       : "static ";
+  printer->Print(
+      vars,
+      "/**\n"
+      " * A {@link $message$} stored in a\n"
+      " * {@link de.leohilbert.proto.OffHeapArena}. Instances are handles that\n"
+      " * are moved between records, a record itself is only an offset into\n"
+      " * the arena. Message, repeated, oneof and javatype fields are not\n"
+      " * stored.\n"
+      " */\n"
+      "public $static$final class $classname$OffHeap {\n"
+      "  /**\n"
+      "   * The number of bytes a record takes in the arena.\n"
+      "   */\n"
+      "  public static final int SIZE = $size$;\n"
+      "\n"
+      "  private final de.leohilbert.proto.OffHeapArena arena_;\n"
+      "  private int offset_;\n"
+      "\n"
+      "  public $classname$OffHeap(de.leohilbert.proto.OffHeapArena arena) {\n"
+      "    arena_ = arena;\n"
+      "  }\n"
+      "\n"
+      "  /**\n"
+      "   * Allocates a record with every field at its default and moves this\n"
+      "   * handle onto it.\n"
+      "   */\n"
+      "  public $classname$OffHeap allocate() {\n"
+      "    offset_ = arena_.allocate(SIZE);\n");
+  printer->Indent();
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    if (!IsBlob(field) && !IsDefaultValueJavaDefault(field)) {
+      printer->Print(FieldVariables(field),
+                     "arena_.put$arena_type$($at$, $default$);\n");
+    }
+  }
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      vars,
+      "    return this;\n"
+      "  }\n"
+      "\n"
+      "  /**\n"
+      "   * Moves this handle onto the record at {@code offset}, as returned by\n"
+      "   * {@link #getOffset()}.\n"
+      "   */\n"
+      "  public $classname$OffHeap moveTo(int offset) {\n"
+      "    offset_ = offset;\n"
+      "    return this;\n"
+      "  }\n"
+      "\n"
+      "  public int getOffset() {\n"
+      "    return offset_;\n"
+      "  }\n"
+      "\n"
+      "  public de.leohilbert.proto.OffHeapArena getArena() {\n"
+      "    return arena_;\n"
+      "  }\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    printer->Print("\n");
+    GenerateAccessors(field, printer);
+  }
+  printer->Print("\n");
+  GenerateClear(printer);
+  GenerateCopyFrom(printer);
+  GenerateUpdateFrom(printer);
+  GenerateWriteTo(printer);
+  GenerateSerializedSize(printer);
+  printer->Print(
+      "public byte[] toByteArray() {\n"
+      "  try {\n"
+      "    byte[] result = new byte[getSerializedSize()];\n"
+      "    com.google.protobuf.CodedOutputStream output =\n"
+      "        com.google.protobuf.CodedOutputStream.newInstance(result);\n"
+      "    writeTo(output);\n"
+      "    output.checkNoSpaceLeft();\n"
+      "    return result;\n"
+      "  } catch (java.io.IOException e) {\n"
+      "    throw new java.lang.RuntimeException(\n"
+      "        \"Serializing to a byte array threw an IOException (should \"\n"
+      "            + \"never happen).\", e);\n"
+      "  }\n"
+      "}\n");
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+void OffHeapGenerator::GenerateAccessors(const FieldDescriptor* field,
+                                         io::Printer* printer) {
+  std::map<std::string, std::string> vars = FieldVariables(field);
+  vars["classname"] = descriptor_->name();
+  if (SupportFieldPresence(field)) {
+    printer->Print(vars,
+                   "public boolean has$capitalized_name$() {\n"
+                   "  return $is_present$;\n"
+                   "}\n"
+                   "\n");
+  }
+  switch (GetJavaType(field)) {
+    case JAVATYPE_STRING:
+      printer->Print(
+          vars,
+          "public java.lang.String get$capitalized_name$() {\n"
+          "  return $is_present$\n"
+          "      ? arena_.readString(arena_.getInt($at$), "
+          "arena_.getInt($length_at$))\n"
+          "      : $default$;\n"
+          "}\n"
+          "\n"
+          "public $classname$OffHeap set$capitalized_name$(java.lang.String "
+          "value) {\n"
+          "  if (value == null) {\n"
+          "    return clear$capitalized_name$();\n"
+          "  }\n"
+          "  byte[] bytes = value.getBytes(java.nio.charset.StandardCharsets.UTF_8);\n"
+          "  arena_.putInt($at$, arena_.storeBlob(arena_.getInt($at$), bytes));\n"
+          "  arena_.putInt($length_at$, bytes.length);\n");
+      break;
+    case JAVATYPE_BYTES:
+      printer->Print(
+          vars,
+          "public com.google.protobuf.ByteString get$capitalized_name$() {\n"
+          "  return $is_present$\n"
+          "      ? arena_.readBytes(arena_.getInt($at$), "
+          "arena_.getInt($length_at$))\n"
+          "      : $default$;\n"
+          "}\n"
+          "\n"
+          "public $classname$OffHeap set$capitalized_name$("
+          "com.google.protobuf.ByteString value) {\n"
+          "  if (value == null) {\n"
+          "    return clear$capitalized_name$();\n"
+          "  }\n"
+          "  arena_.putInt($at$, arena_.storeBlob(arena_.getInt($at$), value));\n"
+          "  arena_.putInt($length_at$, value.size());\n");
+      break;
+    case JAVATYPE_ENUM:
+      if (SupportUnknownEnumValue(field->file())) {
+        printer->Print(
+            vars,
+            "public int get$capitalized_name$Value() {\n"
+            "  return arena_.getInt($at$);\n"
+            "}\n"
+            "\n"
+            "public $type$ get$capitalized_name$() {\n"
+            "  $type$ result = $type$.forNumber(arena_.getInt($at$));\n"
+            "  return result == null ? $type$.UNRECOGNIZED : result;\n"
+            "}\n"
+            "\n"
+            "public $classname$OffHeap set$capitalized_name$Value(int value) {\n"
+            "  arena_.putInt($at$, value);\n"
+            "  return this;\n"
+            "}\n"
+            "\n");
+      } else {
+        // closed enum records only ever hold known numbers
+        printer->Print(vars,
+                       "public $type$ get$capitalized_name$() {\n"
+                       "  return $type$.forNumber(arena_.getInt($at$));\n"
+                       "}\n"
+                       "\n");
+      }
+      printer->Print(vars,
+                     "public $classname$OffHeap set$capitalized_name$($type$ "
+                     "value) {\n"
+                     "  arena_.putInt($at$, value.getNumber());\n");
+      break;
+    default:
+      printer->Print(vars,
+                     "public $type$ get$capitalized_name$() {\n"
+                     "  return arena_.get$arena_type$($at$);\n"
+                     "}\n"
+                     "\n"
+                     "public $classname$OffHeap set$capitalized_name$($type$ "
+                     "value) {\n"
+                     "  arena_.put$arena_type$($at$, value);\n");
+      break;
+  }
+  printer->Indent();
+  if (vars.count("set_has")) {
+    printer->Print(vars, "$set_has$;\n");
+  }
+  printer->Outdent();
+  printer->Print(vars,
+                 "  return this;\n"
+                 "}\n"
+                 "\n");
+  if (IsBlob(field)) {
+    printer->Print(vars,
+                   "/**\n"
+                   " * Its blob is kept for the next value.\n"
+                   " */\n"
+                   "public $classname$OffHeap clear$capitalized_name$() {\n"
+                   "  arena_.putInt($length_at$, 0);\n");
+  } else {
+    printer->Print(vars,
+                   "public $classname$OffHeap clear$capitalized_name$() {\n"
+                   "  arena_.put$arena_type$($at$, $default$);\n");
+  }
+  printer->Indent();
+  if (vars.count("clear_has")) {
+    printer->Print(vars, "$clear_has$;\n");
+  }
+  printer->Outdent();
+  printer->Print("  return this;\n"
+                 "}\n");
+}
+
+void OffHeapGenerator::GenerateClear(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Resets every field to its default, the blobs of strings and bytes\n"
+      " * are kept for the next values.\n"
+      " */\n"
+      "public $classname$OffHeap clear() {\n",
+      "classname", descriptor_->name());
+  printer->Indent();
+  for (int i = 0; i < (presence_bit_count_ + 31) / 32; i++) {
+    printer->Print("arena_.putInt($at$, 0);\n", "at",
+                   i == 0 ? "offset_" : StrCat("offset_ + ", i * 4));
+  }
+  for (const FieldDescriptor* field : fields_) {
+    if (IsBlob(field)) {
+      printer->Print(FieldVariables(field), "arena_.putInt($length_at$, 0);\n");
+    } else {
+      printer->Print(FieldVariables(field),
+                     "arena_.put$arena_type$($at$, $default$);\n");
+    }
+  }
+  printer->Outdent();
+  printer->Print(
+      "  return this;\n"
+      "}\n"
+      "\n");
+}
+
+void OffHeapGenerator::GenerateCopyFrom(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Replaces the stored fields with the ones of {@code message}.\n"
+      " */\n"
+      "public void copyFrom($message$ message) {\n"
+      "  clear();\n",
+      "message", name_resolver_->GetImmutableClassName(descriptor_));
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    std::map<std::string, std::string> vars = FieldVariables(field);
+    std::string copy = "set$capitalized_name$(message.get$capitalized_name$());\n";
+    if (GetJavaType(field) == JAVATYPE_ENUM &&
+        SupportUnknownEnumValue(field->file())) {
+      copy =
+          "set$capitalized_name$Value(message.get$capitalized_name$Value());"
+          "\n";
+    }
+    if (SupportFieldPresence(field)) {
+      printer->Print(vars, "if (message.has$capitalized_name$()) {\n");
+      printer->Indent();
+      printer->Print(vars, copy.c_str());
+      printer->Outdent();
+      printer->Print("}\n");
+    } else {
+      printer->Print(vars, copy.c_str());
+    }
+  }
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
+void OffHeapGenerator::GenerateUpdateFrom(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Reads a {@link $message$} in the wire format, like its updateFrom\n"
+      " * all fields that are not in the input are reset to their defaults.\n"
+      " * Fields that are not stored and unknown fields are skipped.\n"
+      " */\n"
+      "public void updateFrom(com.google.protobuf.CodedInputStream input)\n"
+      "    throws java.io.IOException {\n"
+      "  clear();\n"
+      "  while (true) {\n"
+      "    int tag = input.readTag();\n"
+      "    switch (tag) {\n"
+      "      case 0:\n"
+      "        return;\n",
+      "message", name_resolver_->GetImmutableClassName(descriptor_));
+  printer->Indent();
+  printer->Indent();
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    std::map<std::string, std::string> vars = FieldVariables(field);
+    printer->Print(vars, "case $tag$: {\n");
+    printer->Indent();
+    if (GetJavaType(field) == JAVATYPE_ENUM) {
+      if (SupportUnknownEnumValue(field->file())) {
+        printer->Print(vars, "set$capitalized_name$Value(input.readEnum());\n");
+      } else {
+        // closed enums drop numbers they don't know
+        printer->Print(vars,
+                       "$type$ value = $type$.forNumber(input.readEnum());\n"
+                       "if (value != null) {\n"
+                       "  set$capitalized_name$(value);\n"
+                       "}\n");
+      }
+    } else {
+      printer->Print(vars, "set$capitalized_name$($read$);\n");
+    }
+    printer->Print("break;\n");
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+  printer->Print(
+      "default:\n"
+      "  if (!input.skipField(tag)) {\n"
+      "    return;\n"
+      "  }\n"
+      "  break;\n");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "    }\n"
+      "  }\n"
+      "}\n"
+      "\n");
+}
+
+void OffHeapGenerator::GenerateWriteTo(io::Printer* printer) {
+  printer->Print(
+      "public void writeTo(com.google.protobuf.CodedOutputStream output)\n"
+      "    throws java.io.IOException {\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    std::map<std::string, std::string> vars = FieldVariables(field);
+    if (IsBlob(field)) {
+      // the stored bytes are written as they are, strings are not decoded
+      printer->Print(
+          vars,
+          "if ($is_present$) {\n"
+          "  int length = arena_.getInt($length_at$);\n"
+          "  output.writeTag($number$,\n"
+          "      com.google.protobuf.WireFormat.WIRETYPE_LENGTH_DELIMITED);\n"
+          "  output.writeUInt32NoTag(length);\n"
+          "  arena_.writeBlob(output, arena_.getInt($at$), length);\n"
+          "}\n");
+    } else {
+      printer->Print(vars,
+                     "if ($is_present$) {\n"
+                     "  output.write$capitalized_type$($number$, "
+                     "arena_.get$arena_type$($at$));\n"
+                     "}\n");
+    }
+  }
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
+void OffHeapGenerator::GenerateSerializedSize(io::Printer* printer) {
+  printer->Print(
+      "public int getSerializedSize() {\n"
+      "  int size = 0;\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    std::map<std::string, std::string> vars = FieldVariables(field);
+    if (IsBlob(field)) {
+      printer->Print(
+          vars,
+          "if ($is_present$) {\n"
+          "  int length = arena_.getInt($length_at$);\n"
+          "  size += com.google.protobuf.CodedOutputStream"
+          ".computeTagSize($number$)\n"
+          "      + com.google.protobuf.CodedOutputStream"
+          ".computeUInt32SizeNoTag(length)\n"
+          "      + length;\n"
+          "}\n");
+    } else {
+      printer->Print(vars,
+                     "if ($is_present$) {\n"
+                     "  size += com.google.protobuf.CodedOutputStream\n"
+                     "    .compute$capitalized_type$Size($number$, "
+                     "arena_.get$arena_type$($at$));\n"
+                     "}\n");
+    }
+  }
+  printer->Outdent();
+  printer->Print(
+      "  return size;\n"
+      "}\n"
+      "\n");
+}
+
+}  // namespace java_leo
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
@@ -0,0 +1,102 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Generates the <Message>OffHeap records of messages with the off_heap option.
+
+#ifndef GOOGLE_PROTOBUF_COMPILER_JAVA_OFF_HEAP_H__
+#define GOOGLE_PROTOBUF_COMPILER_JAVA_OFF_HEAP_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/descriptor.h>
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+class Context;            // context.h
+class ClassNameResolver;  // name_resolver.h
+}  // namespace java_leo
+}  // namespace compiler
+namespace io {
+class Printer;  // printer.h
+}
+}  // namespace protobuf
+}  // namespace google
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+
+// A record keeps the has-bits first, then the fields that take 8 bytes, 4
+// bytes and 1 byte, so every value is aligned. Strings and bytes take 8 bytes:
+// the offset of their blob in the arena and their length + 1, 0 while absent.
+// The record stores the same fields as the table (see IsTableColumn).
+class OffHeapGenerator {
+ public:
+  OffHeapGenerator(const Descriptor* descriptor, Context* context);
+  ~OffHeapGenerator();
+
+  void Generate(io::Printer* printer);
+
+ private:
+  void GenerateAccessors(const FieldDescriptor* field, io::Printer* printer);
+  void GenerateClear(io::Printer* printer);
+  void GenerateCopyFrom(io::Printer* printer);
+  void GenerateUpdateFrom(io::Printer* printer);
+  void GenerateWriteTo(io::Printer* printer);
+  void GenerateSerializedSize(io::Printer* printer);
+
+  std::map<std::string, std::string> FieldVariables(
+      const FieldDescriptor* field) const;
+
+  const Descriptor* descriptor_;
+  Context* context_;
+  ClassNameResolver* name_resolver_;
+  std::vector<const FieldDescriptor*> fields_;
+  // offset of each field in the record
+  std::map<const FieldDescriptor*, int> offsets_;
+  // has-bit of each field, -1 if the field has no presence
+  std::map<const FieldDescriptor*, int> presence_bits_;
+  int presence_bit_count_;
+  int record_size_;
+
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(OffHeapGenerator);
+};
+
+}  // namespace java_leo
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#endif  // GOOGLE_PROTOBUF_COMPILER_JAVA_OFF_HEAP_H__
@@ -55,7 +55,6 @@ using internal::WireFormatLite;
 
 namespace {
 
-string buildConverterName(const string &customType);
 void SetPrimitiveVariables(const FieldDescriptor* descriptor,
                            int messageBitIndex, int builderBitIndex,
                            const FieldGeneratorInfo* info,
@@ -78,9 +77,19 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
     (*variables)["default"] = "null";
     (*variables)["default_init"] = "";
 
-    string converterName = buildConverterName(customType);
+    // built-in codecs and stream converters also read / write the wire format
+    // themselves, fromProto / toProto are then only used for json.
+    string codecName = BuiltinCodecClassName(descriptor);
+    string converterName =
+        codecName.empty() ? ConverterClassName(customType) : codecName;
+    if (codecName.empty() && UseStreamConverter(descriptor)) {
+      codecName = converterName;
+    }
     (*variables)["customTypeParse"] = converterName + ".fromProto";
     (*variables)["customTypeSerialize"] = converterName + ".toProto";
+    (*variables)["customTypeCopy"] = converterName + ".copy";
+    (*variables)["customTypeMerge"] = converterName + ".mergeInto";
+    (*variables)["customTypeCodec"] = codecName;
   } else {
     (*variables)["type"] = PrimitiveTypeName(javaType);
     (*variables)["boxed_type"] = BoxedPrimitiveTypeName(javaType);
@@ -92,7 +101,8 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
 
     (*variables)["customTypeParse"] = "";
     (*variables)["customTypeSerialize"] = "";
-
+    (*variables)["customTypeCopy"] = "";
+    (*variables)["customTypeCodec"] = "";
   }
 
   if (javaType == JAVATYPE_BOOLEAN || javaType == JAVATYPE_DOUBLE ||
@@ -102,7 +112,8 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
         PrimitiveTypeName(javaType), /*cap_first_letter=*/true);
     (*variables)["field_list_type"] =
         "com.google.protobuf.Internal." + capitalized_type + "List";
-    (*variables)["empty_list"] = "new" + capitalized_type + "List()";
+    (*variables)["empty_list"] = "empty" + capitalized_type + "List()";
+    (*variables)["shared_empty_list"] = (*variables)["empty_list"];
     (*variables)["create_list"] = "new" + capitalized_type + "List()";
     (*variables)["mutable_copy_list"] =
         "mutableCopy(" + (*variables)["name"] + "_)";
@@ -122,7 +133,8 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
     (*variables)["mutable_copy_list"] = "new java.util.ArrayList<" +
                                         (*variables)["boxed_type"] + ">(" +
                                         (*variables)["name"] + "_)";
-    (*variables)["empty_list"] = (*variables)["create_list"];
+    (*variables)["empty_list"] = "java.util.Collections.emptyList()";
+    (*variables)["shared_empty_list"] = "java.util.Collections.EMPTY_LIST";
     (*variables)["name_make_immutable"] =
         (*variables)["name"] + "_ = java.util.Collections.unmodifiableList(" +
         (*variables)["name"] + "_)";
@@ -188,18 +200,40 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
   (*variables)["set_has_field_bit_to_local"] =
       GenerateSetBitToLocal(messageBitIndex);
 
-  if (descriptor->is_packed()) {
-    (*variables)["resetMemoized"] = "  " + (*variables)["name"] + "MemoizedSerializedSize = -1;\n";
-  } else {
-    (*variables)["resetMemoized"] = "";
+}
+
+bool HasStreamCodec(const std::map<std::string, std::string>& variables) {
+  return !variables.at("customTypeCodec").empty();
+}
+
+// Converts the raw bits of the long $oneof_name$Bits_ slot to the value of a
+// numeric or bool oneof member and back.
+std::string FromOneofBits(JavaType type, const std::string& bits) {
+  switch (type) {
+    case JAVATYPE_INT:
+      return "(int) " + bits;
+    case JAVATYPE_FLOAT:
+      return "java.lang.Float.intBitsToFloat((int) " + bits + ")";
+    case JAVATYPE_DOUBLE:
+      return "java.lang.Double.longBitsToDouble(" + bits + ")";
+    case JAVATYPE_BOOLEAN:
+      return "(" + bits + " != 0L)";
+    default:
+      return bits;
   }
 }
 
-string buildConverterName(const string &customType) {
-  std::string name(customType);
-  std::transform(name.begin(), name.end(), name.begin(), toupper);
-  std::replace(name.begin(), name.end(), '.', '_');
-  return "de.leohilbert.protoconverter.ProtoConverter_" + name;
+std::string ToOneofBits(JavaType type, const std::string& value) {
+  switch (type) {
+    case JAVATYPE_FLOAT:
+      return "java.lang.Float.floatToRawIntBits(" + value + ")";
+    case JAVATYPE_DOUBLE:
+      return "java.lang.Double.doubleToRawLongBits(" + value + ")";
+    case JAVATYPE_BOOLEAN:
+      return "(" + value + " ? 1L : 0L)";
+    default:
+      return value;
+  }
 }
 
 }  // namespace
@@ -213,6 +247,8 @@ ImmutablePrimitiveFieldGenerator::ImmutablePrimitiveFieldGenerator(
   SetPrimitiveVariables(descriptor, messageBitIndex, builderBitIndex,
                         context->GetFieldGeneratorInfo(descriptor),
                         name_resolver_, &variables_);
+  SetFieldMemoryVariables(descriptor, variables_["field_type"], false,
+                          &variables_);
 }
 
 ImmutablePrimitiveFieldGenerator::~ImmutablePrimitiveFieldGenerator() {}
@@ -242,8 +278,13 @@ void ImmutablePrimitiveFieldGenerator::GenerateInterfaceMembers(
 
 void ImmutablePrimitiveFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
-  printer->Print(variables_, "private $field_type$ $name$_;\n");
+  PrintFieldDeclaration(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
+  if (UseInPlaceConverter(descriptor_)) {
+    // updateFrom reads into this message instead of allocating a new one
+    printer->Print(variables_,
+                   "private transient $message_type$ $name$Scratch_;\n");
+  }
   if (SupportFieldPresence(descriptor_)) {
     WriteFieldAccessorDocComment(printer, descriptor_, HAZZER);
     printer->Print(
@@ -259,7 +300,7 @@ void ImmutablePrimitiveFieldGenerator::GenerateMembers(
   printer->Print(variables_,
                  "@java.lang.Override\n"
                  "$deprecation$public $type$ ${$get$capitalized_name$$}$() {\n"
-                 "  return $name$_;\n"
+                 "  return $read_field$;\n"
                  "}\n");
   printer->Annotate("{", "}", descriptor_);
 
@@ -267,35 +308,40 @@ void ImmutablePrimitiveFieldGenerator::GenerateMembers(
   WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
   printer->Print(variables_,
                  "$deprecation$public $classname$ "
-                 "${$set$capitalized_name$$}$($type$ value) {\n"
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  $set_has_field_bit_message$\n"
                  "  if($name$_ != value) {\n"
-                 "    $name$_ = value;\n"
+                 "    $store_prefix$value$store_suffix$;\n"
                  "    $on_changed$\n"
-                 "  }\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER, true);
   printer->Print(
       variables_,
       "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
   JavaType type = GetJavaType(descriptor_);
   if (type == JAVATYPE_STRING || type == JAVATYPE_BYTES) {
     // The default value is not a simple literal so we want to avoid executing
     // it multiple times.  Instead, get the default out of the default instance.
     printer->Print(
         variables_,
-        "  $name$_ = getDefaultInstance().get$capitalized_name$();\n");
+        "  $store_prefix$getDefaultInstance()"
+        ".get$capitalized_name$()"
+        "$store_suffix$;\n");
   } else {
-    printer->Print(variables_, "  $name$_ = $default$;\n");
+    printer->Print(variables_,
+                   "  $store_prefix$$default$$store_suffix$;\n");
   }
-  printer->Print(variables_,
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutablePrimitiveFieldGenerator::GenerateInitializationCode(
@@ -331,8 +377,133 @@ void ImmutablePrimitiveFieldGenerator::GenerateMergingCode(
   }
 }
 
+void ImmutablePrimitiveFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM &&
+      UseCopyConverter(descriptor_)) {
+    // the custom object is mutable, the converter decides how to copy it
+    printer->Print(variables_,
+                   "$store_prefix$other.$name$_ == null ? null : "
+                   "$customTypeCopy$(other.$name$_)$store_suffix$;\n");
+  } else {
+    printer->Print(variables_,
+                   "$store_prefix$other.$name$_$store_suffix$;\n");
+  }
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$customTypeSerialize$($name$_)", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  if (descriptor_->message_type() != nullptr) {
+    printer->Print(variables_,
+                   "$message_type$ message = new $message_type$();\n"
+                   "message.updateFromJson(in);\n"
+                   "$set_has_field_bit_message$\n"
+                   "$store_prefix$$customTypeParse$(message)$store_suffix$;\n");
+  } else {
+    printer->Print(variables_,
+                   ("$set_has_field_bit_message$\n"
+                    "$store_prefix$$customTypeParse$(" +
+                    JsonValueReader(descriptor_, name_resolver_) +
+                    ")$store_suffix$;\n")
+                       .c_str());
+  }
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckByNumber(descriptor_, variables_.at("boxed_type"),
+                     IsReferenceType(GetJavaType(descriptor_)), printer);
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  // the setter stores with the field memory semantics and notifies
+  printer->Print(variables_,
+                 "set$capitalized_name$(($boxed_type$) value);\n");
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  switch (GetJavaType(descriptor_)) {
+    case JAVATYPE_INT:
+    case JAVATYPE_LONG:
+    case JAVATYPE_BOOLEAN:
+      printer->Print(variables_, "if ($name$_ != other.$name$_) {\n");
+      break;
+
+    case JAVATYPE_FLOAT:
+      printer->Print(
+          variables_,
+          "if (java.lang.Float.floatToIntBits($name$_)\n"
+          "    != java.lang.Float.floatToIntBits(other.$name$_)) {\n");
+      break;
+
+    case JAVATYPE_DOUBLE:
+      printer->Print(
+          variables_,
+          "if (java.lang.Double.doubleToLongBits($name$_)\n"
+          "    != java.lang.Double.doubleToLongBits(other.$name$_)) {\n");
+      break;
+
+    case JAVATYPE_STRING:
+    case JAVATYPE_CUSTOM:
+    case JAVATYPE_BYTES:
+      printer->Print(variables_,
+                     "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n");
+      break;
+
+    case JAVATYPE_ENUM:
+    case JAVATYPE_MESSAGE:
+    default:
+      GOOGLE_LOG(FATAL) << "Can't get here.";
+      break;
+  }
+  printer->Print(variables_,
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
+void ImmutablePrimitiveFieldGenerator::GenerateParsingPrologueCode(
+    io::Printer* printer) const {
+  if (UseInPlaceConverter(descriptor_)) {
+    printer->Print(variables_, "$type$ previous$capitalized_name$ = $name$_;\n");
+  }
+}
+
 void ImmutablePrimitiveFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
+  if (UseInPlaceConverter(descriptor_)) {
+    printer->Print(variables_,
+                   "if ($name$Scratch_ == null) {\n"
+                   "  $name$Scratch_ = new $message_type$();\n"
+                   "}\n"
+                   "int length = input.readRawVarint32();\n"
+                   "int limit = input.pushLimit(length);\n"
+                   "$name$Scratch_.updateFrom(input, extensionRegistry);\n"
+                   "input.checkLastTagWas(0);\n"
+                   "input.popLimit(limit);\n"
+                   "$set_has_field_bit_message$\n"
+                   "$name$_ = $customTypeMerge$(previous$capitalized_name$, $name$Scratch_);\n");
+    return;
+  }
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "$set_has_field_bit_message$\n"
+                   "$name$_ = $customTypeCodec$.read(input);\n");
+    return;
+  }
   printer->Print(variables_,
                  "$set_has_field_bit_message$\n"
                  "$name$_ = $customTypeParse$(");
@@ -352,6 +523,13 @@ void ImmutablePrimitiveFieldGenerator::GenerateParsingDoneCode(
 
 void ImmutablePrimitiveFieldGenerator::GenerateSerializationCode(
     io::Printer* printer) const {
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "if ($is_field_present_message$) {\n"
+                   "  $customTypeCodec$.write(output, $number$, $name$_);\n"
+                   "}\n");
+    return;
+  }
   printer->Print(variables_,
                  "if ($is_field_present_message$) {\n"
                  "  output.write$capitalized_type$($number$, $customTypeSerialize$($name$_));\n"
@@ -360,6 +538,13 @@ void ImmutablePrimitiveFieldGenerator::GenerateSerializationCode(
 
 void ImmutablePrimitiveFieldGenerator::GenerateSerializedSizeCode(
     io::Printer* printer) const {
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "if ($is_field_present_message$) {\n"
+                   "  size += $tag_size$ + $customTypeCodec$.size($name$_);\n"
+                   "}\n");
+    return;
+  }
   printer->Print(variables_,
                  "if ($is_field_present_message$) {\n"
                  "  size += com.google.protobuf.CodedOutputStream\n"
@@ -477,6 +662,11 @@ ImmutablePrimitiveOneofFieldGenerator::ImmutablePrimitiveOneofFieldGenerator(
   const OneofGeneratorInfo* info =
       context->GetOneofGeneratorInfo(descriptor->containing_oneof());
   SetCommonOneofVariables(descriptor, info, &variables_);
+  if (UsesOneofBits(descriptor)) {
+    variables_["oneof_bits"] = info->name + "Bits_";
+    variables_["oneof_value"] =
+        FromOneofBits(GetJavaType(descriptor), info->name + "Bits_");
+  }
 }
 
 ImmutablePrimitiveOneofFieldGenerator::
@@ -495,11 +685,14 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateMembers(
     printer->Annotate("{", "}", descriptor_);
   }
 
+  const bool bits = UsesOneofBits(descriptor_);
   WriteFieldAccessorDocComment(printer, descriptor_, GETTER);
   printer->Print(variables_,
                  "$deprecation$public $type$ ${$get$capitalized_name$$}$() {\n"
-                 "  if ($has_oneof_case_message$) {\n"
-                 "    return ($boxed_type$) $oneof_name$_;\n"
+                 "  if ($has_oneof_case_message$) {\n");
+  printer->Print(variables_, bits ? "    return $oneof_value$;\n"
+                                  : "    return ($boxed_type$) $oneof_name$_;\n");
+  printer->Print(variables_,
                  "  }\n"
                  "  return $default$;\n"
                  "}\n");
@@ -509,27 +702,40 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateMembers(
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ "
-                 "${$set$capitalized_name$$}$($type$ value) {\n"
-                 "  $set_oneof_case_message$;\n"
-                 "  $oneof_name$_ = value;\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "${$set$capitalized_name$$}$($type$ value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_, "  $set_oneof_case_message$;\n");
+  if (bits) {
+    // drop whatever reference another member left behind
+    printer->Print(
+        variables_,
+        ("  $oneof_bits$ = " + ToOneofBits(GetJavaType(descriptor_), "value") +
+         ";\n"
+         "  $oneof_name$_ = null;\n")
+            .c_str());
+  } else {
+    printer->Print(variables_, "  $oneof_name$_ = value;\n");
+  }
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER,
       /* builder */ true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
-      "  if ($has_oneof_case_message$) {\n"
-      "    $clear_oneof_case_message$;\n"
-      "    $oneof_name$_ = null;\n"
-      "    $on_changed$\n"
-      "  }\n"
-      "  return this;\n"
-      "}\n");
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  if ($has_oneof_case_message$) {\n"
+                 "    $clear_oneof_case_message$;\n"
+                 "    $oneof_name$_ = null;\n"
+                 "    $on_changed$\n"
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutablePrimitiveOneofFieldGenerator::GenerateMergingCode(
@@ -538,15 +744,151 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateMergingCode(
                  "set$capitalized_name$(other.get$capitalized_name$());\n");
 }
 
+void ImmutablePrimitiveOneofFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM &&
+      UseCopyConverter(descriptor_)) {
+    printer->Print(variables_,
+                   "$oneof_name$_ = $customTypeCopy$(($type$) other.$oneof_name$_);\n");
+  } else if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   "$oneof_bits$ = other.$oneof_bits$;\n"
+                   "$oneof_name$_ = null;\n");
+  } else {
+    printer->Print(variables_, "$oneof_name$_ = other.$oneof_name$_;\n");
+  }
+}
+
+void ImmutablePrimitiveOneofFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($has_oneof_case_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM) {
+    printer->Print(variables_,
+                   JsonValueWriter(descriptor_,
+                                   "$customTypeSerialize$(($type$) $oneof_name$_)",
+                                   name_resolver_).c_str());
+  } else if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   JsonValueWriter(descriptor_, "$oneof_value$", name_resolver_)
+                       .c_str());
+  } else {
+    printer->Print(variables_,
+                   JsonValueWriter(descriptor_, "(($boxed_type$) $oneof_name$_)",
+                                   name_resolver_).c_str());
+  }
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutablePrimitiveOneofFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  if (descriptor_->message_type() != nullptr) {
+    printer->Print(variables_,
+                   "$message_type$ message = new $message_type$();\n"
+                   "message.updateFromJson(in);\n"
+                   "$oneof_name$_ = $customTypeParse$(message);\n"
+                   "$set_oneof_case_message$;\n");
+  } else if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   ("$oneof_bits$ = " +
+                    ToOneofBits(GetJavaType(descriptor_),
+                                JsonValueReader(descriptor_, name_resolver_)) +
+                    ";\n"
+                    "$oneof_name$_ = null;\n"
+                    "$set_oneof_case_message$;\n")
+                       .c_str());
+  } else {
+    printer->Print(variables_,
+                   ("$oneof_name$_ = $customTypeParse$(" +
+                    JsonValueReader(descriptor_, name_resolver_) + ");\n"
+                    "$set_oneof_case_message$;\n")
+                       .c_str());
+  }
+}
+
+void ImmutablePrimitiveOneofFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   ("$oneof_bits$ = " +
+                    ToOneofBits(GetJavaType(descriptor_), "($boxed_type$) value") +
+                    ";\n"
+                    "$oneof_name$_ = null;\n"
+                    "$set_oneof_case_message$;\n"
+                    "$on_changed$\n")
+                       .c_str());
+    return;
+  }
+  printer->Print(variables_,
+                 "$oneof_name$_ = ($boxed_type$) value;\n"
+                 "$set_oneof_case_message$;\n"
+                 "$on_changed$\n");
+}
+
+void ImmutablePrimitiveOneofFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   "if ($oneof_bits$ != other.$oneof_bits$) {\n"
+                   "  mask |= $diff_bit$;\n"
+                   "}\n");
+    return;
+  }
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($oneof_name$_, other.$oneof_name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutablePrimitiveOneofFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
+  if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   ("$set_oneof_case_message$;\n"
+                    "$oneof_bits$ = " +
+                    ToOneofBits(GetJavaType(descriptor_),
+                                "input.read$capitalized_type$()") +
+                    ";\n"
+                    "$oneof_name$_ = null;\n")
+                       .c_str());
+    return;
+  }
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "$set_oneof_case_message$;\n"
+                   "$oneof_name$_ = $customTypeCodec$.read(input);\n");
+    return;
+  }
   printer->Print(variables_,
                  "$set_oneof_case_message$;\n"
-                 "$oneof_name$_ = $customTypeParse$(input.read$capitalized_type$());\n");
+                 "$oneof_name$_ = $customTypeParse$(");
+  if (descriptor_->message_type() != nullptr) {
+    printer->Print(variables_,
+                   "input.readMessage($message_type$.$get_parser$, extensionRegistry));\n");
+  } else {
+    printer->Print(variables_, "input.read$capitalized_type$());\n");
+  }
 }
 
 void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializationCode(
     io::Printer* printer) const {
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "if ($has_oneof_case_message$) {\n"
+                   "  $customTypeCodec$.write(output, $number$, ($type$) $oneof_name$_);\n"
+                   "}\n");
+    return;
+  }
+  if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   "if ($has_oneof_case_message$) {\n"
+                   "  output.write$capitalized_type$($number$, $oneof_value$);\n"
+                   "}\n");
+    return;
+  }
   printer->Print(variables_,
                  "if ($has_oneof_case_message$) {\n"
                  "  output.write$capitalized_type$(\n");
@@ -554,6 +896,8 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializationCode(
   // do redundant casts.
   if (GetJavaType(descriptor_) == JAVATYPE_BYTES) {
     printer->Print(variables_, "      $number$, ($type$) $customTypeSerialize$($oneof_name$_));\n");
+  } else if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM) {
+    printer->Print(variables_, "      $number$, $customTypeSerialize$(($type$) $oneof_name$_));\n");
   } else {
     printer->Print(
         variables_,
@@ -564,6 +908,21 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializationCode(
 
 void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializedSizeCode(
     io::Printer* printer) const {
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "if ($has_oneof_case_message$) {\n"
+                   "  size += $tag_size$ + $customTypeCodec$.size(($type$) $oneof_name$_);\n"
+                   "}\n");
+    return;
+  }
+  if (UsesOneofBits(descriptor_)) {
+    printer->Print(variables_,
+                   "if ($has_oneof_case_message$) {\n"
+                   "  size += com.google.protobuf.CodedOutputStream\n"
+                   "    .compute$capitalized_type$Size($number$, $oneof_value$);\n"
+                   "}\n");
+    return;
+  }
   printer->Print(variables_,
                  "if ($has_oneof_case_message$) {\n"
                  "  size += com.google.protobuf.CodedOutputStream\n"
@@ -572,6 +931,8 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializedSizeCode(
   // do redundant casts.
   if (GetJavaType(descriptor_) == JAVATYPE_BYTES) {
     printer->Print(variables_, "        $number$, ($type$) $customTypeSerialize$($oneof_name$_));\n");
+  } else if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM) {
+    printer->Print(variables_, "        $number$, $customTypeSerialize$(($type$) $oneof_name$_));\n");
   } else {
     printer->Print(
         variables_,
@@ -582,6 +943,177 @@ void ImmutablePrimitiveOneofFieldGenerator::GenerateSerializedSizeCode(
 
 // ===================================================================
 
+ImmutableCompactBoolFieldGenerator::ImmutableCompactBoolFieldGenerator(
+    const FieldDescriptor* descriptor, int messageBitIndex, int builderBitIndex,
+    Context* context)
+    : ImmutablePrimitiveFieldGenerator(descriptor, messageBitIndex,
+                                       builderBitIndex, context),
+      value_bit_index_(CompactValueBitIndex(descriptor, messageBitIndex)) {
+  num_bits_ = value_bit_index_ + 1 - messageBitIndex;
+  variables_["read_field"] = GenerateGetBit(value_bit_index_);
+  if (SupportFieldPresence(descriptor)) {
+    variables_["clear_has_field_bit_message"] =
+        GenerateClearBit(messageBitIndex) + ";";
+  } else {
+    variables_["clear_has_field_bit_message"] = "";
+    variables_["is_field_present_message"] = variables_["read_field"];
+  }
+}
+
+ImmutableCompactBoolFieldGenerator::~ImmutableCompactBoolFieldGenerator() {}
+
+int ImmutableCompactBoolFieldGenerator::GetNumBitsForMessage() const {
+  return num_bits_;
+}
+
+int ImmutableCompactBoolFieldGenerator::GetNumBitsForBuilder() const {
+  // keeps the builder bits of the following fields in line with their has-bits
+  return num_bits_;
+}
+
+void ImmutableCompactBoolFieldGenerator::PrintStore(
+    io::Printer* printer, const std::string& value) const {
+  printer->Print(variables_,
+                 (GenerateStoreBit(value_bit_index_, value) + ";\n").c_str());
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateMembers(
+    io::Printer* printer) const {
+  PrintExtraFieldInfo(variables_, printer);
+  if (SupportFieldPresence(descriptor_)) {
+    WriteFieldAccessorDocComment(printer, descriptor_, HAZZER);
+    printer->Print(
+        variables_,
+        "@java.lang.Override\n"
+        "$deprecation$public boolean ${$has$capitalized_name$$}$() {\n"
+        "  return $get_has_field_bit_message$;\n"
+        "}\n");
+    printer->Annotate("{", "}", descriptor_);
+  }
+
+  WriteFieldAccessorDocComment(printer, descriptor_, GETTER);
+  printer->Print(variables_,
+                 "@java.lang.Override\n"
+                 "$deprecation$public boolean ${$get$capitalized_name$$}$() {\n"
+                 "  return $read_field$;\n"
+                 "}\n");
+  printer->Annotate("{", "}", descriptor_);
+
+  WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
+  printer->Print(variables_,
+                 "$deprecation$public $classname$ "
+                 "${$set$capitalized_name$$}$(boolean value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  $set_has_field_bit_message$\n"
+                 "  if ($read_field$ != value) {\n");
+  printer->Indent();
+  printer->Indent();
+  PrintStore(printer, "value");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(variables_,
+                 "    $on_changed$\n"
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
+
+  WriteFieldAccessorDocComment(printer, descriptor_, CLEARER, true);
+  printer->Print(
+      variables_,
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Indent();
+  PrintStore(printer, variables_.at("default"));
+  printer->Outdent();
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateInitializationCode(
+    io::Printer* printer) const {
+  if (!IsDefaultValueJavaDefault(descriptor_)) {
+    PrintStore(printer, variables_.at("default"));
+  }
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateClearCode(
+    io::Printer* printer) const {
+  PrintStore(printer, variables_.at("default"));
+  printer->Print(variables_, "$clear_has_field_bit_message$\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateToStringCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "sb.append(\"\\\"$name$\\\": \\\"\").append(java.lang.String.valueOf($read_field$)).append(\"\\\",\\n\");\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  // the value is copied along with the bitfields
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$read_field$", name_resolver_)
+                     .c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$set_has_field_bit_message$\n");
+  PrintStore(printer, JsonValueReader(descriptor_, name_resolver_));
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "set$capitalized_name$((java.lang.Boolean) value);\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($read_field$ != other.get$capitalized_name$()) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$set_has_field_bit_message$\n");
+  PrintStore(printer, "input.readBool()");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateSerializationCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  output.writeBool($number$, $read_field$);\n"
+                 "}\n");
+}
+
+void ImmutableCompactBoolFieldGenerator::GenerateSerializedSizeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  size += com.google.protobuf.CodedOutputStream\n"
+                 "    .computeBoolSize($number$, $read_field$);\n"
+                 "}\n");
+}
+
+// ===================================================================
+
 RepeatedImmutablePrimitiveFieldGenerator::
     RepeatedImmutablePrimitiveFieldGenerator(const FieldDescriptor* descriptor,
                                              int messageBitIndex,
@@ -601,7 +1133,7 @@ int RepeatedImmutablePrimitiveFieldGenerator::GetNumBitsForMessage() const {
 }
 
 int RepeatedImmutablePrimitiveFieldGenerator::GetNumBitsForBuilder() const {
-  return 1;
+  return 0;
 }
 
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateInterfaceMembers(
@@ -637,15 +1169,16 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateInterfaceMembers(
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
   printer->Print(variables_, "private $field_list_type$ $name$_;\n");
+  PrintEnsureRepeatedFieldMutable(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_GETTER);
   printer->Print(variables_,
                  "@java.lang.Override\n"
                  "$deprecation$public java.util.List<$boxed_type$>\n"
-                 "    ${$get$capitalized_name$List$}$() {\n"
-                 "  return $name$_;\n"  // note:  unmodifiable list
-                 "}\n");
+                 "    ${$get$capitalized_name$List$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintReturnUnmodifiableList(variables_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_COUNT);
   printer->Print(
       variables_,
@@ -671,46 +1204,58 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateMembers(
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$set$capitalized_name$$}$(\n"
-                 "    int index, $type$ value) {\n"
-                 "  $name$_.set(index, value);\n"
-                 "$resetMemoized$"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    int index, $type$ value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.set(index, value);\n");
+  PrintResetMemoizedSize(descriptor_, variables_, printer);
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_ADDER,
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$add$capitalized_name$$}$(\n"
-                 "    $type$ value) {\n"
-                 "  $name$_.add(value);\n"
-                 "$resetMemoized$"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    $type$ value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.add(value);\n");
+  PrintResetMemoizedSize(descriptor_, variables_, printer);
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_MULTI_ADDER,
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$addAll$capitalized_name$$}$(\n"
-                 "    java.util.Collection<$boxed_type$> values) {\n"
-                 "  $name$_.addAll(values);\n"
-                 "$resetMemoized$"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    java.util.Collection<$boxed_type$> values) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.addAll(values);\n");
+  PrintResetMemoizedSize(descriptor_, variables_, printer);
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER,
       /* builder */ true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
-      "  $name$_ = $empty_list$;\n"
-      "$resetMemoized$"
-      "  $on_changed$\n"
-      "  return this;\n"
-      "}\n");
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Indent();
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Outdent();
+  PrintResetMemoizedSize(descriptor_, variables_, printer);
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateInitializationCode(
@@ -720,8 +1265,7 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateInitializationCode(
 
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateClearCode(
     io::Printer* printer) const {
-  printer->Print(variables_,
-                 "$name$_ = $empty_list$;\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
 }
 
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateToStringCode(io::Printer* printer) const {
@@ -747,13 +1291,111 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateMergingCode(
                  "}\n");
 }
 
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  if (GetJavaType(descriptor_) == JAVATYPE_CUSTOM &&
+      UseCopyConverter(descriptor_)) {
+    // the list is sized to the source, since the elements are added one by one
+    printer->Print(variables_,
+                   "if (!other.$name$_.isEmpty()) {\n"
+                   "  if ($name$_ == $shared_empty_list$) {\n"
+                   "    $name$_ = new java.util.ArrayList<$boxed_type$>(other.$name$_.size());\n"
+                   "  }\n"
+                   "  for (int i = 0; i < other.$name$_.size(); i++) {\n"
+                   "    $name$_.add($customTypeCopy$(other.$name$_.get(i)));\n"
+                   "  }\n"
+                   "}\n");
+  } else {
+    printer->Print(variables_,
+                   "if (!other.$name$_.isEmpty()) {\n"
+                   "  ensure$capitalized_name$IsMutable();\n"
+                   "  $name$_.addAll(other.$name$_);\n"
+                   "}\n");
+  }
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateFreezeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$name_make_immutable$;\n");
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!$name$_.isEmpty()) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n"
+                 "  out.append('[');\n"
+                 "  for (int i = 0; i < $name$_.size(); i++) {\n"
+                 "    if (i > 0) {\n"
+                 "      out.append(',');\n"
+                 "    }\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$customTypeSerialize$($repeated_get$(i))", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print("  }\n"
+                 "  out.append(']');\n"
+                 "}\n");
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "in.beginArray();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "while (in.hasNextElement()) {\n"
+                 "  ensure$capitalized_name$IsMutable();\n");
+  if (descriptor_->message_type() != nullptr) {
+    printer->Print(variables_,
+                   "  $message_type$ message = new $message_type$();\n"
+                   "  message.updateFromJson(in);\n"
+                   "  $repeated_add$($customTypeParse$(message));\n");
+  } else {
+    printer->Print(variables_,
+                   ("  $repeated_add$($customTypeParse$(" +
+                    JsonValueReader(descriptor_, name_resolver_) + "));\n")
+                       .c_str());
+  }
+  printer->Print("}\n");
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckListByNumber(descriptor_, variables_.at("boxed_type"), printer);
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "ensure$capitalized_name$IsMutable();\n"
+                 "$name$_.addAll((java.util.Collection<$boxed_type$>) value);\n"
+                 "$on_changed$\n");
+}
+
+void RepeatedImmutablePrimitiveFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
+  // updateFrom cleared the list in place before the first tag
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "ensure$capitalized_name$IsMutable();\n"
+                   "$repeated_add$($customTypeCodec$.read(input));\n");
+    return;
+  }
   printer->Print(variables_,
-                 "if (!$get_mutable_bit_parser$) {\n"
-                 "  $name$_ = $create_list$;\n"
-                 "  $set_mutable_bit_parser$;\n"
-                 "}\n"
+                 "ensure$capitalized_name$IsMutable();\n"
                  "$repeated_add$($customTypeParse$(input.read$capitalized_type$()));\n");
 }
 
@@ -763,12 +1405,20 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateParsingCodeFromPacked(
       variables_,
       "int length = input.readRawVarint32();\n"
       "int limit = input.pushLimit(length);\n"
-      "if (!$get_mutable_bit_parser$ && input.getBytesUntilLimit() > 0) {\n"
-      "  $name$_ = $create_list$;\n"
-      "  $set_mutable_bit_parser$;\n"
+      "if (input.getBytesUntilLimit() > 0) {\n"
+      "  ensure$capitalized_name$IsMutable();\n"
       "}\n"
-      "while (input.getBytesUntilLimit() > 0) {\n"
-      "  $repeated_add$($customTypeParse$(input.read$capitalized_type$()));\n"
+      "while (input.getBytesUntilLimit() > 0) {\n");
+  // packed values have no tags of their own, read() starts after the tag anyway
+  if (HasStreamCodec(variables_)) {
+    printer->Print(variables_,
+                   "  $repeated_add$($customTypeCodec$.read(input));\n");
+  } else {
+    printer->Print(
+        variables_,
+        "  $repeated_add$($customTypeParse$(input.read$capitalized_type$()));\n");
+  }
+  printer->Print(
       "}\n"
       "input.popLimit(limit);\n");
 }
@@ -784,13 +1434,19 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateSerializationCode(
     // fields in ImmutableMessageGenerator::GenerateMessageSerializationMethods.
     // That makes it safe to rely on the memoized size here.
     printer->Print(variables_,
-                   "if (get$capitalized_name$List().size() > 0) {\n"
+                   "if ($name$_.size() > 0) {\n"
                    "  output.writeUInt32NoTag($tag$);\n"
                    "  output.writeUInt32NoTag($name$MemoizedSerializedSize);\n"
                    "}\n"
                    "for (int i = 0; i < $name$_.size(); i++) {\n"
                    "  output.write$capitalized_type$NoTag($customTypeSerialize$($repeated_get$(i)));\n"
                    "}\n");
+  } else if (HasStreamCodec(variables_)) {
+    printer->Print(
+        variables_,
+        "for (int i = 0; i < $name$_.size(); i++) {\n"
+        "  $customTypeCodec$.write(output, $number$, $repeated_get$(i));\n"
+        "}\n");
   } else {
     printer->Print(
         variables_,
@@ -807,7 +1463,13 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateSerializedSizeCode(
                  "  int dataSize = 0;\n");
   printer->Indent();
 
-  if (FixedSize(GetType(descriptor_)) == -1) {
+  if (HasStreamCodec(variables_)) {
+    printer->Print(
+        variables_,
+        "for (int i = 0; i < $name$_.size(); i++) {\n"
+        "  dataSize += $customTypeCodec$.size($repeated_get$(i));\n"
+        "}\n");
+  } else if (FixedSize(GetType(descriptor_)) == -1) {
     printer->Print(
         variables_,
         "for (int i = 0; i < $name$_.size(); i++) {\n"
@@ -817,14 +1479,14 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateSerializedSizeCode(
   } else {
     printer->Print(
         variables_,
-        "dataSize = $fixed_size$ * get$capitalized_name$List().size();\n");
+        "dataSize = $fixed_size$ * $name$_.size();\n");
   }
 
   printer->Print("size += dataSize;\n");
 
   if (descriptor_->is_packed()) {
     printer->Print(variables_,
-                   "if (!get$capitalized_name$List().isEmpty()) {\n"
+                   "if (!$name$_.isEmpty()) {\n"
                    "  size += $tag_size$;\n"
                    "  size += com.google.protobuf.CodedOutputStream\n"
                    "      .computeInt32SizeNoTag(dataSize);\n"
@@ -832,7 +1494,7 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateSerializedSizeCode(
   } else {
     printer->Print(
         variables_,
-        "size += $tag_size$ * get$capitalized_name$List().size();\n");
+        "size += $tag_size$ * $name$_.size();\n");
   }
 
   // cache the data size for packed fields.
@@ -848,8 +1510,8 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateEqualsCode(
     io::Printer* printer) const {
   printer->Print(
       variables_,
-      "if (!java.util.Objects.equals(get$capitalized_name$List(),\n"
-      "    other.get$capitalized_name$List())) return false;\n");
+      "if (!java.util.Objects.equals($name$_,\n"
+      "    other.$name$_)) return false;\n");
 }
 
 void RepeatedImmutablePrimitiveFieldGenerator::GenerateHashCode(
@@ -858,7 +1520,7 @@ void RepeatedImmutablePrimitiveFieldGenerator::GenerateHashCode(
       variables_,
       "if (get$capitalized_name$Count() > 0) {\n"
       "  hash = (37 * hash) + $constant_name$;\n"
-      "  hash = (53 * hash) + java.util.Objects.hashCode(get$capitalized_name$List());\n"
+      "  hash = (53 * hash) + java.util.Objects.hashCode($name$_);\n"
       "}\n");
 }
 
@@ -73,7 +73,14 @@ class ImmutablePrimitiveFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateParsingPrologueCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
@@ -101,6 +108,11 @@ class ImmutablePrimitiveOneofFieldGenerator
 
   void GenerateMembers(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
@@ -109,6 +121,41 @@ class ImmutablePrimitiveOneofFieldGenerator
   GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutablePrimitiveOneofFieldGenerator);
 };
 
+// A singular bool field of a compact_layout message, its value is a bit of the
+// shared bitfields.
+class ImmutableCompactBoolFieldGenerator
+    : public ImmutablePrimitiveFieldGenerator {
+ public:
+  ImmutableCompactBoolFieldGenerator(const FieldDescriptor* descriptor,
+                                     int messageBitIndex, int builderBitIndex,
+                                     Context* context);
+  ~ImmutableCompactBoolFieldGenerator();
+
+  int GetNumBitsForMessage() const;
+  int GetNumBitsForBuilder() const;
+  void GenerateMembers(io::Printer* printer) const;
+  void GenerateInitializationCode(io::Printer* printer) const;
+  void GenerateClearCode(io::Printer* printer) const;
+  void GenerateToStringCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
+  void GenerateParsingCode(io::Printer* printer) const;
+  void GenerateSerializationCode(io::Printer* printer) const;
+  void GenerateSerializedSizeCode(io::Printer* printer) const;
+
+ private:
+  // Prints the statement storing the boolean expression value.
+  void PrintStore(io::Printer* printer, const std::string& value) const;
+
+  int value_bit_index_;
+  int num_bits_;
+
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(ImmutableCompactBoolFieldGenerator);
+};
+
 class RepeatedImmutablePrimitiveFieldGenerator
     : public ImmutableFieldGenerator {
  public:
@@ -126,6 +173,13 @@ class RepeatedImmutablePrimitiveFieldGenerator
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateFreezeCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingCodeFromPacked(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
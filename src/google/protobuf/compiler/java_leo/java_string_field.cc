@@ -63,7 +63,18 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
                            std::map<std::string, std::string>* variables) {
   SetCommonFieldVariables(descriptor, info, variables);
 
-  (*variables)["empty_list"] = "new com.google.protobuf.LazyStringArrayList()";
+  (*variables)["empty_list"] = "com.google.protobuf.LazyStringArrayList.EMPTY";
+  const std::string read_method =
+      CheckUtf8(descriptor) ? "readStringRequireUtf8" : "readString";
+  if (InternStrings(descriptor)) {
+    (*variables)["interner"] = info->name + "Interner_";
+    (*variables)["read_string"] =
+        (*variables)["interner"] + "." + read_method + "(input)";
+  } else {
+    (*variables)["read_string"] = "input." + read_method + "()";
+  }
+  (*variables)["shared_empty_list"] = (*variables)["empty_list"];
+  (*variables)["create_list"] = "new com.google.protobuf.LazyStringArrayList()";
 
   (*variables)["default"] = "null";
   (*variables)["default_init"] =
@@ -73,11 +84,10 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
       StrCat(static_cast<int32>(WireFormat::MakeTag(descriptor)));
   (*variables)["tag_size"] = StrCat(
       WireFormat::TagSize(descriptor->number(), GetType(descriptor)));
-  (*variables)["writeString"] = "com.google.protobuf.GeneratedMessage" +
-                                GeneratedCodeVersionSuffix() + ".writeString";
-  (*variables)["computeStringSize"] = "com.google.protobuf.GeneratedMessage" +
-                                      GeneratedCodeVersionSuffix() +
-                                      ".computeStringSize";
+  (*variables)["writeString"] =
+      GeneratedMessageBaseClass(descriptor->file()) + ".writeString";
+  (*variables)["computeStringSize"] =
+      GeneratedMessageBaseClass(descriptor->file()) + ".computeStringSize";
 
   // TODO(birdo): Add @deprecated javadoc when generating javadoc is supported
   // by the proto compiler
@@ -121,6 +131,19 @@ void SetPrimitiveVariables(const FieldDescriptor* descriptor,
       GenerateSetBitToLocal(messageBitIndex);
 }
 
+// The intern table is static, so equal values parsed into different
+// messages share one String.
+void PrintInternerDeclaration(const FieldDescriptor* descriptor,
+                              const std::map<std::string, std::string>& variables,
+                              io::Printer* printer) {
+  if (InternStrings(descriptor)) {
+    printer->Print(variables,
+                   "private static final de.leohilbert.proto.StringInterner "
+                   "$interner$ =\n"
+                   "    new de.leohilbert.proto.StringInterner();\n");
+  }
+}
+
 }  // namespace
 
 // ===================================================================
@@ -132,6 +155,7 @@ ImmutableStringFieldGenerator::ImmutableStringFieldGenerator(
   SetPrimitiveVariables(descriptor, messageBitIndex, builderBitIndex,
                         context->GetFieldGeneratorInfo(descriptor),
                         name_resolver_, &variables_);
+  SetFieldMemoryVariables(descriptor, "java.lang.String", true, &variables_);
 }
 
 ImmutableStringFieldGenerator::~ImmutableStringFieldGenerator() {}
@@ -194,7 +218,8 @@ void ImmutableStringFieldGenerator::GenerateInterfaceMembers(
 
 void ImmutableStringFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
-  printer->Print(variables_, "private volatile java.lang.String $name$_;\n");
+  PrintFieldDeclaration(variables_, printer);
+  PrintInternerDeclaration(descriptor_, variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
 
   if (SupportFieldPresence(descriptor_)) {
@@ -213,7 +238,7 @@ void ImmutableStringFieldGenerator::GenerateMembers(
       variables_,
       "@java.lang.Override\n"
       "$deprecation$public java.lang.String ${$get$capitalized_name$$}$() {\n"
-      "  return $name$_;\n"
+      "  return $read_field$;\n"
       "}\n");
   printer->Annotate("{", "}", descriptor_);
 
@@ -221,15 +246,17 @@ void ImmutableStringFieldGenerator::GenerateMembers(
   WriteFieldAccessorDocComment(printer, descriptor_, SETTER, false);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$set$capitalized_name$$}$(\n"
-                 "    java.lang.String value) {\n"
+                 "    java.lang.String value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  $set_has_field_bit_builder$\n"
                  "  if (!java.util.Objects.equals(value, $name$_)) {\n"
-                 "    $name$_ = value;\n"
+                 "    $store_prefix$value$store_suffix$;\n"
                  "    $on_changed$\n"
-                 "  }\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableStringFieldGenerator::GenerateInitializationCode(
@@ -268,16 +295,65 @@ void ImmutableStringFieldGenerator::GenerateMergingCode(
   }
 }
 
+void ImmutableStringFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  // strings and ByteStrings are immutable and can be shared
+  printer->Print(variables_,
+                 "$store_prefix$other.$name$_$store_suffix$;\n");
+}
+
+void ImmutableStringFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($is_field_present_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$name$_", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableStringFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 ("$set_has_field_bit_message$\n"
+                  "$store_prefix$" +
+                  JsonValueReader(descriptor_, name_resolver_) +
+                  "$store_suffix$;\n")
+                     .c_str());
+}
+
+void ImmutableStringFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckByNumber(descriptor_, "java.lang.String", true, printer);
+}
+
+void ImmutableStringFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  // the setter stores with the field memory semantics and notifies
+  printer->Print(variables_,
+                 "set$capitalized_name$((java.lang.String) value);\n");
+}
+
+void ImmutableStringFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableStringFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (CheckUtf8(descriptor_)) {
     printer->Print(variables_,
-                   "java.lang.String s = input.readStringRequireUtf8();\n"
+                   "java.lang.String s = $read_string$;\n"
                    "$set_has_field_bit_message$\n"
                    "$name$_ = s;\n");
   } else {
     printer->Print(variables_,
-                   "java.lang.String bs = input.readString();\n"
+                   "java.lang.String bs = $read_string$;\n"
                    "$set_has_field_bit_message$\n"
                    "$name$_ = bs;\n");
   }
@@ -338,6 +414,7 @@ ImmutableStringOneofFieldGenerator::~ImmutableStringOneofFieldGenerator() {}
 
 void ImmutableStringOneofFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
+  PrintInternerDeclaration(descriptor_, variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
 
   if (SupportFieldPresence(descriptor_)) {
@@ -365,26 +442,31 @@ void ImmutableStringOneofFieldGenerator::GenerateMembers(
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$set$capitalized_name$$}$(\n"
-                 "    java.lang.String value) {\n"
+                 "    java.lang.String value) {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
                  "  $set_oneof_case_message$;\n"
                  "  $oneof_name$_ = value;\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
-  printer->Annotate("{", "}", descriptor_);
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER,
       /* builder */ true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
+  printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(
+      variables_,
       "  if ($has_oneof_case_message$) {\n"
       "    $clear_oneof_case_message$;\n"
       "    $oneof_name$_ = null;\n"
       "    $on_changed$\n"
-      "  }\n"
-      "  return this;\n"
-      "}\n");
-  printer->Annotate("{", "}", descriptor_);
+      "  }\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void ImmutableStringOneofFieldGenerator::GenerateMergingCode(
@@ -397,16 +479,59 @@ void ImmutableStringOneofFieldGenerator::GenerateMergingCode(
                  "$on_changed$\n");
 }
 
+void ImmutableStringOneofFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$oneof_name$_ = other.$oneof_name$_;\n");
+}
+
+void ImmutableStringOneofFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if ($has_oneof_case_message$) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n");
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "(java.lang.String) $oneof_name$_",
+                                 name_resolver_).c_str());
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+void ImmutableStringOneofFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 ("$oneof_name$_ = " +
+                  JsonValueReader(descriptor_, name_resolver_) + ";\n"
+                  "$set_oneof_case_message$;\n")
+                     .c_str());
+}
+
+void ImmutableStringOneofFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "$oneof_name$_ = (java.lang.String) value;\n"
+                 "$set_oneof_case_message$;\n"
+                 "$on_changed$\n");
+}
+
+void ImmutableStringOneofFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($oneof_name$_, other.$oneof_name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void ImmutableStringOneofFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (CheckUtf8(descriptor_)) {
     printer->Print(variables_,
-                   "java.lang.String s = input.readStringRequireUtf8();\n"
+                   "java.lang.String s = $read_string$;\n"
                    "$set_oneof_case_message$;\n"
                    "$oneof_name$_ = s;\n");
   } else {
     printer->Print(variables_,
-                   "java.lang.String bs = input.readString();\n"
+                   "java.lang.String bs = $read_string$;\n"
                    "$set_oneof_case_message$;\n"
                    "$oneof_name$_ = bs;\n");
   }
@@ -447,7 +572,7 @@ int RepeatedImmutableStringFieldGenerator::GetNumBitsForMessage() const {
 }
 
 int RepeatedImmutableStringFieldGenerator::GetNumBitsForBuilder() const {
-  return 1;
+  return 0;
 }
 
 void RepeatedImmutableStringFieldGenerator::GenerateInterfaceMembers(
@@ -488,12 +613,14 @@ void RepeatedImmutableStringFieldGenerator::GenerateMembers(
     io::Printer* printer) const {
   printer->Print(variables_,
                  "private com.google.protobuf.LazyStringList $name$_;\n");
+  PrintInternerDeclaration(descriptor_, variables_, printer);
+  PrintEnsureRepeatedFieldMutable(variables_, printer);
   PrintExtraFieldInfo(variables_, printer);
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_GETTER);
   printer->Print(variables_,
                  "$deprecation$public com.google.protobuf.ProtocolStringList\n"
                  "    ${$get$capitalized_name$List$}$() {\n"
-                 "  return $name$_;\n"  // note:  unmodifiable list
+                 "  return $name$_.getUnmodifiableView();\n"
                  "}\n");
   printer->Annotate("{", "}", descriptor_);
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_COUNT);
@@ -515,42 +642,54 @@ void RepeatedImmutableStringFieldGenerator::GenerateMembers(
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$set$capitalized_name$$}$(\n"
-                 "    int index, java.lang.String value) {\n"
-                 "  $name$_.set(index, value);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    int index, java.lang.String value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.set(index, value);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_ADDER,
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$add$capitalized_name$$}$(\n"
-                 "    java.lang.String value) {\n"
-                 "  $name$_.add(value);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    java.lang.String value) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.add(value);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, LIST_MULTI_ADDER,
       /* builder */ true);
   printer->Print(variables_,
                  "$deprecation$public $classname$ ${$addAll$capitalized_name$$}$(\n"
-                 "    java.util.Collection<java.lang.String> values) {\n"
-                 "  $name$_.addAll(values);\n"
-                 "  $on_changed$\n"
-                 "  return this;\n"
-                 "}\n");
+                 "    java.util.Collection<java.lang.String> values) {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Print(variables_,
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.addAll(values);\n"
+                 "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
   WriteFieldAccessorDocComment(printer, descriptor_, CLEARER,
       /* builder */ true);
   printer->Print(
       variables_,
-      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n"
-      "  $name$_ = $empty_list$;\n"
-      "  $on_changed$\n"
-      "  return this;\n"
-      "}\n");
+      "$deprecation$public $classname$ ${$clear$capitalized_name$$}$() {\n");
   printer->Annotate("{", "}", descriptor_);
+  PrintMutatorPrologue(descriptor_, printer);
+  printer->Indent();
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Outdent();
+  printer->Print(variables_, "  $on_changed$\n");
+  PrintMutatorEpilogue(descriptor_, printer);
+  printer->Print("}\n");
 }
 
 void RepeatedImmutableStringFieldGenerator::GenerateInitializationCode(
@@ -560,8 +699,7 @@ void RepeatedImmutableStringFieldGenerator::GenerateInitializationCode(
 
 void RepeatedImmutableStringFieldGenerator::GenerateClearCode(
     io::Printer* printer) const {
-  printer->Print(variables_,
-                 "$name$_ = $empty_list$;\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
 }
 
 void RepeatedImmutableStringFieldGenerator::GenerateToStringCode(io::Printer* printer) const {
@@ -586,20 +724,87 @@ void RepeatedImmutableStringFieldGenerator::GenerateMergingCode(
                  "}\n");
 }
 
+void RepeatedImmutableStringFieldGenerator::GenerateCopyCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "if (!other.$name$_.isEmpty()) {\n"
+                 "  ensure$capitalized_name$IsMutable();\n"
+                 "  $name$_.addAll(other.$name$_);\n"
+                 "}\n");
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateFreezeCode(
+    io::Printer* printer) const {
+  printer->Print(variables_, "$name$_ = $name$_.getUnmodifiableView();\n");
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateJsonCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!$name$_.isEmpty()) {\n"
+                 "  first = de.leohilbert.proto.JsonWriter.name(out, first, \"$json_name$\");\n"
+                 "  out.append('[');\n"
+                 "  for (int i = 0; i < $name$_.size(); i++) {\n"
+                 "    if (i > 0) {\n"
+                 "      out.append(',');\n"
+                 "    }\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Print(variables_,
+                 JsonValueWriter(descriptor_, "$name$_.get(i)", name_resolver_).c_str());
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print("  }\n"
+                 "  out.append(']');\n"
+                 "}\n");
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateJsonParsingCode(
+    io::Printer* printer) const {
+  printer->Print("in.beginArray();\n");
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 ("while (in.hasNextElement()) {\n"
+                  "  ensure$capitalized_name$IsMutable();\n"
+                  "  $name$_.add(" +
+                  JsonValueReader(descriptor_, name_resolver_) + ");\n"
+                  "}\n")
+                     .c_str());
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateCheckByNumberCode(
+    io::Printer* printer) const {
+  PrintCheckListByNumber(descriptor_, "java.lang.String", printer);
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateSetByNumberCode(
+    io::Printer* printer) const {
+  PrintClearRepeatedField(descriptor_, variables_, printer);
+  printer->Print(variables_,
+                 "ensure$capitalized_name$IsMutable();\n"
+                 "$name$_.addAll((java.util.Collection<java.lang.String>) value);\n"
+                 "$on_changed$\n");
+}
+
+void RepeatedImmutableStringFieldGenerator::GenerateDiffCode(
+    io::Printer* printer) const {
+  printer->Print(variables_,
+                 "if (!java.util.Objects.equals($name$_, other.$name$_)) {\n"
+                 "  mask |= $diff_bit$;\n"
+                 "}\n");
+}
+
 void RepeatedImmutableStringFieldGenerator::GenerateParsingCode(
     io::Printer* printer) const {
   if (CheckUtf8(descriptor_)) {
     printer->Print(variables_,
-                   "java.lang.String s = input.readStringRequireUtf8();\n");
+                   "java.lang.String s = $read_string$;\n");
   } else {
     printer->Print(variables_,
-                   "java.lang.String bs = input.readString();\n");
+                   "java.lang.String bs = $read_string$;\n");
   }
-  printer->Print(variables_,
-                 "if (!$get_mutable_bit_parser$) {\n"
-                 "  $name$_ = new com.google.protobuf.LazyStringArrayList();\n"
-                 "  $set_mutable_bit_parser$;\n"
-                 "}\n");
+  printer->Print(variables_, "ensure$capitalized_name$IsMutable();\n");
   if (CheckUtf8(descriptor_)) {
     printer->Print(variables_, "$name$_.add(s);\n");
   } else {
@@ -634,7 +839,7 @@ void RepeatedImmutableStringFieldGenerator::GenerateSerializedSizeCode(
   printer->Print("size += dataSize;\n");
 
   printer->Print(variables_,
-                 "size += $tag_size$ * get$capitalized_name$List().size();\n");
+                 "size += $tag_size$ * $name$_.size();\n");
 
   printer->Outdent();
   printer->Print("}\n");
@@ -644,8 +849,8 @@ void RepeatedImmutableStringFieldGenerator::GenerateEqualsCode(
     io::Printer* printer) const {
   printer->Print(
       variables_,
-      "if (!java.util.Objects.equals(get$capitalized_name$List(),\n"
-      "    other.get$capitalized_name$List())) return false;\n");
+      "if (!java.util.Objects.equals($name$_,\n"
+      "    other.$name$_)) return false;\n");
 }
 
 void RepeatedImmutableStringFieldGenerator::GenerateHashCode(
@@ -654,7 +859,7 @@ void RepeatedImmutableStringFieldGenerator::GenerateHashCode(
       variables_,
       "if (get$capitalized_name$Count() > 0) {\n"
       "  hash = (37 * hash) + $constant_name$;\n"
-      "  hash = (53 * hash) + java.util.Objects.hashCode(get$capitalized_name$List());\n"
+      "  hash = (53 * hash) + java.util.Objects.hashCode($name$_);\n"
       "}\n");
 }
 
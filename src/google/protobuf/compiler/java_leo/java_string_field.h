@@ -73,6 +73,12 @@ class ImmutableStringFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
@@ -102,6 +108,11 @@ class ImmutableStringOneofFieldGenerator
  private:
   void GenerateMembers(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
   void GenerateSerializedSizeCode(io::Printer* printer) const;
@@ -125,6 +136,13 @@ class RepeatedImmutableStringFieldGenerator : public ImmutableFieldGenerator {
   void GenerateClearCode(io::Printer* printer) const;
   void GenerateToStringCode(io::Printer* printer) const;
   void GenerateMergingCode(io::Printer* printer) const;
+  void GenerateCopyCode(io::Printer* printer) const;
+  void GenerateFreezeCode(io::Printer* printer) const;
+  void GenerateJsonCode(io::Printer* printer) const;
+  void GenerateJsonParsingCode(io::Printer* printer) const;
+  void GenerateCheckByNumberCode(io::Printer* printer) const;
+  void GenerateSetByNumberCode(io::Printer* printer) const;
+  void GenerateDiffCode(io::Printer* printer) const;
   void GenerateParsingCode(io::Printer* printer) const;
   void GenerateParsingDoneCode(io::Printer* printer) const;
   void GenerateSerializationCode(io::Printer* printer) const;
@@ -0,0 +1,534 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <google/protobuf/compiler/java_leo/java_table.h>
+
+#include <google/protobuf/compiler/java_leo/java_context.h>
+#include <google/protobuf/compiler/java_leo/java_field.h>
+#include <google/protobuf/compiler/java_leo/java_helpers.h>
+#include <google/protobuf/compiler/java_leo/java_name_resolver.h>
+#include <google/protobuf/io/printer.h>
+#include <google/protobuf/wire_format.h>
+#include <google/protobuf/stubs/strutil.h>
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+
+namespace {
+
+std::string PresenceMask(int bit) {
+  return StrCat("0x", strings::Hex(uint32(1) << (bit % 32), strings::ZERO_PAD_8));
+}
+
+// strings and bytes are kept as references, the proto default while the
+// field is absent
+bool IsObjectColumn(const FieldDescriptor* field) {
+  return GetJavaType(field) == JAVATYPE_STRING ||
+         GetJavaType(field) == JAVATYPE_BYTES;
+}
+
+// marks the field of the row as present, fields without presence have no bit
+void PrintSetHas(const std::map<std::string, std::string>& vars,
+                 io::Printer* printer) {
+  if (vars.count("set_has")) {
+    printer->Print(vars, "$set_has$;\n");
+  }
+}
+
+}  // namespace
+
+TableGenerator::TableGenerator(const Descriptor* descriptor, Context* context)
+    : descriptor_(descriptor),
+      context_(context),
+      name_resolver_(context->GetNameResolver()),
+      presence_bit_count_(0) {
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    const FieldDescriptor* field = descriptor_->field(i);
+    if (!IsTableColumn(field)) {
+      continue;
+    }
+    columns_.push_back(field);
+    presence_bits_[field] =
+        SupportFieldPresence(field) ? presence_bit_count_++ : -1;
+  }
+}
+
+TableGenerator::~TableGenerator() {}
+
+std::map<std::string, std::string> TableGenerator::ColumnVariables(
+    const FieldDescriptor* field, const std::string& row) const {
+  std::map<std::string, std::string> vars;
+  const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
+  vars["name"] = info->name;
+  vars["capitalized_name"] = info->capitalized_name;
+  vars["number"] = StrCat(field->number());
+  vars["tag"] =
+      StrCat(static_cast<int32>(internal::WireFormat::MakeTag(field)));
+  vars["capitalized_type"] = GetCapitalizedType(field, /* immutable = */ true);
+  vars["value"] = info->name + "_[" + row + "]";
+  vars["row"] = row;
+
+  JavaType type = GetJavaType(field);
+  switch (type) {
+    case JAVATYPE_ENUM:
+      vars["column_type"] = "int";
+      vars["type"] = name_resolver_->GetImmutableClassName(field->enum_type());
+      vars["default"] = StrCat(field->default_value_enum()->number());
+      break;
+    case JAVATYPE_STRING:
+    case JAVATYPE_BYTES:
+      vars["column_type"] = vars["type"] = BoxedPrimitiveTypeName(type);
+      vars["default"] = ProtoStringDefaultValue(field);
+      break;
+    default:
+      vars["column_type"] = vars["type"] = PrimitiveTypeName(type);
+      vars["default"] = ImmutableDefaultValue(field, name_resolver_);
+      break;
+  }
+  if (type == JAVATYPE_STRING) {
+    vars["read"] = CheckUtf8(field) ? "input.readStringRequireUtf8()"
+                                    : "input.readString()";
+  } else {
+    vars["read"] = "input.read" + vars["capitalized_type"] + "()";
+  }
+
+  int bit = presence_bits_.at(field);
+  if (bit >= 0) {
+    std::string bits = GetBitFieldNameForBit(bit) + "[" + row + "]";
+    vars["is_present"] = "(" + bits + " & " + PresenceMask(bit) + ") != 0";
+    vars["set_has"] = bits + " |= " + PresenceMask(bit);
+    vars["clear_has"] = bits + " &= ~" + PresenceMask(bit);
+  } else if (IsObjectColumn(field)) {
+    // like the message, an empty string or bytes without presence is absent
+    vars["is_present"] = "!" + vars["value"] + ".isEmpty()";
+  } else {
+    vars["is_present"] = vars["value"] + " != " + vars["default"];
+  }
+  return vars;
+}
+
+void TableGenerator::Generate(io::Printer* printer) {
+  std::map<std::string, std::string> vars;
+  vars["classname"] = descriptor_->name();
+  vars["message"] = name_resolver_->GetImmutableClassName(descriptor_);
+  // a sibling file holds the table of a top-level message, otherwise it is
+  // nested like the message interface
+  vars["static"] = descriptor_->containing_type() == NULL &&
+                           MultipleJavaFiles(descriptor_->file(), true)
+                       ? ""
+                       : "static ";
+  printer->Print(
+      vars,
+      "/**\n"
+      " * Columnar storage for {@link $message$} rows, each field is\n"
+      " * kept in an array of its own. Messages, repeated fields, oneofs and\n"
+      " * javatype fields have no column and are skipped by {@link #append}\n"
+      " * and {@link #appendFrom}.\n"
+      " */\n"
+      "public $static$final class $classname$Table {\n");
+  printer->Indent();
+  printer->Print("private int size_;\n"
+                 "private int capacity_;\n");
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "private $column_type$[] $name$_;\n");
+  }
+  int presence_ints = (presence_bit_count_ + 31) / 32;
+  for (int i = 0; i < presence_ints; i++) {
+    printer->Print("private int[] $bit_field_name$;\n", "bit_field_name",
+                   GetBitFieldName(i));
+  }
+
+  printer->Print(vars,
+                 "\n"
+                 "public $classname$Table() {\n"
+                 "  this(16);\n"
+                 "}\n"
+                 "\n"
+                 "public $classname$Table(int capacity) {\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "$name$_ = new $column_type$[capacity];\n");
+  }
+  for (int i = 0; i < presence_ints; i++) {
+    printer->Print("$bit_field_name$ = new int[capacity];\n",
+                   "bit_field_name", GetBitFieldName(i));
+  }
+  printer->Print("capacity_ = capacity;\n");
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n"
+      "/**\n"
+      " * The number of rows.\n"
+      " */\n"
+      "public int size() {\n"
+      "  return size_;\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Removes all rows, the arrays are kept for the next ones.\n"
+      " */\n"
+      "public void clear() {\n");
+  for (const FieldDescriptor* field : columns_) {
+    if (IsObjectColumn(field)) {
+      printer->Print(ColumnVariables(field, "row"),
+                     "  java.util.Arrays.fill($name$_, 0, size_, null);\n");
+    }
+  }
+  printer->Print(
+      "  size_ = 0;\n"
+      "}\n"
+      "\n");
+
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "/**\n"
+                   " * The $name$ column, valid up to {@link #size()}. The\n"
+                   " * table replaces it with a larger array when it grows.\n"
+                   " */\n"
+                   "public $column_type$[] $name$Column() {\n"
+                   "  return $name$_;\n"
+                   "}\n"
+                   "\n");
+  }
+
+  GenerateAddRow(printer);
+  GenerateGrow(printer);
+  GenerateAppend(printer);
+  GenerateAppendFrom(printer);
+  GenerateWriteRowTo(printer);
+  GenerateRowSerializedSize(printer);
+  GenerateCursor(printer);
+
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+void TableGenerator::GenerateAddRow(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Appends a row with every field at its default.\n"
+      " * @return the index of the new row\n"
+      " */\n"
+      "public int addRow() {\n"
+      "  if (size_ == capacity_) {\n"
+      "    grow();\n"
+      "  }\n"
+      "  int row = size_++;\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"), "$value$ = $default$;\n");
+  }
+  for (int i = 0; i < (presence_bit_count_ + 31) / 32; i++) {
+    printer->Print("$bit_field_name$[row] = 0;\n", "bit_field_name",
+                   GetBitFieldName(i));
+  }
+  printer->Outdent();
+  printer->Print(
+      "  return row;\n"
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateGrow(io::Printer* printer) {
+  printer->Print(
+      "private void grow() {\n"
+      "  int capacity = java.lang.Math.max(16, capacity_ * 2);\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "$name$_ = java.util.Arrays.copyOf($name$_, capacity);\n");
+  }
+  for (int i = 0; i < (presence_bit_count_ + 31) / 32; i++) {
+    printer->Print(
+        "$bit_field_name$ = java.util.Arrays.copyOf($bit_field_name$, "
+        "capacity);\n",
+        "bit_field_name", GetBitFieldName(i));
+  }
+  printer->Outdent();
+  printer->Print(
+      "  capacity_ = capacity;\n"
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateAppend(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Appends a row holding the column fields of {@code message}.\n"
+      " * @return the index of the new row\n"
+      " */\n"
+      "public int append($message$ message) {\n"
+      "  int row = addRow();\n",
+      "message", name_resolver_->GetImmutableClassName(descriptor_));
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    std::map<std::string, std::string> vars = ColumnVariables(field, "row");
+    std::string getter = "message.get$capitalized_name$()";
+    if (GetJavaType(field) == JAVATYPE_ENUM) {
+      getter = SupportUnknownEnumValue(field->file())
+                   ? "message.get$capitalized_name$Value()"
+                   : "message.get$capitalized_name$().getNumber()";
+    }
+    if (presence_bits_.at(field) >= 0) {
+      printer->Print(vars, "if (message.has$capitalized_name$()) {\n");
+      printer->Indent();
+      printer->Print(vars, ("$value$ = " + getter + ";\n").c_str());
+      PrintSetHas(vars, printer);
+      printer->Outdent();
+      printer->Print("}\n");
+    } else if (IsObjectColumn(field)) {
+      // the message keeps an absent string as null
+      printer->Print(vars, ("$value$ = java.util.Objects.requireNonNullElse(" +
+                            getter + ", $default$);\n").c_str());
+    } else {
+      printer->Print(vars, ("$value$ = " + getter + ";\n").c_str());
+    }
+  }
+  printer->Outdent();
+  printer->Print(
+      "  return row;\n"
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateAppendFrom(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Parses a message from {@code input}, up to its end or current limit,\n"
+      " * into a new row. Fields without a column and unknown fields are\n"
+      " * skipped.\n"
+      " * @return the index of the new row\n"
+      " */\n"
+      "public int appendFrom(com.google.protobuf.CodedInputStream input)\n"
+      "    throws java.io.IOException {\n"
+      "  int row = addRow();\n"
+      "  while (true) {\n"
+      "    int tag = input.readTag();\n"
+      "    switch (tag) {\n"
+      "      case 0:\n"
+      "        return row;\n");
+  printer->Indent();
+  printer->Indent();
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    std::map<std::string, std::string> vars = ColumnVariables(field, "row");
+    printer->Print(vars, "case $tag$: {\n");
+    printer->Indent();
+    if (GetJavaType(field) == JAVATYPE_ENUM &&
+        !SupportUnknownEnumValue(field->file())) {
+      // closed enums drop numbers they don't know, like updateFrom does
+      printer->Print(vars,
+                     "int rawValue = input.readEnum();\n"
+                     "if ($type$.forNumber(rawValue) != null) {\n"
+                     "  $value$ = rawValue;\n");
+      printer->Indent();
+      PrintSetHas(vars, printer);
+      printer->Outdent();
+      printer->Print("}\n");
+    } else {
+      printer->Print(vars, "$value$ = $read$;\n");
+      PrintSetHas(vars, printer);
+    }
+    printer->Print("break;\n");
+    printer->Outdent();
+    printer->Print("}\n");
+  }
+  printer->Print(
+      "default:\n"
+      "  if (!input.skipField(tag)) {\n"
+      "    return row;\n"
+      "  }\n"
+      "  break;\n");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "    }\n"
+      "  }\n"
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateWriteRowTo(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Writes a row in the wire format of {@link $message$}.\n"
+      " */\n"
+      "public void writeRowTo(com.google.protobuf.CodedOutputStream output,\n"
+      "    int row) throws java.io.IOException {\n",
+      "message", name_resolver_->GetImmutableClassName(descriptor_));
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "if ($is_present$) {\n"
+                   "  output.write$capitalized_type$($number$, $value$);\n"
+                   "}\n");
+  }
+  printer->Outdent();
+  printer->Print(
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateRowSerializedSize(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * The number of bytes {@link #writeRowTo} writes for a row.\n"
+      " */\n"
+      "public int getRowSerializedSize(int row) {\n"
+      "  int size = 0;\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    printer->Print(ColumnVariables(field, "row"),
+                   "if ($is_present$) {\n"
+                   "  size += com.google.protobuf.CodedOutputStream\n"
+                   "    .compute$capitalized_type$Size($number$, $value$);\n"
+                   "}\n");
+  }
+  printer->Outdent();
+  printer->Print(
+      "  return size;\n"
+      "}\n"
+      "\n");
+}
+
+void TableGenerator::GenerateCursor(io::Printer* printer) {
+  printer->Print(
+      "/**\n"
+      " * Returns a new cursor, move it over the rows instead of creating one\n"
+      " * per row.\n"
+      " */\n"
+      "public Cursor cursor() {\n"
+      "  return new Cursor();\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Accessors for the fields of one row, {@link #moveTo} points it at\n"
+      " * another one.\n"
+      " */\n"
+      "public final class Cursor {\n"
+      "  private int row;\n"
+      "\n"
+      "  private Cursor() {\n"
+      "  }\n"
+      "\n"
+      "  public Cursor moveTo(int row) {\n"
+      "    if (row < 0 || row >= size_) {\n"
+      "      throw new java.lang.IndexOutOfBoundsException(\n"
+      "          \"row \" + row + \" of \" + size_);\n"
+      "    }\n"
+      "    this.row = row;\n"
+      "    return this;\n"
+      "  }\n"
+      "\n"
+      "  public int getRow() {\n"
+      "    return row;\n"
+      "  }\n");
+  printer->Indent();
+  for (const FieldDescriptor* field : columns_) {
+    std::map<std::string, std::string> vars = ColumnVariables(field, "row");
+    printer->Print("\n");
+    if (presence_bits_.at(field) >= 0) {
+      printer->Print(vars,
+                     "public boolean has$capitalized_name$() {\n"
+                     "  return $is_present$;\n"
+                     "}\n"
+                     "\n");
+    }
+    if (GetJavaType(field) == JAVATYPE_ENUM) {
+      if (SupportUnknownEnumValue(field->file())) {
+        printer->Print(vars,
+                       "public int get$capitalized_name$Value() {\n"
+                       "  return $value$;\n"
+                       "}\n"
+                       "\n");
+        printer->Print(vars,
+                       "public $type$ get$capitalized_name$() {\n"
+                       "  $type$ result = $type$.forNumber($value$);\n"
+                       "  return result == null ? $type$.UNRECOGNIZED : "
+                       "result;\n"
+                       "}\n"
+                       "\n");
+      } else {
+        // closed enum columns only ever hold known numbers
+        printer->Print(vars,
+                       "public $type$ get$capitalized_name$() {\n"
+                       "  return $type$.forNumber($value$);\n"
+                       "}\n"
+                       "\n");
+      }
+      printer->Print(vars,
+                     "public Cursor set$capitalized_name$($type$ value) {\n"
+                     "  $value$ = value.getNumber();\n");
+    } else if (IsObjectColumn(field)) {
+      // null clears the field like the setter of the message
+      printer->Print(vars,
+                     "public $type$ get$capitalized_name$() {\n"
+                     "  return $value$;\n"
+                     "}\n"
+                     "\n"
+                     "public Cursor set$capitalized_name$($type$ value) {\n"
+                     "  if (value == null) {\n"
+                     "    $value$ = $default$;\n");
+      if (vars.count("clear_has")) {
+        printer->Print(vars, "    $clear_has$;\n");
+      }
+      printer->Print(vars,
+                     "    return this;\n"
+                     "  }\n"
+                     "  $value$ = value;\n");
+    } else {
+      printer->Print(vars,
+                     "public $type$ get$capitalized_name$() {\n"
+                     "  return $value$;\n"
+                     "}\n"
+                     "\n"
+                     "public Cursor set$capitalized_name$($type$ value) {\n"
+                     "  $value$ = value;\n");
+    }
+    printer->Indent();
+    PrintSetHas(vars, printer);
+    printer->Outdent();
+    printer->Print("  return this;\n"
+                   "}\n");
+  }
+  printer->Outdent();
+  printer->Print("}\n");
+}
+
+}  // namespace java_leo
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
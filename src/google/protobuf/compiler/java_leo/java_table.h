@@ -0,0 +1,101 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Generates the columnar <Message>Table companion of messages with the table
+// option.
+
+#ifndef GOOGLE_PROTOBUF_COMPILER_JAVA_TABLE_H__
+#define GOOGLE_PROTOBUF_COMPILER_JAVA_TABLE_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/descriptor.h>
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+class Context;            // context.h
+class ClassNameResolver;  // name_resolver.h
+}  // namespace java_leo
+}  // namespace compiler
+namespace io {
+class Printer;  // printer.h
+}
+}  // namespace protobuf
+}  // namespace google
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+
+// The table stores every column field (see IsTableColumn) of the message in an
+// array of its own, rows are indexes into those arrays. Other fields are
+// skipped when a row is parsed.
+class TableGenerator {
+ public:
+  TableGenerator(const Descriptor* descriptor, Context* context);
+  ~TableGenerator();
+
+  void Generate(io::Printer* printer);
+
+ private:
+  void GenerateGrow(io::Printer* printer);
+  void GenerateAddRow(io::Printer* printer);
+  void GenerateAppend(io::Printer* printer);
+  void GenerateAppendFrom(io::Printer* printer);
+  void GenerateWriteRowTo(io::Printer* printer);
+  void GenerateRowSerializedSize(io::Printer* printer);
+  void GenerateCursor(io::Printer* printer);
+
+  // Variables of a column, $row$ is the index expression of the row.
+  std::map<std::string, std::string> ColumnVariables(
+      const FieldDescriptor* field, const std::string& row) const;
+
+  const Descriptor* descriptor_;
+  Context* context_;
+  ClassNameResolver* name_resolver_;
+  std::vector<const FieldDescriptor*> columns_;
+  // presence bit of each column, -1 if the column has no has-bit
+  std::map<const FieldDescriptor*, int> presence_bits_;
+  int presence_bit_count_;
+
+  GOOGLE_DISALLOW_EVIL_CONSTRUCTORS(TableGenerator);
+};
+
+}  // namespace java_leo
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#endif  // GOOGLE_PROTOBUF_COMPILER_JAVA_TABLE_H__
@@ -0,0 +1,312 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+// https://developers.google.com/protocol-buffers/
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <google/protobuf/compiler/java_leo/java_view.h>
+
+#include <google/protobuf/compiler/java_leo/java_context.h>
+#include <google/protobuf/compiler/java_leo/java_field.h>
+#include <google/protobuf/compiler/java_leo/java_helpers.h>
+#include <google/protobuf/compiler/java_leo/java_name_resolver.h>
+#include <google/protobuf/io/printer.h>
+#include <google/protobuf/wire_format.h>
+#include <google/protobuf/stubs/strutil.h>
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace java_leo {
+
+namespace {
+
+// the MessageView method decoding a value of the field
+const char* ReadMethod(const FieldDescriptor* field) {
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_UINT32:
+    case FieldDescriptor::TYPE_ENUM:
+      return "readInt32";
+    case FieldDescriptor::TYPE_SINT32:
+      return "readSInt32";
+    case FieldDescriptor::TYPE_FIXED32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      return "readFixed32";
+    case FieldDescriptor::TYPE_INT64:
+    case FieldDescriptor::TYPE_UINT64:
+      return "readInt64";
+    case FieldDescriptor::TYPE_SINT64:
+      return "readSInt64";
+    case FieldDescriptor::TYPE_FIXED64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      return "readFixed64";
+    case FieldDescriptor::TYPE_FLOAT:
+      return "readFloat";
+    case FieldDescriptor::TYPE_DOUBLE:
+      return "readDouble";
+    case FieldDescriptor::TYPE_BOOL:
+      return "readBool";
+    case FieldDescriptor::TYPE_STRING:
+      return "readString";
+    case FieldDescriptor::TYPE_BYTES:
+      return "readBytes";
+    default:
+      return "readMessage";
+  }
+}
+
+}  // namespace
+
+ViewGenerator::ViewGenerator(const Descriptor* descriptor, Context* context)
+    : descriptor_(descriptor),
+      context_(context),
+      name_resolver_(context->GetNameResolver()) {
+  for (int i = 0; i < descriptor_->field_count(); i++) {
+    if (IsViewField(descriptor_->field(i))) {
+      fields_.push_back(descriptor_->field(i));
+    }
+  }
+}
+
+ViewGenerator::~ViewGenerator() {}
+
+std::map<std::string, std::string> ViewGenerator::FieldVariables(
+    const FieldDescriptor* field) const {
+  std::map<std::string, std::string> vars;
+  const FieldGeneratorInfo* info = context_->GetFieldGeneratorInfo(field);
+  vars["name"] = info->name;
+  vars["capitalized_name"] = info->capitalized_name;
+  vars["tag"] =
+      StrCat(static_cast<int32>(internal::WireFormat::MakeTag(field)));
+  vars["read"] = ReadMethod(field);
+  for (size_t i = 0; i < fields_.size(); i++) {
+    if (fields_[i] == field) {
+      vars["slot"] = StrCat(i);
+    }
+  }
+
+  JavaType type = GetJavaType(field);
+  switch (type) {
+    case JAVATYPE_MESSAGE:
+      vars["type"] =
+          name_resolver_->GetImmutableClassName(field->message_type()) +
+          "View";
+      break;
+    case JAVATYPE_ENUM:
+      vars["type"] = name_resolver_->GetImmutableClassName(field->enum_type());
+      vars["default"] = ImmutableDefaultValue(field, name_resolver_);
+      vars["default_number"] = StrCat(field->default_value_enum()->number());
+      break;
+    case JAVATYPE_STRING:
+    case JAVATYPE_BYTES:
+      vars["type"] = BoxedPrimitiveTypeName(type);
+      vars["default"] = ProtoStringDefaultValue(field);
+      break;
+    default:
+      vars["type"] = PrimitiveTypeName(type);
+      vars["default"] = ImmutableDefaultValue(field, name_resolver_);
+      break;
+  }
+  return vars;
+}
+
+void ViewGenerator::Generate(io::Printer* printer) {
+  std::map<std::string, std::string> vars;
+  vars["classname"] = descriptor_->name();
+  vars["message"] = name_resolver_->GetImmutableClassName(descriptor_);
+  vars["slots"] = StrCat(fields_.size());
+  // a sibling file holds the view of a top-level message, otherwise it is
+  // nested like the message interface
+  vars["static"] = descriptor_->containing_type() == NULL &&
+                           MultipleJavaFiles(descriptor_->file(), true)
+                       ? ""
+                       : "static ";
+  printer->Print(
+      vars,
+      "/**\n"
+      " * Read-only view of a serialized {@link $message$}, see\n"
+      " * {@link de.leohilbert.proto.MessageView}. Repeated fields, javatype\n"
+      " * fields and messages without a view of their own are not part of\n"
+      " * it.\n"
+      " */\n"
+      "public $static$final class $classname$View\n"
+      "    extends de.leohilbert.proto.MessageView {\n");
+  printer->Indent();
+  printer->Print(vars, "private final int[] positions_ = new int[$slots$];\n");
+  for (const FieldDescriptor* field : fields_) {
+    if (GetJavaType(field) == JAVATYPE_MESSAGE) {
+      printer->Print(FieldVariables(field), "private $type$ $name$_;\n");
+    }
+  }
+  printer->Print(
+      vars,
+      "\n"
+      "public $classname$View reset(byte[] bytes) {\n"
+      "  wrap(bytes, 0, bytes.length);\n"
+      "  return this;\n"
+      "}\n"
+      "\n"
+      "public $classname$View reset(byte[] bytes, int offset, int length) {\n"
+      "  wrap(bytes, offset, length);\n"
+      "  return this;\n"
+      "}\n"
+      "\n"
+      "/**\n"
+      " * Wraps the bytes between the position and the limit of\n"
+      " * {@code buffer}, without moving its position.\n"
+      " */\n"
+      "public $classname$View reset(java.nio.ByteBuffer buffer) {\n"
+      "  wrap(buffer);\n"
+      "  return this;\n"
+      "}\n"
+      "\n"
+      "@java.lang.Override\n"
+      "protected void clearIndex() {\n"
+      "  java.util.Arrays.fill(positions_, -1);\n"
+      "}\n"
+      "\n");
+  GenerateIndexField(printer);
+  printer->Print(
+      "private int position(int slot) {\n"
+      "  ensureIndexed();\n"
+      "  return positions_[slot];\n"
+      "}\n");
+  for (const FieldDescriptor* field : fields_) {
+    printer->Print("\n");
+    GenerateAccessors(field, printer);
+  }
+  printer->Outdent();
+  printer->Print("}\n\n");
+}
+
+void ViewGenerator::GenerateIndexField(io::Printer* printer) {
+  printer->Print(
+      "@java.lang.Override\n"
+      "protected void indexField(int tag, int position) {\n"
+      "  switch (tag) {\n");
+  printer->Indent();
+  printer->Indent();
+  for (const FieldDescriptor* field : fields_) {
+    printer->Print(FieldVariables(field),
+                   "case $tag$:\n"
+                   "  positions_[$slot$] = position;\n");
+    // the last member of a oneof on the wire is the one that is set
+    if (IsRealOneof(field)) {
+      for (const FieldDescriptor* other : fields_) {
+        if (other != field &&
+            other->containing_oneof() == field->containing_oneof()) {
+          printer->Print(FieldVariables(other),
+                         "  positions_[$slot$] = -1;\n");
+        }
+      }
+    }
+    printer->Print("  break;\n");
+  }
+  printer->Print(
+      "default:\n"
+      "  break;\n");
+  printer->Outdent();
+  printer->Outdent();
+  printer->Print(
+      "  }\n"
+      "}\n"
+      "\n");
+}
+
+void ViewGenerator::GenerateAccessors(const FieldDescriptor* field,
+                                      io::Printer* printer) {
+  std::map<std::string, std::string> vars = FieldVariables(field);
+  JavaType type = GetJavaType(field);
+  if (SupportFieldPresence(field) || IsRealOneof(field) ||
+      type == JAVATYPE_MESSAGE) {
+    printer->Print(vars,
+                   "public boolean has$capitalized_name$() {\n"
+                   "  return position($slot$) >= 0;\n"
+                   "}\n"
+                   "\n");
+  }
+  switch (type) {
+    case JAVATYPE_MESSAGE:
+      printer->Print(
+          vars,
+          "/**\n"
+          " * Returns the view of the nested message, null if it is absent.\n"
+          " * Every call returns the same view, it is reset onto this view's\n"
+          " * bytes.\n"
+          " */\n"
+          "public $type$ get$capitalized_name$() {\n"
+          "  int position = position($slot$);\n"
+          "  if (position < 0) {\n"
+          "    return null;\n"
+          "  }\n"
+          "  if ($name$_ == null) {\n"
+          "    $name$_ = new $type$();\n"
+          "  }\n"
+          "  return readMessage($name$_, position);\n"
+          "}\n");
+      break;
+    case JAVATYPE_ENUM:
+      if (SupportUnknownEnumValue(field->file())) {
+        printer->Print(
+            vars,
+            "public int get$capitalized_name$Value() {\n"
+            "  int position = position($slot$);\n"
+            "  return position < 0 ? $default_number$ : $read$(position);\n"
+            "}\n"
+            "\n"
+            "public $type$ get$capitalized_name$() {\n"
+            "  $type$ result = $type$.forNumber(get$capitalized_name$Value());\n"
+            "  return result == null ? $type$.UNRECOGNIZED : result;\n"
+            "}\n");
+      } else {
+        // unknown numbers of closed enums read as the default, like a
+        // message that kept them in its unknown fields
+        printer->Print(
+            vars,
+            "public $type$ get$capitalized_name$() {\n"
+            "  int position = position($slot$);\n"
+            "  $type$ result =\n"
+            "      position < 0 ? null : $type$.forNumber($read$(position));\n"
+            "  return result == null ? $default$ : result;\n"
+            "}\n");
+      }
+      break;
+    default:
+      printer->Print(vars,
+                     "public $type$ get$capitalized_name$() {\n"
+                     "  int position = position($slot$);\n"
+                     "  return position < 0 ? $default$ : $read$(position);\n"
+                     "}\n");
+      break;
+  }
+}
+
+}  // namespace java_leo
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
@@ -28,14 +28,53 @@ static constexpr ::PROTOBUF_NAMESPACE_ID::Message* const* file_default_instances
 const char descriptor_table_protodef_leo_5foptions_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\021leo_options.proto\022\tleo.proto\032 google/p"
   "rotobuf/descriptor.proto:1\n\010javatype\022\035.g"
-  "oogle.protobuf.FieldOptions\030\242\220\003 \001(\t:=\n\025u"
-  "se_custom_superclass\022\034.google.protobuf.F"
-  "ileOptions\030\243\220\003 \001(\010:<\n\024implements_interfa"
-  "ce\022\034.google.protobuf.FileOptions\030\245\220\003 \001(\t"
-  ":D\n\031msg_use_custom_superclass\022\037.google.p"
-  "rotobuf.MessageOptions\030\244\220\003 \001(\010:C\n\030msg_im"
-  "plements_interface\022\037.google.protobuf.Mes"
-  "sageOptions\030\246\220\003 \001(\tb\006proto3"
+  "oogle.protobuf.FieldOptions\030\242\220\003 \001(\t:/\n\006i"
+  "ntern\022\035.google.protobuf.FieldOptions\030\261\220\003"
+  " \001(\010:9\n\020stream_converter\022\035.google.protob"
+  "uf.FieldOptions\030\262\220\003 \001(\010::\n\021inplace_conve"
+  "rter\022\035.google.protobuf.FieldOptions\030\263\220\003 "
+  "\001(\010:7\n\016copy_converter\022\035.google.protobuf."
+  "FieldOptions\030\300\220\003 \001(\010:6\n\rbuiltin_codec\022\035."
+  "google.protobuf.FieldOptions\030\301\220\003 \001(\010:=\n\025"
+  "use_custom_superclass\022\034.google.protobuf."
+  "FileOptions\030\243\220\003 \001(\010:<\n\024implements_interf"
+  "ace\022\034.google.protobuf.FileOptions\030\245\220\003 \001("
+  "\t:4\n\014field_memory\022\034.google.protobuf.File"
+  "Options\030\247\220\003 \001(\t:/\n\007seqlock\022\034.google.prot"
+  "obuf.FileOptions\030\251\220\003 \001(\010:8\n\020lazy_descrip"
+  "tors\022\034.google.protobuf.FileOptions\030\253\220\003 \001"
+  "(\010:,\n\004lean\022\034.google.protobuf.FileOptions"
+  "\030\254\220\003 \001(\010:>\n\026discard_unknown_fields\022\034.goo"
+  "gle.protobuf.FileOptions\030\255\220\003 \001(\010:?\n\027repe"
+  "ated_trim_threshold\022\034.google.protobuf.Fi"
+  "leOptions\030\257\220\003 \001(\005:>\n\026unbox_well_known_ty"
+  "pes\022\034.google.protobuf.FileOptions\030\264\220\003 \001("
+  "\010:6\n\016compact_layout\022\034.google.protobuf.Fi"
+  "leOptions\030\266\220\003 \001(\010:-\n\005table\022\034.google.prot"
+  "obuf.FileOptions\030\270\220\003 \001(\010:,\n\004view\022\034.googl"
+  "e.protobuf.FileOptions\030\272\220\003 \001(\010:0\n\010off_he"
+  "ap\022\034.google.protobuf.FileOptions\030\274\220\003 \001(\010"
+  ":3\n\013field_masks\022\034.google.protobuf.FileOp"
+  "tions\030\276\220\003 \001(\010:D\n\031msg_use_custom_supercla"
+  "ss\022\037.google.protobuf.MessageOptions\030\244\220\003 "
+  "\001(\010:C\n\030msg_implements_interface\022\037.google"
+  ".protobuf.MessageOptions\030\246\220\003 \001(\t:;\n\020msg_"
+  "field_memory\022\037.google.protobuf.MessageOp"
+  "tions\030\250\220\003 \001(\t:6\n\013msg_seqlock\022\037.google.pr"
+  "otobuf.MessageOptions\030\252\220\003 \001(\010:E\n\032msg_dis"
+  "card_unknown_fields\022\037.google.protobuf.Me"
+  "ssageOptions\030\256\220\003 \001(\010:F\n\033msg_repeated_tri"
+  "m_threshold\022\037.google.protobuf.MessageOpt"
+  "ions\030\260\220\003 \001(\005:E\n\032msg_unbox_well_known_typ"
+  "es\022\037.google.protobuf.MessageOptions\030\265\220\003 "
+  "\001(\010:=\n\022msg_compact_layout\022\037.google.proto"
+  "buf.MessageOptions\030\267\220\003 \001(\010:4\n\tmsg_table\022"
+  "\037.google.protobuf.MessageOptions\030\271\220\003 \001(\010"
+  ":3\n\010msg_view\022\037.google.protobuf.MessageOp"
+  "tions\030\273\220\003 \001(\010:7\n\014msg_off_heap\022\037.google.p"
+  "rotobuf.MessageOptions\030\275\220\003 \001(\010::\n\017msg_fi"
+  "eld_masks\022\037.google.protobuf.MessageOptio"
+  "ns\030\277\220\003 \001(\010b\006proto3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_leo_5foptions_2eproto_deps[1] = {
   &::descriptor_table_google_2fprotobuf_2fdescriptor_2eproto,
@@ -44,7 +83,7 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_leo
 };
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_leo_5foptions_2eproto_once;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_leo_5foptions_2eproto = {
-  false, false, descriptor_table_protodef_leo_5foptions_2eproto, "leo_options.proto", 387,
+  false, false, descriptor_table_protodef_leo_5foptions_2eproto, "leo_options.proto", 1938,
   &descriptor_table_leo_5foptions_2eproto_once, descriptor_table_leo_5foptions_2eproto_sccs, descriptor_table_leo_5foptions_2eproto_deps, 0, 1,
   schemas, file_default_instances, TableStruct_leo_5foptions_2eproto::offsets,
   file_level_metadata_leo_5foptions_2eproto, 0, file_level_enum_descriptors_leo_5foptions_2eproto, file_level_service_descriptors_leo_5foptions_2eproto,
@@ -58,6 +97,21 @@ const std::string javatype_default("");
 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
     ::PROTOBUF_NAMESPACE_ID::internal::StringTypeTraits, 9, false >
   javatype(kJavatypeFieldNumber, javatype_default);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  intern(kInternFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  stream_converter(kStreamConverterFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  inplace_converter(kInplaceConverterFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  copy_converter(kCopyConverterFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FieldOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  builtin_codec(kBuiltinCodecFieldNumber, false);
 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
     ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
   use_custom_superclass(kUseCustomSuperclassFieldNumber, false);
@@ -65,6 +119,43 @@ const std::string implements_interface_default("");
 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
     ::PROTOBUF_NAMESPACE_ID::internal::StringTypeTraits, 9, false >
   implements_interface(kImplementsInterfaceFieldNumber, implements_interface_default);
+const std::string field_memory_default("");
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::StringTypeTraits, 9, false >
+  field_memory(kFieldMemoryFieldNumber, field_memory_default);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  seqlock(kSeqlockFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  lazy_descriptors(kLazyDescriptorsFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  lean(kLeanFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  discard_unknown_fields(kDiscardUnknownFieldsFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< ::PROTOBUF_NAMESPACE_ID::int32 >, 5, false >
+  repeated_trim_threshold(kRepeatedTrimThresholdFieldNumber, 0);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  unbox_well_known_types(kUnboxWellKnownTypesFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  compact_layout(kCompactLayoutFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  table(kTableFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  view(kViewFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  off_heap(kOffHeapFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::FileOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  field_masks(kFieldMasksFieldNumber, false);
 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
     ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
   msg_use_custom_superclass(kMsgUseCustomSuperclassFieldNumber, false);
@@ -72,6 +163,37 @@ const std::string msg_implements_interface_default("");
 ::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
     ::PROTOBUF_NAMESPACE_ID::internal::StringTypeTraits, 9, false >
   msg_implements_interface(kMsgImplementsInterfaceFieldNumber, msg_implements_interface_default);
+const std::string msg_field_memory_default("");
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::StringTypeTraits, 9, false >
+  msg_field_memory(kMsgFieldMemoryFieldNumber, msg_field_memory_default);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_seqlock(kMsgSeqlockFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_discard_unknown_fields(kMsgDiscardUnknownFieldsFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< ::PROTOBUF_NAMESPACE_ID::int32 >, 5, false >
+  msg_repeated_trim_threshold(kMsgRepeatedTrimThresholdFieldNumber, 0);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_unbox_well_known_types(kMsgUnboxWellKnownTypesFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_compact_layout(kMsgCompactLayoutFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_table(kMsgTableFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_view(kMsgViewFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_off_heap(kMsgOffHeapFieldNumber, false);
+::PROTOBUF_NAMESPACE_ID::internal::ExtensionIdentifier< ::google::protobuf::MessageOptions,
+    ::PROTOBUF_NAMESPACE_ID::internal::PrimitiveTypeTraits< bool >, 8, false >
+  msg_field_masks(kMsgFieldMasksFieldNumber, false);
 
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace proto